@@ -0,0 +1,80 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/benchmark/CMakeLists.txt"
+  "/root/repo/examples/CMakeLists.txt"
+  "/root/repo/src/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindMPI.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPkgConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmark/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "src/CMakeFiles/mci.dir/DependInfo.cmake"
+  "src/CMakeFiles/mci_static.dir/DependInfo.cmake"
+  "test/CMakeFiles/check.dir/DependInfo.cmake"
+  "test/CMakeFiles/ut1.exe.dir/DependInfo.cmake"
+  "test/CMakeFiles/ut2.exe.dir/DependInfo.cmake"
+  "test/CMakeFiles/ut3.exe.dir/DependInfo.cmake"
+  "test/CMakeFiles/ut4.exe.dir/DependInfo.cmake"
+  "test/CMakeFiles/ut5.exe.dir/DependInfo.cmake"
+  "test/CMakeFiles/ut6.exe.dir/DependInfo.cmake"
+  "test/CMakeFiles/ut7.exe.dir/DependInfo.cmake"
+  "test/CMakeFiles/ut8.exe.dir/DependInfo.cmake"
+  "test/CMakeFiles/ut9.exe.dir/DependInfo.cmake"
+  "test/CMakeFiles/ut10.exe.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/bench_estimators.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/bench_integrate_mixed.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/bench_throughput_nmc.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/bench_throughput_3G.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/bench_throughput_ndim_all.dir/DependInfo.cmake"
+  "benchmark/CMakeFiles/bench_throughput_ndim_single.dir/DependInfo.cmake"
+  "examples/CMakeFiles/ex_basic.exe.dir/DependInfo.cmake"
+  "examples/CMakeFiles/ex_mpi.exe.dir/DependInfo.cmake"
+  )
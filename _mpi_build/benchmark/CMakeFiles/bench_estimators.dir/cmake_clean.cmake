@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_estimators.dir/bench_estimators/main.cpp.o"
+  "CMakeFiles/bench_estimators.dir/bench_estimators/main.cpp.o.d"
+  "bench_estimators"
+  "bench_estimators.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_estimators.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
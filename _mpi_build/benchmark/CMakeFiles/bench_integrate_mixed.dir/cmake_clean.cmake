@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_integrate_mixed.dir/bench_integrate_mixed/main.cpp.o"
+  "CMakeFiles/bench_integrate_mixed.dir/bench_integrate_mixed/main.cpp.o.d"
+  "bench_integrate_mixed"
+  "bench_integrate_mixed.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_integrate_mixed.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_throughput_3G.dir/bench_throughput_3G/main.cpp.o"
+  "CMakeFiles/bench_throughput_3G.dir/bench_throughput_3G/main.cpp.o.d"
+  "bench_throughput_3G"
+  "bench_throughput_3G.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_throughput_3G.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
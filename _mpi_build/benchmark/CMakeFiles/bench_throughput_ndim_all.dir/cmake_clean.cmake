@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_throughput_ndim_all.dir/bench_throughput_ndim_all/main.cpp.o"
+  "CMakeFiles/bench_throughput_ndim_all.dir/bench_throughput_ndim_all/main.cpp.o.d"
+  "bench_throughput_ndim_all"
+  "bench_throughput_ndim_all.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_throughput_ndim_all.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/benchmark/bench_throughput_ndim_single/main.cpp" "benchmark/CMakeFiles/bench_throughput_ndim_single.dir/bench_throughput_ndim_single/main.cpp.o" "gcc" "benchmark/CMakeFiles/bench_throughput_ndim_single.dir/bench_throughput_ndim_single/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_mpi_build/src/CMakeFiles/mci.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
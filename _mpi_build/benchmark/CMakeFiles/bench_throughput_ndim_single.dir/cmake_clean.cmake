@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_throughput_ndim_single.dir/bench_throughput_ndim_single/main.cpp.o"
+  "CMakeFiles/bench_throughput_ndim_single.dir/bench_throughput_ndim_single/main.cpp.o.d"
+  "bench_throughput_ndim_single"
+  "bench_throughput_ndim_single.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_throughput_ndim_single.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
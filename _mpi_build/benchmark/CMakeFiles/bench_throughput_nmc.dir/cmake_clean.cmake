@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_throughput_nmc.dir/bench_throughput_nmc/main.cpp.o"
+  "CMakeFiles/bench_throughput_nmc.dir/bench_throughput_nmc/main.cpp.o.d"
+  "bench_throughput_nmc"
+  "bench_throughput_nmc.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_throughput_nmc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ex_basic.exe.dir/ex_basic/main.cpp.o"
+  "CMakeFiles/ex_basic.exe.dir/ex_basic/main.cpp.o.d"
+  "ex_basic.exe"
+  "ex_basic.exe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ex_basic.exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
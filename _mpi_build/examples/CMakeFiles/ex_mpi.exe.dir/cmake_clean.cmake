@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ex_mpi.exe.dir/ex_mpi/main.cpp.o"
+  "CMakeFiles/ex_mpi.exe.dir/ex_mpi/main.cpp.o.d"
+  "ex_mpi.exe"
+  "ex_mpi.exe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ex_mpi.exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
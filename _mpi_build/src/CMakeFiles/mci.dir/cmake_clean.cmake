@@ -0,0 +1,59 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mci.dir/AccumulatorInterface.cpp.o"
+  "CMakeFiles/mci.dir/AccumulatorInterface.cpp.o.d"
+  "CMakeFiles/mci.dir/BinningAccumulator.cpp.o"
+  "CMakeFiles/mci.dir/BinningAccumulator.cpp.o.d"
+  "CMakeFiles/mci.dir/BlockAccumulator.cpp.o"
+  "CMakeFiles/mci.dir/BlockAccumulator.cpp.o.d"
+  "CMakeFiles/mci.dir/CompressedFullAccumulator.cpp.o"
+  "CMakeFiles/mci.dir/CompressedFullAccumulator.cpp.o.d"
+  "CMakeFiles/mci.dir/CovarianceAccumulator.cpp.o"
+  "CMakeFiles/mci.dir/CovarianceAccumulator.cpp.o.d"
+  "CMakeFiles/mci.dir/Estimators.cpp.o"
+  "CMakeFiles/mci.dir/Estimators.cpp.o.d"
+  "CMakeFiles/mci.dir/FullAccumulator.cpp.o"
+  "CMakeFiles/mci.dir/FullAccumulator.cpp.o.d"
+  "CMakeFiles/mci.dir/MCIntegrator.cpp.o"
+  "CMakeFiles/mci.dir/MCIntegrator.cpp.o.d"
+  "CMakeFiles/mci.dir/MJBlocker.cpp.o"
+  "CMakeFiles/mci.dir/MJBlocker.cpp.o.d"
+  "CMakeFiles/mci.dir/MPIMCI.cpp.o"
+  "CMakeFiles/mci.dir/MPIMCI.cpp.o.d"
+  "CMakeFiles/mci.dir/MappedFullAccumulator.cpp.o"
+  "CMakeFiles/mci.dir/MappedFullAccumulator.cpp.o.d"
+  "CMakeFiles/mci.dir/MultiStepMove.cpp.o"
+  "CMakeFiles/mci.dir/MultiStepMove.cpp.o.d"
+  "CMakeFiles/mci.dir/ObservableContainer.cpp.o"
+  "CMakeFiles/mci.dir/ObservableContainer.cpp.o.d"
+  "CMakeFiles/mci.dir/OrthoPeriodicDomain.cpp.o"
+  "CMakeFiles/mci.dir/OrthoPeriodicDomain.cpp.o.d"
+  "CMakeFiles/mci.dir/ParallelFor.cpp.o"
+  "CMakeFiles/mci.dir/ParallelFor.cpp.o.d"
+  "CMakeFiles/mci.dir/PhiloxEngine.cpp.o"
+  "CMakeFiles/mci.dir/PhiloxEngine.cpp.o.d"
+  "CMakeFiles/mci.dir/ProtoFunctionInterface.cpp.o"
+  "CMakeFiles/mci.dir/ProtoFunctionInterface.cpp.o.d"
+  "CMakeFiles/mci.dir/RandomGenerator.cpp.o"
+  "CMakeFiles/mci.dir/RandomGenerator.cpp.o.d"
+  "CMakeFiles/mci.dir/Resampling.cpp.o"
+  "CMakeFiles/mci.dir/Resampling.cpp.o.d"
+  "CMakeFiles/mci.dir/SIMDKernels.cpp.o"
+  "CMakeFiles/mci.dir/SIMDKernels.cpp.o.d"
+  "CMakeFiles/mci.dir/SamplingFunctionContainer.cpp.o"
+  "CMakeFiles/mci.dir/SamplingFunctionContainer.cpp.o.d"
+  "CMakeFiles/mci.dir/SimpleAccumulator.cpp.o"
+  "CMakeFiles/mci.dir/SimpleAccumulator.cpp.o.d"
+  "CMakeFiles/mci.dir/StreamBlockAccumulator.cpp.o"
+  "CMakeFiles/mci.dir/StreamBlockAccumulator.cpp.o.d"
+  "CMakeFiles/mci.dir/TraceFile.cpp.o"
+  "CMakeFiles/mci.dir/TraceFile.cpp.o.d"
+  "CMakeFiles/mci.dir/XoshiroEngine.cpp.o"
+  "CMakeFiles/mci.dir/XoshiroEngine.cpp.o.d"
+  "libmci.pdb"
+  "libmci.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mci.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
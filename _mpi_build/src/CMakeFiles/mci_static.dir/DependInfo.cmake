@@ -0,0 +1,43 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/AccumulatorInterface.cpp" "src/CMakeFiles/mci_static.dir/AccumulatorInterface.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/AccumulatorInterface.cpp.o.d"
+  "/root/repo/src/BinningAccumulator.cpp" "src/CMakeFiles/mci_static.dir/BinningAccumulator.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/BinningAccumulator.cpp.o.d"
+  "/root/repo/src/BlockAccumulator.cpp" "src/CMakeFiles/mci_static.dir/BlockAccumulator.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/BlockAccumulator.cpp.o.d"
+  "/root/repo/src/CompressedFullAccumulator.cpp" "src/CMakeFiles/mci_static.dir/CompressedFullAccumulator.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/CompressedFullAccumulator.cpp.o.d"
+  "/root/repo/src/CovarianceAccumulator.cpp" "src/CMakeFiles/mci_static.dir/CovarianceAccumulator.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/CovarianceAccumulator.cpp.o.d"
+  "/root/repo/src/Estimators.cpp" "src/CMakeFiles/mci_static.dir/Estimators.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/Estimators.cpp.o.d"
+  "/root/repo/src/FullAccumulator.cpp" "src/CMakeFiles/mci_static.dir/FullAccumulator.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/FullAccumulator.cpp.o.d"
+  "/root/repo/src/MCIntegrator.cpp" "src/CMakeFiles/mci_static.dir/MCIntegrator.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/MCIntegrator.cpp.o.d"
+  "/root/repo/src/MJBlocker.cpp" "src/CMakeFiles/mci_static.dir/MJBlocker.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/MJBlocker.cpp.o.d"
+  "/root/repo/src/MPIMCI.cpp" "src/CMakeFiles/mci_static.dir/MPIMCI.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/MPIMCI.cpp.o.d"
+  "/root/repo/src/MappedFullAccumulator.cpp" "src/CMakeFiles/mci_static.dir/MappedFullAccumulator.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/MappedFullAccumulator.cpp.o.d"
+  "/root/repo/src/MultiStepMove.cpp" "src/CMakeFiles/mci_static.dir/MultiStepMove.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/MultiStepMove.cpp.o.d"
+  "/root/repo/src/ObservableContainer.cpp" "src/CMakeFiles/mci_static.dir/ObservableContainer.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/ObservableContainer.cpp.o.d"
+  "/root/repo/src/OrthoPeriodicDomain.cpp" "src/CMakeFiles/mci_static.dir/OrthoPeriodicDomain.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/OrthoPeriodicDomain.cpp.o.d"
+  "/root/repo/src/ParallelFor.cpp" "src/CMakeFiles/mci_static.dir/ParallelFor.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/ParallelFor.cpp.o.d"
+  "/root/repo/src/PhiloxEngine.cpp" "src/CMakeFiles/mci_static.dir/PhiloxEngine.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/PhiloxEngine.cpp.o.d"
+  "/root/repo/src/ProtoFunctionInterface.cpp" "src/CMakeFiles/mci_static.dir/ProtoFunctionInterface.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/ProtoFunctionInterface.cpp.o.d"
+  "/root/repo/src/RandomGenerator.cpp" "src/CMakeFiles/mci_static.dir/RandomGenerator.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/RandomGenerator.cpp.o.d"
+  "/root/repo/src/Resampling.cpp" "src/CMakeFiles/mci_static.dir/Resampling.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/Resampling.cpp.o.d"
+  "/root/repo/src/SIMDKernels.cpp" "src/CMakeFiles/mci_static.dir/SIMDKernels.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/SIMDKernels.cpp.o.d"
+  "/root/repo/src/SamplingFunctionContainer.cpp" "src/CMakeFiles/mci_static.dir/SamplingFunctionContainer.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/SamplingFunctionContainer.cpp.o.d"
+  "/root/repo/src/SimpleAccumulator.cpp" "src/CMakeFiles/mci_static.dir/SimpleAccumulator.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/SimpleAccumulator.cpp.o.d"
+  "/root/repo/src/StreamBlockAccumulator.cpp" "src/CMakeFiles/mci_static.dir/StreamBlockAccumulator.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/StreamBlockAccumulator.cpp.o.d"
+  "/root/repo/src/TraceFile.cpp" "src/CMakeFiles/mci_static.dir/TraceFile.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/TraceFile.cpp.o.d"
+  "/root/repo/src/XoshiroEngine.cpp" "src/CMakeFiles/mci_static.dir/XoshiroEngine.cpp.o" "gcc" "src/CMakeFiles/mci_static.dir/XoshiroEngine.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,59 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mci_static.dir/AccumulatorInterface.cpp.o"
+  "CMakeFiles/mci_static.dir/AccumulatorInterface.cpp.o.d"
+  "CMakeFiles/mci_static.dir/BinningAccumulator.cpp.o"
+  "CMakeFiles/mci_static.dir/BinningAccumulator.cpp.o.d"
+  "CMakeFiles/mci_static.dir/BlockAccumulator.cpp.o"
+  "CMakeFiles/mci_static.dir/BlockAccumulator.cpp.o.d"
+  "CMakeFiles/mci_static.dir/CompressedFullAccumulator.cpp.o"
+  "CMakeFiles/mci_static.dir/CompressedFullAccumulator.cpp.o.d"
+  "CMakeFiles/mci_static.dir/CovarianceAccumulator.cpp.o"
+  "CMakeFiles/mci_static.dir/CovarianceAccumulator.cpp.o.d"
+  "CMakeFiles/mci_static.dir/Estimators.cpp.o"
+  "CMakeFiles/mci_static.dir/Estimators.cpp.o.d"
+  "CMakeFiles/mci_static.dir/FullAccumulator.cpp.o"
+  "CMakeFiles/mci_static.dir/FullAccumulator.cpp.o.d"
+  "CMakeFiles/mci_static.dir/MCIntegrator.cpp.o"
+  "CMakeFiles/mci_static.dir/MCIntegrator.cpp.o.d"
+  "CMakeFiles/mci_static.dir/MJBlocker.cpp.o"
+  "CMakeFiles/mci_static.dir/MJBlocker.cpp.o.d"
+  "CMakeFiles/mci_static.dir/MPIMCI.cpp.o"
+  "CMakeFiles/mci_static.dir/MPIMCI.cpp.o.d"
+  "CMakeFiles/mci_static.dir/MappedFullAccumulator.cpp.o"
+  "CMakeFiles/mci_static.dir/MappedFullAccumulator.cpp.o.d"
+  "CMakeFiles/mci_static.dir/MultiStepMove.cpp.o"
+  "CMakeFiles/mci_static.dir/MultiStepMove.cpp.o.d"
+  "CMakeFiles/mci_static.dir/ObservableContainer.cpp.o"
+  "CMakeFiles/mci_static.dir/ObservableContainer.cpp.o.d"
+  "CMakeFiles/mci_static.dir/OrthoPeriodicDomain.cpp.o"
+  "CMakeFiles/mci_static.dir/OrthoPeriodicDomain.cpp.o.d"
+  "CMakeFiles/mci_static.dir/ParallelFor.cpp.o"
+  "CMakeFiles/mci_static.dir/ParallelFor.cpp.o.d"
+  "CMakeFiles/mci_static.dir/PhiloxEngine.cpp.o"
+  "CMakeFiles/mci_static.dir/PhiloxEngine.cpp.o.d"
+  "CMakeFiles/mci_static.dir/ProtoFunctionInterface.cpp.o"
+  "CMakeFiles/mci_static.dir/ProtoFunctionInterface.cpp.o.d"
+  "CMakeFiles/mci_static.dir/RandomGenerator.cpp.o"
+  "CMakeFiles/mci_static.dir/RandomGenerator.cpp.o.d"
+  "CMakeFiles/mci_static.dir/Resampling.cpp.o"
+  "CMakeFiles/mci_static.dir/Resampling.cpp.o.d"
+  "CMakeFiles/mci_static.dir/SIMDKernels.cpp.o"
+  "CMakeFiles/mci_static.dir/SIMDKernels.cpp.o.d"
+  "CMakeFiles/mci_static.dir/SamplingFunctionContainer.cpp.o"
+  "CMakeFiles/mci_static.dir/SamplingFunctionContainer.cpp.o.d"
+  "CMakeFiles/mci_static.dir/SimpleAccumulator.cpp.o"
+  "CMakeFiles/mci_static.dir/SimpleAccumulator.cpp.o.d"
+  "CMakeFiles/mci_static.dir/StreamBlockAccumulator.cpp.o"
+  "CMakeFiles/mci_static.dir/StreamBlockAccumulator.cpp.o.d"
+  "CMakeFiles/mci_static.dir/TraceFile.cpp.o"
+  "CMakeFiles/mci_static.dir/TraceFile.cpp.o.d"
+  "CMakeFiles/mci_static.dir/XoshiroEngine.cpp.o"
+  "CMakeFiles/mci_static.dir/XoshiroEngine.cpp.o.d"
+  "libmci_static.a"
+  "libmci_static.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mci_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/check.dir/main.cpp.o"
+  "CMakeFiles/check.dir/main.cpp.o.d"
+  "check"
+  "check.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/check.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
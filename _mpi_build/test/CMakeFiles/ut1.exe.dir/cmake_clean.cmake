@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut1.exe.dir/ut1/main.cpp.o"
+  "CMakeFiles/ut1.exe.dir/ut1/main.cpp.o.d"
+  "ut1.exe"
+  "ut1.exe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut1.exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut10.exe.dir/ut10/main.cpp.o"
+  "CMakeFiles/ut10.exe.dir/ut10/main.cpp.o.d"
+  "ut10.exe"
+  "ut10.exe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut10.exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
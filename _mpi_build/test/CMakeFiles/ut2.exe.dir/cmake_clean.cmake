@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut2.exe.dir/ut2/main.cpp.o"
+  "CMakeFiles/ut2.exe.dir/ut2/main.cpp.o.d"
+  "ut2.exe"
+  "ut2.exe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut2.exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
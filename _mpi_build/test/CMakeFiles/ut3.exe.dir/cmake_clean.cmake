@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut3.exe.dir/ut3/main.cpp.o"
+  "CMakeFiles/ut3.exe.dir/ut3/main.cpp.o.d"
+  "ut3.exe"
+  "ut3.exe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut3.exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut4.exe.dir/ut4/main.cpp.o"
+  "CMakeFiles/ut4.exe.dir/ut4/main.cpp.o.d"
+  "ut4.exe"
+  "ut4.exe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut4.exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
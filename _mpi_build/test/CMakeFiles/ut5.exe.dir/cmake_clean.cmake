@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut5.exe.dir/ut5/main.cpp.o"
+  "CMakeFiles/ut5.exe.dir/ut5/main.cpp.o.d"
+  "ut5.exe"
+  "ut5.exe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut5.exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut6.exe.dir/ut6/main.cpp.o"
+  "CMakeFiles/ut6.exe.dir/ut6/main.cpp.o.d"
+  "ut6.exe"
+  "ut6.exe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut6.exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut7.exe.dir/ut7/main.cpp.o"
+  "CMakeFiles/ut7.exe.dir/ut7/main.cpp.o.d"
+  "ut7.exe"
+  "ut7.exe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut7.exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
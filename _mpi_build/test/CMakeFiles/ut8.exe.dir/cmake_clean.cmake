@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut8.exe.dir/ut8/main.cpp.o"
+  "CMakeFiles/ut8.exe.dir/ut8/main.cpp.o.d"
+  "ut8.exe"
+  "ut8.exe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut8.exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ut9.exe.dir/ut9/main.cpp.o"
+  "CMakeFiles/ut9.exe.dir/ut9/main.cpp.o.d"
+  "ut9.exe"
+  "ut9.exe.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ut9.exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,26 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_mpi_build/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(ut1 "ut1.exe")
+set_tests_properties(ut1 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;15;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(ut2 "ut2.exe")
+set_tests_properties(ut2 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;16;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(ut3 "ut3.exe")
+set_tests_properties(ut3 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;17;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(ut4 "ut4.exe")
+set_tests_properties(ut4 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;18;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(ut5 "ut5.exe")
+set_tests_properties(ut5 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;19;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(ut6 "ut6.exe")
+set_tests_properties(ut6 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;20;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(ut7 "ut7.exe")
+set_tests_properties(ut7 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;21;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(ut8 "ut8.exe")
+set_tests_properties(ut8 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;22;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(ut9 "ut9.exe")
+set_tests_properties(ut9 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;23;add_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(ut10 "ut10.exe")
+set_tests_properties(ut10 PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;24;add_test;/root/repo/test/CMakeLists.txt;0;")
@@ -28,20 +28,22 @@ int main()
 {
     const bool flag_debug = false;
     const bool verbose = flag_debug; // some debug printout
-    const int NMC = flag_debug ? 4096 : 8388608; // use power of two to allow MJBlocker
+    const int NMC = flag_debug ? 4096 : 8388608; // power of two, for comparability with older results
     const int nruns = 10;
-    const int ntypes = 7;
+    const int ntypes = 9;
     const BenchEstim estimatorTypes[ntypes] = {BenchEstim::Uncorr1D, BenchEstim::Block1D, BenchEstim::CorrFC1D,
-                                               BenchEstim::UncorrND, BenchEstim::BlockND, BenchEstim::CorrFCND, BenchEstim::CorrMJND};
+                                               BenchEstim::UncorrND, BenchEstim::BlockND, BenchEstim::CorrFCND, BenchEstim::CorrMJND,
+                                               BenchEstim::UncorrNDScalar, BenchEstim::CorrMJNDScalar};
     const int ndims[3] = {1, 16, 128};
     const double stepSizes[3] = {1.59, 0.313, 0.1053};
 
-    vector<string> labels{"noblock-1D", "500K-block-1D", "autoblock-FC-1D", "noblock-ND", "500K-block-ND", "autoblock-FC-ND", "autoblock-MJ-ND"};
+    vector<string> labels{"noblock-1D", "500K-block-1D", "autoblock-FC-1D", "noblock-ND", "500K-block-ND", "autoblock-FC-ND", "autoblock-MJ-ND",
+                          "noblock-ND-scalar", "autoblock-MJ-ND-scalar"};
 
     srand(1337); // consistent random seed
 
     cout << "=========================================================================================" << endl << endl;
-    cout << "Benchmark results (time per sample and dimension):" << endl;
+    cout << "Benchmark results (time per sample and dimension, SIMD level " << static_cast<int>(getSIMDLevel()) << "):" << endl;
 
     // Estimator benchmark
     for (int i = 0; i < 3; ++i) { // go through ndims/stepSizes
@@ -11,6 +11,7 @@
 #include "Timer.hpp"
 #include "mci/Estimators.hpp"
 #include "mci/MCIntegrator.hpp"
+#include "mci/SIMDKernels.hpp"
 
 inline std::pair<double, double> sample_benchmark(const std::function<double()> &run_benchmark /*all parameters bound*/, const int nruns)
 {
@@ -58,7 +59,9 @@ enum class BenchEstim
     UncorrND,
     BlockND,
     CorrFCND,
-    CorrMJND
+    CorrMJND,
+    UncorrNDScalar, /* like UncorrND, but with the scalar kernels (to see the SIMD speedup) */
+    CorrMJNDScalar /* like CorrMJND, but with the scalar kernels */
 };
 
 inline double benchmark_estimators(const double datax[],
@@ -117,6 +120,18 @@ inline double benchmark_estimators(const double datax[],
         mci::MJBlockerEstimator(NMC, ndim, datax, average, error);
         break;
 
+    case BenchEstim::UncorrNDScalar:
+    case BenchEstim::CorrMJNDScalar:
+    {
+        const mci::SIMDLevel level = mci::getSIMDLevel();
+        mci::setSIMDLevel(mci::SIMDLevel::Scalar);
+        timer.reset();
+        if (estimatorType == BenchEstim::UncorrNDScalar) { mci::MultiDimUncorrelatedEstimator(NMC, ndim, datax, average, error); }
+        else { mci::MJBlockerEstimator(NMC, ndim, datax, average, error); }
+        const double time = timer.elapsed();
+        mci::setSIMDLevel(level);
+        return time;
+    }
 
     default:
         throw std::invalid_argument("Invalid enumerator.");
@@ -5,7 +5,9 @@
 #include "mci/WalkerState.hpp"
 
 #include <cstdint>
+#include <iosfwd>
 #include <memory>
+#include <stdexcept>
 
 namespace mci
 {
@@ -31,9 +33,11 @@ protected:
     // fixed-size allocations
     double * const _obs_values; // observable's last values (length _nobs)
     bool * const _flags_xchanged; // remembers which x have changed since last obs evaluation (length _xndim)
+    int * const _idx_xchanged; // the first _nchanged elements are the indices of changed x (length _xndim, only valid if _nchanged < _xndim)
 
     // variables
     int64_t _nsteps; // total number of sampling steps (set on allocate() to planned number of calls to accumulateObservables)
+    int64_t _naccu; // total number of accumulated steps (set on allocate(), increased on merge())
     double * _data; // childs use this to store data
 
     int _nchanged{}; // counter of how many x have changed since last obs evaluation
@@ -53,6 +57,12 @@ protected:
     virtual void _finalize() = 0; // if necessary, apply normalization ( do nothing when deallocated )
     virtual void _reset() = 0; // reset data / child's members ( must work in deallocated state )
     virtual void _deallocate() = 0; // delete _data allocation ( reset will be called already )
+    virtual void _merge(int64_t nstore, int64_t naccu, const double data[]) = 0; // append finalized data of another run ( throw if incompatible )
+    virtual void _saveState(std::ostream &out) const = 0; // write data and child's members ( allocated, not finalized )
+    virtual void _loadState(std::istream &in) = 0; // read them back ( allocated equally, base state is loaded already )
+
+    // OPTIONAL
+    virtual void _reserveMerge(int64_t /*nstore*/) {} // make room for nstore more elements to merge ( by default merge allocates )
 
     // Constructor
     AccumulatorInterface(ObservableFunctionInterface &obs, int nskip);
@@ -69,10 +79,7 @@ public:
 
     int getNSkip() const { return _nskip; }
     int64_t getNSteps() const { return _nsteps; }
-    int64_t getNAccu() const
-    {
-        return (_nsteps > 0) ? 1 + (_nsteps - 1)/_nskip : 0; // actual number of steps to accumulate
-    }
+    int64_t getNAccu() const { return _naccu; } // actual number of steps to accumulate
     int64_t getNData() const { return this->getNStore()*_nobs; } // total length of allocated data
 
     int64_t getStepIndex() const { return _stepidx; }
@@ -83,6 +90,7 @@ public:
 
     // get data
     const double * getData() const { return _data; } // direct read-only access to internal data pointer
+    double * consumeData(); // write access to finalized data for destructive estimation ( afterwards only reset/deallocate are valid )
     const double * getObsValues() const { return _obs_values; } // read-only pointer to last calculated observable data
     double getObsValue(int i) const { return _obs_values[i]; } // element-wise access to last values
 
@@ -107,6 +115,26 @@ public:
 
     // deallocate memory
     void deallocate();
+
+    // merge the finalized data of another finalized accumulator of the same type into this one
+    // Afterwards this accumulator behaves as if it had accumulated both runs in sequence.
+    void merge(const AccumulatorInterface &other);
+
+    // same as above, but from raw data of an equally configured accumulator (e.g. received from another MPI rank)
+    // nsteps/naccu/nstore are the values returned by the corresponding getters of the other accumulator
+    void merge(int64_t nsteps, int64_t naccu, int64_t nstore, const double data[]);
+
+    // may raw data be merged in pieces of whole storage elements (e.g. received in chunks from another MPI rank)?
+    // This requires that every element stands for the same number of accumulations.
+    virtual bool isChunkMergeable() const { return false; }
+
+    // prepare the merge of nstore more elements (e.g. in chunks), so that the merges don't need to reallocate every time
+    void reserveMerge(int64_t nstore);
+
+    // checkpointing: write the complete state of an unfinished run, to be loaded into an
+    // accumulator of the same type and configuration, allocated for the same number of steps
+    void saveState(std::ostream &out) const;
+    void loadState(std::istream &in);
 };
 }  // namespace mci
 
@@ -0,0 +1,60 @@
+#ifndef MCI_BINNINGACCUMULATOR_HPP
+#define MCI_BINNINGACCUMULATOR_HPP
+
+#include "mci/AccumulatorInterface.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace mci
+{
+// Class to handle accumulation of observables into a fixed number of bins (block averages), with adaptive block size.
+// Starting with a block size of 1, whenever all bins are filled, neighbouring bins are merged in pairs
+// and the block size doubles. So the memory is bounded by nbins*nobs for any number of steps and there
+// is no need to guess a block size. The resulting block averages can be passed to any of the estimators
+// (e.g. the blocking ones, to account for remaining correlation between the blocks).
+//
+// NOTE 1: After finalization, the data contains only the completely filled bins (between nbins/2 and nbins,
+//         or less than nbins if no doubling was necessary). A partially filled last bin is dropped.
+// NOTE 2: On merge, the finer binned data is merged pairwise to the coarser block size (dropping an odd last bin)
+//         and the bins get merged again as long as there are more than nbins. Data without a full bin adds no bins.
+//
+class BinningAccumulator final: public AccumulatorInterface
+{
+protected:
+    const int _nbins; // number of allocated bins
+    int64_t _blocksize; // current number of samples per bin
+    int64_t _nfull; // number of completely filled bins
+    int64_t _nstore; // nbins while accumulating, _nfull when finalized
+
+    int64_t _bidx; // counter to determine when bin is finished
+    int64_t _storeidx; // storage index offset for next write
+
+    void _compact(); // merge pairs of the full bins and double the blocksize
+
+    // --- storage method to be implemented
+    void _allocate() final;
+    void _accumulate() final;
+    void _finalize() final;
+    void _reset() final;
+    void _deallocate() final;
+    void _merge(int64_t nstore, int64_t naccu, const double data[]) final;
+    void _saveState(std::ostream &out) const final;
+    void _loadState(std::istream &in) final;
+
+public:
+    BinningAccumulator(ObservableFunctionInterface &obs, int nskip, int nbins):
+            AccumulatorInterface(obs, nskip), _nbins(nbins), _blocksize(1), _nfull(0), _nstore(0), _bidx(0), _storeidx(0)
+    {
+        if (_nbins < 2 || _nbins%2 != 0) { throw std::invalid_argument("[BinningAccumulator] Requested number of bins must be even and >= 2 ."); }
+    }
+
+    ~BinningAccumulator() final { this->_deallocate(); }
+
+    int getNBins() const { return _nbins; }
+    int64_t getBlockSize() const { return _blocksize; } // current (or final) number of samples per bin
+    int64_t getNStore() const final { return _nstore; }
+};
+}  // namespace mci
+
+#endif
@@ -11,14 +11,17 @@ namespace mci
 // is desired. Typical use case is if you know how large the blocks have to be for uncorrelated samples
 // and want to avoid the memory&CPU overhead of using automatic blocking.
 // NOTE: The planned number of steps must be a multiple of the chosen blocksize.
+// NOTE 2: Optionally, the blocks are stored column-major, i.e. in [nobs][nblocks] layout (see FullAccumulator).
 class BlockAccumulator final: public AccumulatorInterface
 {
 protected:
     const int _blocksize; // how many samples to accumulate per block
     int64_t _nblocks; // this will be set properly on allocation
+    int64_t _ncapacity; // number of blocks _data has room for (>= _nblocks after reserveMerge)
 
     int _bidx; // counter to determine when block is finished
-    int64_t _storeidx; // storage index offset for next write
+    int64_t _storeidx; // storage index offset for next write (column-major: index of current block)
+    const bool _flag_colmajor; // store blocks in [nobs][nblocks] layout?
 
     // --- storage method to be implemented
     void _allocate() final;
@@ -26,10 +29,14 @@ protected:
     void _finalize() final;
     void _reset() final;
     void _deallocate() final;
+    void _merge(int64_t nstore, int64_t naccu, const double data[]) final;
+    void _reserveMerge(int64_t nstore) final;
+    void _saveState(std::ostream &out) const final;
+    void _loadState(std::istream &in) final;
 
 public:
-    BlockAccumulator(ObservableFunctionInterface &obs, int nskip, int blocksize):
-            AccumulatorInterface(obs, nskip), _blocksize(blocksize), _nblocks(0), _bidx(0), _storeidx(0)
+    BlockAccumulator(ObservableFunctionInterface &obs, int nskip, int blocksize, bool flag_colmajor = false):
+            AccumulatorInterface(obs, nskip), _blocksize(blocksize), _nblocks(0), _ncapacity(0), _bidx(0), _storeidx(0), _flag_colmajor(flag_colmajor)
     {
         if (_blocksize < 1) { throw std::invalid_argument("[BlockAccumulator] Requested blocksize was < 1 ."); }
     }
@@ -37,6 +44,8 @@ public:
     ~BlockAccumulator() final { this->_deallocate(); }
 
     int getBlockSize() const { return _blocksize; }
+    bool isColumnMajor() const { return _flag_colmajor; }
+    bool isChunkMergeable() const final { return !_flag_colmajor; } // columns can't be appended in pieces
     int64_t getNStore() const final { return _nblocks; }
 };
 }  // namespace mci
@@ -0,0 +1,76 @@
+#ifndef MCI_CHECKPOINT_HPP
+#define MCI_CHECKPOINT_HPP
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace mci
+{
+// Helpers to write and read the binary checkpoints of MCI (see MCI::setCheckpoint), which
+// may also be used to save own state in the _saveState/_loadState hooks of PDFs and moves.
+// Values are written as raw bytes in native byte order, i.e. a checkpoint is meant to be
+// resumed by the same build on the same kind of machine. Reading throws on a truncated file.
+
+template <typename T>
+void writeCheckpointArray(std::ostream &out, const T values[], const int64_t n)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be checkpointed.");
+    out.write(reinterpret_cast<const char *>(values), static_cast<std::streamsize>(n*sizeof(T)));
+}
+
+template <typename T>
+void writeCheckpointValue(std::ostream &out, const T &value) { writeCheckpointArray(out, &value, 1); }
+
+inline void writeCheckpointString(std::ostream &out, const std::string &str)
+{
+    writeCheckpointValue(out, static_cast<int64_t>(str.size()));
+    writeCheckpointArray(out, str.data(), static_cast<int64_t>(str.size()));
+}
+
+
+template <typename T>
+void readCheckpointArray(std::istream &in, T values[], const int64_t n)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be checkpointed.");
+    in.read(reinterpret_cast<char *>(values), static_cast<std::streamsize>(n*sizeof(T)));
+    if (!in) { throw std::runtime_error("[readCheckpoint] Checkpoint ended unexpectedly."); }
+}
+
+template <typename T>
+T readCheckpointValue(std::istream &in)
+{
+    T value;
+    readCheckpointArray(in, &value, 1);
+    return value;
+}
+
+constexpr int64_t CHECKPOINT_MAX_STRING = 1 << 20; // checkpoint strings are type names or short states, so a longer one means a damaged file
+
+inline std::string readCheckpointString(std::istream &in)
+{
+    const auto len = readCheckpointValue<int64_t>(in);
+    if (len < 0 || len > CHECKPOINT_MAX_STRING) { throw std::runtime_error("[readCheckpoint] Checkpoint contains an invalid string length."); }
+    std::string str(static_cast<size_t>(len), '\0');
+    readCheckpointArray(in, &str[0], len);
+    return str;
+}
+
+// read a value and compare it to the expected one (e.g. a dimension or a type name), throws std::invalid_argument with
+// the passed message if the checkpoint was written for a different configuration
+template <typename T>
+void expectCheckpointValue(std::istream &in, const T &expected, const char * msg)
+{
+    if (readCheckpointValue<T>(in) != expected) { throw std::invalid_argument(msg); }
+}
+
+inline void expectCheckpointString(std::istream &in, const std::string &expected, const char * msg)
+{
+    if (readCheckpointString(in) != expected) { throw std::invalid_argument(msg); }
+}
+}  // namespace mci
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef MCI_COMPRESSEDFULLACCUMULATOR_HPP
+#define MCI_COMPRESSEDFULLACCUMULATOR_HPP
+
+#include "mci/AccumulatorInterface.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace mci
+{
+// Class to handle accumulation of observables like FullAccumulator, i.e. storing every single sample,
+// but in a lossless compressed encoding. This pays off when many successive samples are identical,
+// which happens on every rejected step (i.e. at low acceptance rates) or for observables that
+// depend only on part of the walkers:
+//   - Every sample is XOR-ed bitwise with the previous one and only the non-zero bytes are stored,
+//     with one header byte per value (number of leading/trailing zero bytes).
+//   - Repetitions of a sample are run-length encoded, with one count after every stored sample.
+// The storage grows on demand, so the memory is proportional to the compressed size.
+//
+// NOTE 1: The stored data are not samples, but HEADER_SIZE doubles (number of samples/bytes) followed by
+//         the encoded byte stream (padded to full rows of nobs). Use CompressedSampleReader to decode it.
+//         The estimators for compressed data (see Estimators.hpp) decode it chunk by chunk in a single pass,
+//         so only the Uncorrelated and Correlated/MJBlocker estimators are supported.
+// NOTE 2: Incompressible data (e.g. every step accepted and all bytes of all values changing) needs 9 bytes per value
+//         and 1 byte for the repetition count per sample, i.e. up to (9*nobs + 1)/(8*nobs) times the memory of
+//         FullAccumulator (+25% for nobs = 1, approaching +12.5% for many values), plus header and padding.
+//
+class CompressedFullAccumulator final: public AccumulatorInterface
+{
+public:
+    static constexpr int HEADER_SIZE = 2; // doubles in front of the byte stream
+
+protected:
+    int64_t _nstore; // number of used storage elements with _nobs length each (header + stream)
+    int64_t _capacity; // number of allocated doubles (multiple of _nobs)
+    int64_t _nbytes; // length of the encoded byte stream
+    int64_t _nsamples; // number of encoded samples (including repetitions)
+    int64_t _nrepeat; // repetitions of the last encoded sample, not yet written (< 0 if none is pending)
+    double * const _last; // last encoded sample (length _nobs)
+
+    void _reserve(int64_t nbytes); // make sure that nbytes more bytes fit into the storage
+    void _append(const double values[]); // encode the next sample
+    void _flushRepeats(); // write the repetition count of the last sample
+    void _updateHeader(); // write the counters to the header and update _nstore
+
+    // --- storage method to be implemented
+    void _allocate() final;
+    void _accumulate() final;
+    void _finalize() final;
+    void _reset() final;
+    void _deallocate() final;
+    void _merge(int64_t nstore, int64_t naccu, const double data[]) final;
+    void _saveState(std::ostream &out) const final;
+    void _loadState(std::istream &in) final;
+
+public:
+    CompressedFullAccumulator(ObservableFunctionInterface &obs, int nskip):
+            AccumulatorInterface(obs, nskip), _nstore(0), _capacity(0), _nbytes(0), _nsamples(0), _nrepeat(-1), _last(new double[_nobs]) {}
+
+    ~CompressedFullAccumulator() final
+    {
+        this->_deallocate();
+        delete[] _last;
+    }
+
+    int64_t getNSamples() const { return _nsamples; } // number of accumulated samples
+    int64_t getNBytes() const { return _nbytes; } // size of the encoded samples in bytes (excluding header and padding)
+    int64_t getNStore() const final { return _nstore; }
+};
+
+
+// Decoding iterator over the data of a (finalized) CompressedFullAccumulator, which yields the samples in
+// chunks of rows with the usual [n][nobs] layout, e.g. for passing them to the estimators.
+class CompressedSampleReader
+{
+public:
+    static constexpr int64_t CHUNK_SIZE = 1 << 14; // number of doubles decoded at once by the streaming estimators (at least one row)
+
+protected:
+    const int _nobs; // number of values per sample
+    int64_t _nsamples; // total number of samples
+    int64_t _nbytes; // length of the byte stream
+    const unsigned char * _stream; // begin of the byte stream
+
+    int64_t _pos; // read position in the stream
+    int64_t _nread; // number of samples read so far
+    int64_t _nrepeat; // remaining repetitions of the current sample
+    std::unique_ptr<double[]> _row; // current sample (length _nobs)
+
+public:
+    CompressedSampleReader(int64_t nstore, int nobs, const double data[]);
+
+    int64_t getNSamples() const { return _nsamples; }
+    int64_t getNRead() const { return _nread; }
+    bool done() const { return _nread == _nsamples; }
+
+    int64_t read(int64_t nrows, double out[]); // decode up to nrows next samples into out, returns number of decoded samples
+    void rewind(); // start over from the first sample
+};
+}  // namespace mci
+
+#endif
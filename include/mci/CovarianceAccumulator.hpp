@@ -0,0 +1,83 @@
+#ifndef MCI_COVARIANCEACCUMULATOR_HPP
+#define MCI_COVARIANCEACCUMULATOR_HPP
+
+#include "mci/AccumulatorInterface.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace mci
+{
+// Class to handle accumulation of observables, when the covariance between the observable dimensions is desired,
+// without storing the samples. Averages of fixed-size blocks (blocksize 1: every sample) are passed to Welford's
+// online algorithm, i.e. we keep only the running mean and co-moment matrix of the block averages. So the memory is
+// O(nobs^2), independent of the run length. Like for BlockAccumulator, the blocks should be long enough to be uncorrelated.
+//
+// NOTE 1: The stored data are not samples, but the running mean, the number of blocks and the nobs x nobs co-moment
+//         matrix (see Row below). They are only meant to be evaluated by the static methods below (used by EstimatorType::Covariance).
+// NOTE 2: A partially filled last block is dropped on finalization.
+// NOTE 3: Merging combines the moments of both runs (pairwise update of Chan et al.), as if the blocks were concatenated.
+//
+class CovarianceAccumulator final: public AccumulatorInterface
+{
+public:
+    // data rows (of length nobs)
+    enum Row
+    {
+        MEAN, /* mean of the block averages */
+        COUNT, /* number of blocks (equal in all columns) */
+        COMOMENT /* first of nobs rows of the co-moment matrix, i.e. sum of (x_i - mean_i)*(x_j - mean_j) */
+    };
+
+protected:
+    const int _blocksize; // how many samples to average per block
+    int64_t _nstore; // COMOMENT + nobs when allocated, else 0
+
+    int _bidx; // counter to determine when block is finished
+    double * const _blocksum; // sum of the current block (length _nobs)
+    double * const _delta; // helper for the update (length _nobs)
+
+    void _addBlock(); // pass the finished block to the running moments
+
+    // --- storage method to be implemented
+    void _allocate() final;
+    void _accumulate() final;
+    void _finalize() final;
+    void _reset() final;
+    void _deallocate() final;
+    void _merge(int64_t nstore, int64_t naccu, const double data[]) final;
+    void _saveState(std::ostream &out) const final;
+    void _loadState(std::istream &in) final;
+
+public:
+    CovarianceAccumulator(ObservableFunctionInterface &obs, int nskip, int blocksize):
+            AccumulatorInterface(obs, nskip), _blocksize(blocksize), _nstore(0), _bidx(0),
+            _blocksum(new double[_nobs]), _delta(new double[_nobs])
+    {
+        if (_blocksize < 1) {
+            delete[] _delta;
+            delete[] _blocksum;
+            throw std::invalid_argument("[CovarianceAccumulator] Requested blocksize was < 1 .");
+        }
+        std::fill(_blocksum, _blocksum + _nobs, 0.);
+    }
+
+    ~CovarianceAccumulator() final
+    {
+        this->_deallocate();
+        delete[] _delta;
+        delete[] _blocksum;
+    }
+
+    int getBlockSize() const { return _blocksize; }
+    int64_t getNStore() const final { return _nstore; }
+
+    // Compute average and error of the mean from the data of a CovarianceAccumulator
+    static void estimate(int64_t nstore, int nobs, const double data[], double average[], double error[]);
+    // Compute the covariance matrix of the mean (nobs x nobs, row-major) from the data of a CovarianceAccumulator
+    static void covariance(int64_t nstore, int nobs, const double data[], double cov[]);
+};
+}  // namespace mci
+
+#endif
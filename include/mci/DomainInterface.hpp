@@ -4,6 +4,7 @@
 #include "mci/Clonable.hpp"
 #include "mci/WalkerState.hpp"
 
+#include <limits>
 #include <stdexcept>
 
 namespace mci
@@ -0,0 +1,42 @@
+#ifndef MCI_ESTIMATORWORKSPACE_HPP
+#define MCI_ESTIMATORWORKSPACE_HPP
+
+#include "mci/MJBlocker.hpp"
+
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mci
+{
+// Scratch memory of the estimators (see Estimators.hpp), to be reused over many calls.
+// The buffers grow on demand and are kept, so repeated estimations of data with the same layout
+// (e.g. in the decorrelation loop or in repeated integrations) don't allocate any memory.
+//
+// NOTE: A workspace must not be used by several estimations at the same time (e.g. from different threads).
+//
+struct EstimatorWorkspace
+{
+    // blocking estimators
+    std::vector<double> blockav; // block averages (nblocks*ndim)
+    std::vector<int64_t> fcbounds; // FCBlocker: unique block boundaries of all blockings
+    std::vector<double> fcsegsum; // FCBlocker: data sums between the boundaries (nseg*ndim)
+    std::vector<double> fcav, fcerr; // FCBlocker: averages and errors of all blockings (nblockings*ndim)
+    std::vector<double> fcaccdelta; // FCBlocker: accumulated plateau deltas (ndeltas*ndim)
+    std::vector<int> fcimin; // FCBlocker: index of the plateau per dimension (ndim)
+    std::unique_ptr<MJBlocker> mjblk; // MJBlocker for the last data layout
+
+    // autocorrelation analysis
+    std::vector<std::complex<double>> fft; // FFT buffer (next power of 2 >= 2*n)
+    std::vector<std::complex<double>> twiddle; // FFT twiddle factors (half the FFT length)
+
+    // pre-allocate the ndim-dependent buffers of the FCBlocker (the others depend on the data length and grow on first use)
+    void reserveFCBlocker(int ndim);
+
+    // get an MJBlocker for the given layout (only created if it differs from the last one)
+    MJBlocker &getMJBlocker(int64_t ndata, int ndim, bool in_place);
+};
+}  // namespace mci
+
+#endif
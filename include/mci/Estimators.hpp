@@ -1,18 +1,26 @@
 #ifndef MCI_ESTIMATORS_HPP
 #define MCI_ESTIMATORS_HPP
 
+#include "mci/EstimatorWorkspace.hpp"
+
 #include <cstdint>
 
 namespace mci
 {
+// NOTE: Estimators which need scratch memory have an overload taking an EstimatorWorkspace as last argument,
+//       where the memory is kept for subsequent calls. Without it, the memory is allocated on every call.
+
 // Compute average and standard deviation (error) of a set of data x[N], assuming that they are not correlated
 void OneDimUncorrelatedEstimator(int64_t n, const double x[], double &average, double &error);
 
-// Compute average and error, using the blocking technique (only used by FCBlockerEstimator, not by MCI)
+// Compute average and error, using the blocking technique (not used by MCI)
 void OneDimBlockEstimator(int64_t n, const double x[], int64_t nblocks, double &average, double &error);
+void OneDimBlockEstimator(int64_t n, const double x[], int64_t nblocks, double &average, double &error, EstimatorWorkspace &ws);
 
 // Compute average and error for correlated data, using auto blocking technique (by Francesco Calcavecchia)
+// All blockings (6..50 blocks) are computed from segment sums obtained in a single pass over the data.
 void OneDimFCBlockerEstimator(int64_t n, const double x[], double &average, double &error);
+void OneDimFCBlockerEstimator(int64_t n, const double x[], double &average, double &error, EstimatorWorkspace &ws);
 
 
 // Estimators for multidimensional observable data
@@ -26,20 +34,60 @@ void OneDimFCBlockerEstimator(int64_t n, const double x[], double &average, doub
 // Compute average and standard deviation (error) of a set of data x[N], assuming that they are not correlated
 void MultiDimUncorrelatedEstimator(int64_t n, int ndim, const double x[], double average[], double error[]);
 
-// Compute average and error, using fixed blocking technique (only used by FCBlockerEstimator, not by MCI)
+// Compute average and error, using fixed blocking technique (not used by MCI)
 void MultiDimBlockEstimator(int64_t n, int ndim, const double x[], int64_t nblocks, double average[], double error[]);
+void MultiDimBlockEstimator(int64_t n, int ndim, const double x[], int64_t nblocks, double average[], double error[], EstimatorWorkspace &ws);
 
 // Compute average and error for correlated data, using auto blocking technique (by Francesco Calcavecchia)
 void MultiDimFCBlockerEstimator(int64_t n, int ndim, const double x[], double average[], double error[]);
+void MultiDimFCBlockerEstimator(int64_t n, int ndim, const double x[], double average[], double error[], EstimatorWorkspace &ws);
 
 
 // any-dim wrappers for above functions and other estimators
 void UncorrelatedEstimator(int64_t n, int ndim, const double x[], double average[], double error[]);
-void CorrelatedEstimator(int64_t n, int ndim, const double x[], double average[], double error[]); // if n is power of 2, use MJBlocker, else FCBlocker
+void CorrelatedEstimator(int64_t n, int ndim, const double x[], double average[], double error[]); // currently uses MJBlocker
+void CorrelatedEstimator(int64_t n, int ndim, const double x[], double average[], double error[], EstimatorWorkspace &ws);
 void FCBlockerEstimator(int64_t n, int ndim, const double x[], double average[], double error[]);
+void FCBlockerEstimator(int64_t n, int ndim, const double x[], double average[], double error[], EstimatorWorkspace &ws);
 
 // Calls our implementation Marius Jonsson's auto-blocking algorithm
 void MJBlockerEstimator(int64_t n, int ndim, const double x[], double average[], double error[]);
+void MJBlockerEstimator(int64_t n, int ndim, const double x[], double average[], double error[], EstimatorWorkspace &ws);
+
+// In-place versions of the above, which overwrite x (for large data that is not needed after estimation)
+void MJBlockerEstimatorInPlace(int64_t n, int ndim, double x[], double average[], double error[]);
+void MJBlockerEstimatorInPlace(int64_t n, int ndim, double x[], double average[], double error[], EstimatorWorkspace &ws);
+void CorrelatedEstimatorInPlace(int64_t n, int ndim, double x[], double average[], double error[]);
+void CorrelatedEstimatorInPlace(int64_t n, int ndim, double x[], double average[], double error[], EstimatorWorkspace &ws);
+
+// Marius Jonsson's auto-blocking from running level sums, i.e. x must be the data of a StreamBlockAccumulator
+void StreamMJBlockerEstimator(int64_t nstore, int ndim, const double x[], double average[], double error[]);
+
+// Uncorrelated estimator for column-major data x ([ndim][n] layout), which goes through every column contiguously
+// (for the other estimators on column-major data see createColumnMajorEstimator in Factories.hpp)
+void ColumnMajorUncorrelatedEstimator(int64_t n, int ndim, const double x[], double average[], double error[]);
+
+// Marius Jonsson's auto-blocking of the samples x in a single sequential pass with O(log2(n)*ndim) memory
+// (same result as MJBlockerEstimator up to rounding, e.g. for memory-mapped samples)
+void MJBlockerSinglePassEstimator(int64_t n, int ndim, const double x[], double average[], double error[]);
+
+// Estimators for the data x of a CompressedFullAccumulator, which decode the samples chunk by chunk in a single pass
+// (i.e. only O(CompressedSampleReader::CHUNK_SIZE) extra memory, same results as on the decoded samples up to rounding)
+void CompressedUncorrelatedEstimator(int64_t nstore, int ndim, const double x[], double average[], double error[]);
+void CompressedMJBlockerEstimator(int64_t nstore, int ndim, const double x[], double average[], double error[]);
+
+// Uncorrelated estimate from the running moments of block averages, i.e. x must be the data of a CovarianceAccumulator
+void CovarianceEstimator(int64_t nstore, int ndim, const double x[], double average[], double error[]);
+
+// Computes the normalized autocorrelation function by FFT and the integrated autocorrelation time
+// tau[j] = 1 + 2*sum_t rho_j(t), where the sum is cut off by Sokal's automatic window (t >= 5*tau).
+// The error is the uncorrelated one times sqrt(tau) and ess[j] = n/tau[j] is the effective sample size.
+void AutocorrelationAnalysis(int64_t n, int ndim, const double x[], double average[], double error[],
+                             double tau[] /*may be nullptr*/, double ess[] /*may be nullptr*/);
+void AutocorrelationAnalysis(int64_t n, int ndim, const double x[], double average[], double error[],
+                             double tau[] /*may be nullptr*/, double ess[] /*may be nullptr*/, EstimatorWorkspace &ws);
+void AutocorrelationEstimator(int64_t n, int ndim, const double x[], double average[], double error[]); // without tau/ess
+void AutocorrelationEstimator(int64_t n, int ndim, const double x[], double average[], double error[], EstimatorWorkspace &ws);
 
 // no-op estimator (used when data contains the averages already and error is irrelevant)
 void NoopEstimator(int64_t/*n*/, int ndim, const double x[], double average[], double error[]);
@@ -2,9 +2,14 @@
 #define MCI_FACTORIES_HPP
 
 #include "mci/AccumulatorInterface.hpp"
+#include "mci/BinningAccumulator.hpp"
 #include "mci/BlockAccumulator.hpp"
+#include "mci/CompressedFullAccumulator.hpp"
+#include "mci/CovarianceAccumulator.hpp"
 #include "mci/FullAccumulator.hpp"
+#include "mci/MappedFullAccumulator.hpp"
 #include "mci/SimpleAccumulator.hpp"
+#include "mci/StreamBlockAccumulator.hpp"
 
 #include "mci/Estimators.hpp"
 
@@ -13,11 +18,17 @@
 #include "mci/SRRDVecMove.hpp"
 #include "mci/TrialMoveInterface.hpp"
 
+#include "mci/MT19937Engine.hpp"
+#include "mci/PhiloxEngine.hpp"
+#include "mci/RandomEngineInterface.hpp"
+#include "mci/XoshiroEngine.hpp"
+
 #include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <stdexcept>
+#include <string>
 
 // All factory functions go here
 
@@ -53,9 +64,12 @@ enum class EstimatorType
 {
     Noop,
     Uncorrelated,
-    Correlated, /* uses MJBlocker, if ndata power of 2, and else FCBlocker */
+    Correlated, /* the default for correlated data (currently MJBlocker) */
     FCBlocker, /* Francesco's auto blocker implementation */
-    MJBlocker /* Our implementation of Marius Jonsson's auto blocking */
+    MJBlocker, /* Our implementation of Marius Jonsson's auto blocking */
+    StreamMJBlocker, /* Marius Jonsson's auto blocking on the fly (requires StreamBlockAccumulator, blocksize is ignored) */
+    Autocorrelation, /* error from the integrated autocorrelation time (FFT based), which is also made available together with ESS */
+    Covariance /* uncorrelated error of block averages, which also provides the covariance matrix (requires CovarianceAccumulator) */
 };
 
 inline EstimatorType selectEstimatorType(const bool flag_correlated, const bool flag_error = true)
@@ -70,6 +84,10 @@ inline EstimatorType selectEstimatorType(const bool flag_correlated, const bool
     return flag_error ? EstimatorType::Uncorrelated : EstimatorType::Noop;
 }
 
+// plain estimator functions (explicit type, because some are overloaded with a workspace version)
+using EstimatorFunction = void (*)(int64_t/*nstore*/, int/*nobs*/, const double[]/*data*/, double[]/*avg*/, double[]/*error*/);
+using InPlaceEstimatorFunction = void (*)(int64_t/*nstore*/, int/*nobs*/, double[]/*data*/, double[]/*avg*/, double[]/*error*/);
+
 inline std::function<void(int64_t/*nstore*/, int/*nobs*/, const double[]/*data*/, double[]/*avg*/, double[]/*error*/)>
 createEstimator(EstimatorType estimType /*from Estimators enumeration*/)
 {
@@ -81,25 +99,199 @@ createEstimator(EstimatorType estimType /*from Estimators enumeration*/)
         return UncorrelatedEstimator;
 
     case EstimatorType::Correlated:
-        return CorrelatedEstimator;
+        return static_cast<EstimatorFunction>(CorrelatedEstimator);
 
     case EstimatorType::FCBlocker:
-        return FCBlockerEstimator;
+        return static_cast<EstimatorFunction>(FCBlockerEstimator);
 
     case EstimatorType::MJBlocker:
-        return MJBlockerEstimator;
+        return static_cast<EstimatorFunction>(MJBlockerEstimator);
+
+    case EstimatorType::StreamMJBlocker:
+        return StreamMJBlockerEstimator;
+
+    case EstimatorType::Autocorrelation:
+        return static_cast<EstimatorFunction>(AutocorrelationEstimator);
+
+    case EstimatorType::Covariance:
+        return CovarianceEstimator;
 
     default:
         throw std::domain_error("[createEstimator] Unhandled estimator enumerator.");
     }
 }
 
+// create a workspace for the estimator of an observable with nobs dimensions (pre-allocated where possible)
+inline std::shared_ptr<EstimatorWorkspace> createEstimatorWorkspace(EstimatorType estimType, int nobs)
+{
+    auto ws = std::make_shared<EstimatorWorkspace>();
+    if (estimType == EstimatorType::FCBlocker) { ws->reserveFCBlocker(nobs); }
+    return ws;
+}
+
+// create an estimator which keeps its scratch memory in the passed workspace, i.e. repeated calls don't allocate
+// NOTE: The workspace is shared by copies of the returned function, so these must not be called concurrently.
+inline std::function<void(int64_t/*nstore*/, int/*nobs*/, const double[]/*data*/, double[]/*avg*/, double[]/*error*/)>
+createEstimator(EstimatorType estimType, const std::shared_ptr<EstimatorWorkspace> &ws)
+{
+    switch (estimType) {
+    case EstimatorType::Correlated:
+        return [ws](int64_t n, int ndim, const double x[], double avg[], double err[]) { CorrelatedEstimator(n, ndim, x, avg, err, *ws); };
+
+    case EstimatorType::FCBlocker:
+        return [ws](int64_t n, int ndim, const double x[], double avg[], double err[]) { FCBlockerEstimator(n, ndim, x, avg, err, *ws); };
+
+    case EstimatorType::MJBlocker:
+        return [ws](int64_t n, int ndim, const double x[], double avg[], double err[]) { MJBlockerEstimator(n, ndim, x, avg, err, *ws); };
+
+    case EstimatorType::Autocorrelation:
+        return [ws](int64_t n, int ndim, const double x[], double avg[], double err[]) { AutocorrelationEstimator(n, ndim, x, avg, err, *ws); };
+
+    default:
+        return createEstimator(estimType); // needs no scratch memory
+    }
+}
+
 inline std::function<void(int64_t, int, const double[], double[], double[])> createEstimator(const bool flag_correlated,
                                                                                              const bool flag_error = true)
 {
     return createEstimator(selectEstimatorType(flag_correlated, flag_error));
 }
 
+// create the in-place version of an estimator, which may overwrite the data (empty function if there is none)
+inline std::function<void(int64_t/*nstore*/, int/*nobs*/, double[]/*data*/, double[]/*avg*/, double[]/*error*/)>
+createInPlaceEstimator(EstimatorType estimType /*from Estimators enumeration*/)
+{
+    switch (estimType) {
+    case EstimatorType::Correlated:
+        return static_cast<InPlaceEstimatorFunction>(CorrelatedEstimatorInPlace);
+
+    case EstimatorType::MJBlocker:
+        return static_cast<InPlaceEstimatorFunction>(MJBlockerEstimatorInPlace);
+
+    default:
+        return nullptr;
+    }
+}
+
+// same, with workspace (see above)
+inline std::function<void(int64_t/*nstore*/, int/*nobs*/, double[]/*data*/, double[]/*avg*/, double[]/*error*/)>
+createInPlaceEstimator(EstimatorType estimType, const std::shared_ptr<EstimatorWorkspace> &ws)
+{
+    switch (estimType) {
+    case EstimatorType::Correlated:
+        return [ws](int64_t n, int ndim, double x[], double avg[], double err[]) { CorrelatedEstimatorInPlace(n, ndim, x, avg, err, *ws); };
+
+    case EstimatorType::MJBlocker:
+        return [ws](int64_t n, int ndim, double x[], double avg[], double err[]) { MJBlockerEstimatorInPlace(n, ndim, x, avg, err, *ws); };
+
+    default:
+        return nullptr;
+    }
+}
+
+// create an estimator for column-major data, i.e. [nobs][nstore] layout (see FullAccumulator/BlockAccumulator),
+// which estimates every observable dimension on its contiguous column (without transposing the data)
+// NOTE: StreamMJBlocker and Covariance work only on their specific (row-major) accumulator data.
+inline std::function<void(int64_t/*nstore*/, int/*nobs*/, const double[]/*data*/, double[]/*avg*/, double[]/*error*/)>
+createColumnMajorEstimator(EstimatorType estimType, const std::shared_ptr<EstimatorWorkspace> &ws)
+{
+    switch (estimType) {
+    case EstimatorType::Uncorrelated:
+        return ColumnMajorUncorrelatedEstimator;
+
+    case EstimatorType::StreamMJBlocker:
+    case EstimatorType::Covariance:
+        throw std::invalid_argument("[createColumnMajorEstimator] Requested estimator type doesn't support column-major data.");
+
+    default:
+        return [estimator = createEstimator(estimType, ws)](int64_t n, int ndim, const double x[], double avg[], double err[])
+        {
+            for (int j = 0; j < ndim; ++j) { estimator(n, 1, x + j*n, avg + j, err + j); }
+        };
+    }
+}
+
+// same, without shared workspace (i.e. copies of the returned function may be called concurrently)
+inline std::function<void(int64_t/*nstore*/, int/*nobs*/, const double[]/*data*/, double[]/*avg*/, double[]/*error*/)>
+createColumnMajorEstimator(EstimatorType estimType)
+{
+    switch (estimType) {
+    case EstimatorType::Uncorrelated:
+        return ColumnMajorUncorrelatedEstimator;
+
+    case EstimatorType::StreamMJBlocker:
+    case EstimatorType::Covariance:
+        throw std::invalid_argument("[createColumnMajorEstimator] Requested estimator type doesn't support column-major data.");
+
+    default:
+        return [estimator = createEstimator(estimType)](int64_t n, int ndim, const double x[], double avg[], double err[])
+        {
+            for (int j = 0; j < ndim; ++j) { estimator(n, 1, x + j*n, avg + j, err + j); }
+        };
+    }
+}
+
+// in-place version of the above (empty function if there is none)
+inline std::function<void(int64_t/*nstore*/, int/*nobs*/, double[]/*data*/, double[]/*avg*/, double[]/*error*/)>
+createColumnMajorInPlaceEstimator(EstimatorType estimType, const std::shared_ptr<EstimatorWorkspace> &ws)
+{
+    auto estimator = createInPlaceEstimator(estimType, ws);
+    if (!estimator) { return nullptr; }
+    return [estimator](int64_t n, int ndim, double x[], double avg[], double err[])
+    {
+        for (int j = 0; j < ndim; ++j) { estimator(n, 1, x + j*n, avg + j, err + j); }
+    };
+}
+
+// optional settings on how to store the samples/blocks
+struct SampleStorage
+{
+    bool flag_compress{}; // store the samples compressed in memory (CompressedFullAccumulator)
+    std::string mapfile{}; // if not empty, store the samples in this memory-mapped file (MappedFullAccumulator)
+    bool flag_keepfile{true}; // keep the mapped file after deallocation
+    bool flag_hugepages{}; // advise huge pages for the mapping
+    bool flag_colmajor{}; // store Full/Block data column-major, i.e. [nobs][nstore] layout (see FullAccumulator)
+};
+
+// create the accumulator to be paired with an estimator (some estimators work only on a specific accumulator)
+// If nbins > 0, a BinningAccumulator with nbins bins is used instead of fixed-size blocks (blocksize is ignored).
+// With blocksize 1, the storage settings may select a CompressedFullAccumulator or MappedFullAccumulator instead of the FullAccumulator.
+// Column-major storage is supported only by Full/Block/SimpleAccumulator (the latter stores a single row anyway).
+inline std::unique_ptr<AccumulatorInterface> createAccumulator(ObservableFunctionInterface &obs, int blocksize, int nskip,
+                                                               EstimatorType estimType, int nbins = 0, const SampleStorage &storage = SampleStorage())
+{
+    if (storage.flag_colmajor) {
+        if (estimType == EstimatorType::StreamMJBlocker || estimType == EstimatorType::Covariance || nbins > 0
+            || storage.flag_compress || !storage.mapfile.empty()) {
+            throw std::invalid_argument("[createAccumulator] Column-major storage is only available for Full, Block and Simple accumulators.");
+        }
+        if (blocksize == 1) {
+            return std::unique_ptr<AccumulatorInterface>(new FullAccumulator(obs, std::max(1, nskip), true));
+        }
+        if (blocksize > 1) {
+            return std::unique_ptr<AccumulatorInterface>(new BlockAccumulator(obs, std::max(1, nskip), blocksize, true));
+        }
+    }
+    if (estimType == EstimatorType::StreamMJBlocker) {
+        return std::unique_ptr<AccumulatorInterface>(new StreamBlockAccumulator(obs, std::max(1, nskip)));
+    }
+    if (estimType == EstimatorType::Covariance) {
+        return std::unique_ptr<AccumulatorInterface>(new CovarianceAccumulator(obs, std::max(1, nskip), std::max(1, blocksize)));
+    }
+    if (nbins > 0) {
+        return std::unique_ptr<AccumulatorInterface>(new BinningAccumulator(obs, std::max(1, nskip), nbins));
+    }
+    if (blocksize == 1 && !storage.mapfile.empty()) {
+        return std::unique_ptr<AccumulatorInterface>(new MappedFullAccumulator(obs, std::max(1, nskip), storage.mapfile,
+                                                                               storage.flag_keepfile, storage.flag_hugepages));
+    }
+    if (blocksize == 1 && storage.flag_compress) {
+        return std::unique_ptr<AccumulatorInterface>(new CompressedFullAccumulator(obs, std::max(1, nskip)));
+    }
+    return createAccumulator(obs, blocksize, nskip);
+}
+
 
 
 // --- Create Trial Moves
@@ -241,6 +433,35 @@ inline std::unique_ptr<TrialMoveInterface> createMoveDefault(MoveType mtype, int
         throw std::domain_error("[createMoveDefault] Unhandled MoveType enumerator.");
     }
 }
+
+
+// --- Create Random Engines
+
+// Enumeration of builtin random engines
+enum class RNGType
+{
+    MT19937_64, /* std::mt19937_64, the default (no jump-ahead) */
+    Xoshiro256pp, /* xoshiro256++ (jump-ahead, O(log n) discard) */
+    Philox4x64 /* counter-based Philox4x64-10 (jump-ahead, O(1) discard) */
+};
+static constexpr std::initializer_list<RNGType> list_all_RNGType = {RNGType::MT19937_64,
+                                                                    RNGType::Xoshiro256pp,
+                                                                    RNGType::Philox4x64};
+
+inline std::unique_ptr<RandomEngineInterface> createRandomEngine(RNGType rngtype, uint64_t seed)
+{
+    switch (rngtype) {
+    case (RNGType::MT19937_64):
+        return std::unique_ptr<RandomEngineInterface>(new MT19937Engine(seed));
+    case (RNGType::Xoshiro256pp):
+        return std::unique_ptr<RandomEngineInterface>(new XoshiroEngine(seed));
+    case (RNGType::Philox4x64):
+        return std::unique_ptr<RandomEngineInterface>(new PhiloxEngine(seed));
+
+    default:
+        throw std::domain_error("[createRandomEngine] Unhandled RNGType enumerator.");
+    }
+}
 } // namespace mci
 
 #endif
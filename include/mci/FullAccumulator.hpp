@@ -12,11 +12,17 @@ namespace mci
 // or SimpleAccumulator (if no error is required) instead, because the memory requirements
 // of the FullAccumulator may become very large with a large number of MC steps.
 //
+// NOTE 2: Optionally, the samples are stored column-major, i.e. in [nobs][nstore] layout, so that every
+// observable dimension is contiguous in memory. This suits estimators which process one dimension at a time
+// (see createColumnMajorEstimator in Factories.hpp) and large nobs. Data passed to merge must have the same layout.
+//
 class FullAccumulator final: public AccumulatorInterface
 {
 protected:
     int64_t _nstore; // number of allocated storage elements with _nobs length each
-    int64_t _storeidx; // storage index offset for next write
+    int64_t _ncapacity; // number of elements _data has room for (>= _nstore after reserveMerge)
+    int64_t _storeidx; // storage index offset for next write (column-major: index of next sample)
+    const bool _flag_colmajor; // store samples in [nobs][nstore] layout?
 
     // --- storage method to be implemented
     void _allocate() final;
@@ -24,13 +30,19 @@ protected:
     void _finalize() final {} // nothing to do
     void _reset() final;
     void _deallocate() final;
+    void _merge(int64_t nstore, int64_t naccu, const double data[]) final;
+    void _reserveMerge(int64_t nstore) final;
+    void _saveState(std::ostream &out) const final;
+    void _loadState(std::istream &in) final;
 
 public:
-    FullAccumulator(ObservableFunctionInterface &obs, int nskip):
-            AccumulatorInterface(obs, nskip), _nstore(0), _storeidx(0) {}
+    FullAccumulator(ObservableFunctionInterface &obs, int nskip, bool flag_colmajor = false):
+            AccumulatorInterface(obs, nskip), _nstore(0), _ncapacity(0), _storeidx(0), _flag_colmajor(flag_colmajor) {}
 
     ~FullAccumulator() final { this->_deallocate(); }
 
+    bool isColumnMajor() const { return _flag_colmajor; }
+    bool isChunkMergeable() const final { return !_flag_colmajor; } // columns can't be appended in pieces
     int64_t getNStore() const final { return _nstore; }
 };
 }  // namespace mci
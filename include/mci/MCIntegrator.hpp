@@ -6,8 +6,12 @@
 #include "mci/Factories.hpp"
 #include "mci/ObservableContainer.hpp"
 #include "mci/ObservableFunctionInterface.hpp"
+#include "mci/RandomEngineInterface.hpp"
+#include "mci/RandomGenerator.hpp"
+#include "mci/Resampling.hpp"
 #include "mci/SamplingFunctionContainer.hpp"
 #include "mci/SamplingFunctionInterface.hpp"
+#include "mci/TraceFile.hpp"
 #include "mci/TrialMoveInterface.hpp"
 #include "mci/WalkerState.hpp"
 
@@ -19,6 +23,16 @@
 #include <string>
 #include <vector>
 
+#if USE_MPI == 1
+namespace mci { class MCI; }
+namespace MPIMCI
+{
+// forward declaration, because it needs access to MCI internals (see MPIMCI.hpp)
+void integrate(mci::MCI &mci, int64_t Nmc, double average[], double error[], bool doFindMRT2Step, bool doDecorrelation, bool flag_pool);
+void resume(mci::MCI &mci, const std::string &filepath, double average[], double error[], bool flag_pool);
+} // namespace MPIMCI
+#endif
+
 namespace mci
 {
 // Main class of the MCI library
@@ -30,8 +44,7 @@ private:
 
     // Random
     std::random_device _rdev;
-    std::mt19937_64 _rgen;
-    std::uniform_real_distribution<double> _rd; // used to decide on acceptance (and for full random moves)
+    RandomGenerator _rgen; // buffered generator with exchangeable engine (init: MT19937_64), also used for acceptance and random moves
 
     // Main objects/vectors/containers
     WalkerState _wlkstate; // holds the current walker state (xold/xnew), including move information
@@ -41,22 +54,45 @@ private:
     ObservableContainer _obscont; // observable container used during integration (init: empty)
     std::function<void(const MCI &)> _cback{}; // callback function (see setCallback() below)
 
+    // Derived quantities (see addDerivedQuantity() below)
+    std::vector<DerivedFunction> _derivedFuncs; // functions of the observable averages
+    std::vector<int> _derivedNOut; // number of values per function
+    std::vector<double> _derivedValue, _derivedError; // results of the last integration
+    ResamplingType _resamplingType{ResamplingType::Jackknife};
+    int _NresamplingGroups{100}; // number of groups to split the block data into
+    int _Nresamples{1000}; // number of bootstrap resamples
+    uint64_t _resamplingSeed{}; // key of the bootstrap draws (derived on setSeed, so resampling doesn't consume random numbers of _rgen)
+
     // Settings
     int _NfindMRT2Iterations; // how many MRT2 step adjustment iterations to do before integrating
     int64_t _NdecorrelationSteps; // how many decorrelation steps to do before integrating
     double _targetaccrate; // desired acceptance ratio
+    int _NestimatorThreads; // number of threads used to evaluate the estimators after sampling
 
     // File-I/O parameters:
     // observables
     std::ofstream _obsfile; //ofstream for storing obs values while sampling
+    std::unique_ptr<TraceWriter> _obstrace; // used instead of _obsfile for binary formats
+    std::vector<double> _obstracebuf; // gathered obs values for _obstrace
     std::string _pathobsfile;
     int _freqobsfile{};
+    TraceFormat _formatobsfile{};
     bool _flagobsfile; // should write an output file with sampled obs values?
     // walkers
     std::ofstream _wlkfile; //ofstream for storing obs values while sampling
+    std::unique_ptr<TraceWriter> _wlktrace; // used instead of _wlkfile for binary formats
     std::string _pathwlkfile;
     int _freqwlkfile{};
+    TraceFormat _formatwlkfile{};
     bool _flagwlkfile; // should write an output file with sampled obs values?
+    // checkpoints
+    std::string _pathchkfile;
+    int64_t _freqchkfile{};
+    bool _flagchkfile{}; // should write checkpoints while sampling?
+    // warm-start store
+    std::string _warmdir;
+    std::string _warmtag;
+    bool _flagwarm{}; // should load/save the warm-start entry?
 
     // internal counters
     // NOTE: All integers are int, except if they are directly counting MC steps (int64_t then)
@@ -64,6 +100,9 @@ private:
     int64_t _acc, _rej; // internal counters
     int64_t _ridx; // running index, which keeps track of the number of MC steps
 
+    // parallel
+    bool _flagworker; // are we a worker of integrateParallel() ? (then we never sync via MPI)
+
 
     // --- Internal methods
 
@@ -83,11 +122,54 @@ private:
     void sample(int64_t npoints);
     // fill data with samples and do things like file output, if flagMC (i.e. main sampling)
     void sample(int64_t npoints, ObservableContainer &container, bool flagMC);
+    // the main loop of the above, continuing from step _ridx (flag_callbackPDF: was the PDF accepted since the last observation?)
+    void continueSample(int64_t npoints, ObservableContainer &container, bool flagFiles, bool flagCheckpoint, bool flag_callbackPDF);
+
+    // main sampling of integrate: allocate observables and sample them (with file output if flagFiles)
+    void sampleObservables(int64_t Nmc, bool flagFiles);
+    // like sample, but the walker takes the next Nmc positions from reader (see replay())
+    void replayObservables(TraceReader &reader, int64_t Nmc);
+    // load the checkpoint at filepath and continue the main sampling (see resume())
+    void resumeObservables(const std::string &filepath);
+    // estimate the sampled observables, apply volume factor and deallocate
+    void estimateObservables(double average[], double error[]);
+    // estimate the derived quantities by resampling the accumulated data (before estimateObservables)
+    void estimateDerived();
+    // check that the accumulated data is suited for the derived quantities (else throw) and return the number of blocks
+    int64_t checkDerived() const;
+
+    // create a new MCI with cloned objects and settings, to be used as walker in integrateParallel
+    std::unique_ptr<MCI> createWorker(int iworker /*index, e.g. for file names*/);
+
+    // checks and adds observable to the container (used by the public add methods)
+    void addObservableElement(std::unique_ptr<ObservableFunctionInterface> obs, int blocksize, int nskip, bool flag_equil,
+                              EstimatorType estimType, int nbins, const SampleStorage &storage = SampleStorage());
+
+#if USE_MPI == 1
+    // like integrate, but the results of all ranks are combined (used by MPIMCI::integrate)
+    void integrateMPI(int64_t Nmc, double average[], double error[], bool doFindMRT2step, bool doDecorrelation, bool flag_pool);
+    // every rank estimates its own data and the results are averaged, or if flag_pool,
+    // the data of all ranks is merged on root, estimated there and the results are broadcasted
+    void estimateObservablesMPI(double average[], double error[], bool flag_pool);
+    // send the accumulated data to root, which merges it in rank order (used for flag_pool above)
+    void mergeObservablesMPI();
+
+    friend void MPIMCI::integrate(MCI &mci, int64_t Nmc, double average[], double error[], bool doFindMRT2Step, bool doDecorrelation, bool flag_pool);
+    friend void MPIMCI::resume(MCI &mci, const std::string &filepath, double average[], double error[], bool flag_pool);
+#endif
 
 
     // store to file
     void storeObservables();
     void storeWalkerPositions();
+    std::string getRankFilePath(const std::string &filepath) const; // file path of this process (per-rank with MPI)
+    void storeCheckpoint(int64_t npoints, bool flag_callbackPDF); // write the state after step _ridx of npoints
+
+    // warm-start store (see setWarmStart())
+    std::string getWarmStartPath() const;
+    bool loadWarmStart(bool flag_steps, bool flag_walker); // apply the stored step sizes/walker, returns false if there is no matching entry
+    bool isWarmedUp(bool doFindMRT2step, bool doDecorrelation, bool flag_loaded) const; // were step sizes and walker calibrated (or loaded)?
+    void storeWarmStart(); // save the current step sizes and walker position (only after a complete warm-up, see isWarmedUp)
 
 public:
     explicit MCI(int ndim);  //Constructor, need the number of dimensions
@@ -95,7 +177,13 @@ public:
 
     // --- Setters
 
-    void setSeed(uint_fast64_t seed); // seed internal random number generator
+    // seed internal random number generator, optionally selecting one of many independent streams
+    // (stream > 0 requires an engine with independent streams, the stream is selected via longJump(stream))
+    void setSeed(uint_fast64_t seed, uint64_t stream = 0);
+
+    // - choose random engine (previous engine state is lost, so set the seed afterwards)
+    void setRandomEngine(RNGType rngtype /*enum, see Factories.hpp*/); // use builtin engine (randomly seeded)
+    void setRandomEngine(std::unique_ptr<RandomEngineInterface> engine); // use custom engine (as passed)
 
     // - manipulate initial position
     void setX(int i, double val);
@@ -121,6 +209,9 @@ public:
     {
         _NdecorrelationSteps = nsteps;
     }
+    // how many threads to use for the estimation after sampling (1 -> serial, < 1 -> all hardware threads)
+    // Observables are estimated concurrently and large observables (e.g. histograms) are split into tiles of columns.
+    void setEstimatorThreads(int nthreads) { _NestimatorThreads = nthreads; }
 
 
     // --- Adding objects to MCI
@@ -173,9 +264,66 @@ public:
         this->addObservable(obs.clone(), blocksize, nskip, flag_equil, estimType);
     }
 
+    // add observable with fixed-memory binning accumulator, i.e. nbins block averages with a block size adapting to the run length
+    // NOTE: Blocking estimators work on the nbins/2 to nbins final bins, i.e. choose nbins large enough (e.g. >= 128 for FCBlocker)
+    void addBinnedObservable(std::unique_ptr<ObservableFunctionInterface> obs, int nbins /*even*/, int nskip = 1, bool flag_equil = true,
+                             EstimatorType estimType = EstimatorType::Uncorrelated);
+    void addBinnedObservable(const ObservableFunctionInterface &obs, int nbins, int nskip = 1, bool flag_equil = true,
+                             EstimatorType estimType = EstimatorType::Uncorrelated)
+    {
+        this->addBinnedObservable(obs.clone(), nbins, nskip, flag_equil, estimType);
+    }
+
+    // add observable which stores every sample like blocksize 1, but compressed (CompressedFullAccumulator), i.e. repeated samples
+    // of rejected steps need hardly any memory. On estimation, the samples get decoded chunk by chunk into a single pass estimator,
+    // so only the Uncorrelated and Correlated/MJBlocker estimators are supported (others throw invalid_argument).
+    void addCompressedObservable(std::unique_ptr<ObservableFunctionInterface> obs, int nskip = 1, bool flag_equil = true,
+                                 EstimatorType estimType = EstimatorType::Correlated);
+    void addCompressedObservable(const ObservableFunctionInterface &obs, int nskip = 1, bool flag_equil = true,
+                                 EstimatorType estimType = EstimatorType::Correlated)
+    {
+        this->addCompressedObservable(obs.clone(), nskip, flag_equil, estimType);
+    }
+
+    // add observable which stores every sample like blocksize 1, but in the memory-mapped file filepath (MappedFullAccumulator),
+    // i.e. the run length is limited by disk space instead of RAM and the raw samples ([nsteps/nskip][nobs] doubles) remain in the file.
+    // Prefer the Correlated/MJBlocker (evaluated in a single pass over the file) or Uncorrelated estimators for runs which exceed RAM.
+    // NOTE: On parallel integration, the workers use temporary files next to filepath. With MPI, the ranks other than root
+    //       keep their samples in filepath + ".rank<r>". When pooling (see MPIMCI::integrate), root streams their data into its file.
+    void addMappedObservable(std::unique_ptr<ObservableFunctionInterface> obs, const std::string &filepath, int nskip = 1, bool flag_equil = true,
+                             EstimatorType estimType = EstimatorType::Correlated, bool flag_hugepages = false);
+    void addMappedObservable(const ObservableFunctionInterface &obs, const std::string &filepath, int nskip = 1, bool flag_equil = true,
+                             EstimatorType estimType = EstimatorType::Correlated, bool flag_hugepages = false)
+    {
+        this->addMappedObservable(obs.clone(), filepath, nskip, flag_equil, estimType, flag_hugepages);
+    }
+
+    // add observable like above (blocksize > 0), but store the samples/blocks column-major, i.e. every observable dimension contiguous in memory.
+    // Every dimension is then estimated on its own column (without transposing), which suits large observables and parallel estimation.
+    // NOTE: Not available for the estimators with their own accumulator (StreamMJBlocker and Covariance).
+    void addColumnMajorObservable(std::unique_ptr<ObservableFunctionInterface> obs, int blocksize = 1, int nskip = 1, bool flag_equil = true,
+                                  EstimatorType estimType = EstimatorType::Correlated);
+    void addColumnMajorObservable(const ObservableFunctionInterface &obs, int blocksize = 1, int nskip = 1, bool flag_equil = true,
+                                  EstimatorType estimType = EstimatorType::Correlated)
+    {
+        this->addColumnMajorObservable(obs.clone(), blocksize, nskip, flag_equil, estimType);
+    }
+
     std::unique_ptr<ObservableFunctionInterface> popObservable(); // remove last observable (returns it for you to optionally take it back)
     void clearObservables() { _obscont.clear(); } // delete all observables
 
+    // Derived quantities, i.e. nonlinear functions of the observable averages (e.g. <A>/<B>), with errors by resampling.
+    // After every integration, f is evaluated on jackknife/bootstrap resamples of the block data of all observables,
+    // i.e. f gets the averages of all observables (in order of adding, length getNObsDim()) and writes nout values.
+    // NOTE: All observables must store block averages of equal layout, i.e. use Full/Block/Binning accumulators
+    //       with the same number of stored blocks for the same steps (e.g. equal blocksize and nskip).
+    void addDerivedQuantity(const DerivedFunction &f, int nout = 1);
+    void clearDerivedQuantities();
+    // choose the resampling method (see Resampling.hpp), the number of groups the blocks are split into
+    // (they should be uncorrelated) and the number of bootstrap resamples (the jackknife uses ngroups)
+    // NOTE: The bootstrap draws are keyed by the seed passed to setSeed, i.e. they don't advance the sampling random stream.
+    void setResampling(ResamplingType type, int ngroups = 100, int nresamples = 1000);
+
 
     // Sampling Functions
     void addSamplingFunction(std::unique_ptr<SamplingFunctionInterface> pdf);
@@ -190,14 +338,40 @@ public:
     void clearCallback() { _cback = nullptr; } // set empty callback
 
     // enable file printout to given files, with frequency freq
-    void storeObservablesOnFile(const std::string &filepath, int freq);
+    // With the binary formats, the records are written by a background thread and can be read with TraceReader (see TraceFile.hpp).
+    void storeObservablesOnFile(const std::string &filepath, int freq, TraceFormat format = TraceFormat::Text);
     void clearObservableFile();
-    void storeWalkerPositionsOnFile(const std::string &filepath, int freq);
+    void storeWalkerPositionsOnFile(const std::string &filepath, int freq, TraceFormat format = TraceFormat::Text);
     void clearWalkerFile();
 
+    // enable checkpointing of the main sampling of integrate (i.e. not of the step size calibration and decorrelation) every freq MC steps.
+    // A checkpoint holds the complete sampling state (walker, random generator, trial move, sampling functions and accumulators) and is
+    // written atomically (via filepath + ".tmp"). If the run gets interrupted, resume() continues it bit-identically from the last checkpoint.
+    // NOTE 1: With MPI, the ranks other than root write to filepath + ".rank<r>", i.e. every rank checkpoints its own state.
+    // NOTE 2: The random engine must support checkpointing (all builtin ones do). Own sampling functions and moves which have state
+    //         beyond their proto values need to implement _saveState/_loadState (see ProtoFunctionInterface.hpp).
+    // NOTE 3: Not supported by integrateParallel.
+    // NOTE 4: Every checkpoint rewrites all data accumulated so far, i.e. with observables which keep every sample (blocksize 1, also compressed)
+    //         the total checkpoint I/O grows like Nmc^2/freq. Choose freq accordingly (e.g. a few checkpoints per run), or use block/streaming
+    //         accumulators. Memory-mapped observables are the exception: their samples are synced to their file and only the position is saved.
+    void setCheckpoint(const std::string &filepath, int64_t freq);
+    void clearCheckpoint();
+
+    // enable the warm-start store in the existing directory storedir, for the configuration (sampling functions, trial move, domain, ...)
+    // identified by tag (letters, digits, '-', '_' and '.'). After sampling, integrate saves the step sizes and the final walker position
+    // to storedir/tag.warm. If a matching entry exists (e.g. of a previous process), integrate takes the step sizes instead of calling
+    // findMRT2Step and the walker position instead of the initial decorrelation, which removes the warm-up of repeated short integrations.
+    // NOTE 1: It is your responsibility to use a new tag when the configuration changes. Only entries with equal dimension, trial move type,
+    //         number of step sizes and target acceptance rate are used, else the warm-up is done and the entry gets replaced.
+    // NOTE 2: With MPI, every rank uses its own entry (ranks other than root append ".rank<r>").
+    // NOTE 3: The entry is only saved if both warm-up phases were requested and done (or loaded), i.e. runs without them don't change it.
+    void setWarmStart(const std::string &storedir, const std::string &tag);
+    void clearWarmStart();
+
     // --- Getters
 
     int getNDim() const { return _ndim; }
+    const RandomEngineInterface &getRandomEngine() const { return _rgen.getEngine(); }
     double getX(int i) const { return _wlkstate.xold[i]; }
     const double * getX() const { return _wlkstate.xold; }
 
@@ -207,6 +381,7 @@ public:
 
     int getNfindMRT2Iterations() const { return _NfindMRT2Iterations; }
     int64_t getNdecorrelationSteps() const { return _NdecorrelationSteps; }
+    int getEstimatorThreads() const { return _NestimatorThreads; }
 
     const DomainInterface &getDomain() const { return *_domain; }
     TrialMoveInterface &getTrialMove() const { return *_trialMove; }
@@ -217,12 +392,47 @@ public:
     ObservableFunctionInterface &getObservable(int i) const { return _obscont.getObservableFunction(i); }
     int getNObs() const { return _obscont.getNObs(); }
     int getNObsDim() const { return _obscont.getNObsDim(); }
+    // integrated autocorrelation times and effective sample sizes (arrays of length nobsdim) from the last integration,
+    // available for observables using EstimatorType::Autocorrelation (else NaN). With MPI, they are those of the own rank
+    // (when pooling, only set on root).
+    void getAutocorrelation(double tau[], double ess[]) const { _obscont.getAutocorrelation(tau, ess); }
+    // covariance matrix of the average of the i-th observable (nobs x nobs, row-major) from the last integration,
+    // available for observables using EstimatorType::Covariance (else NaN). With MPI, it is that of the own rank
+    // (when pooling, only set on root).
+    void getCovariance(int i, double cov[]) const { _obscont.getCovariance(i, cov); }
+    // values and errors of all derived quantities from the last integration (arrays of length getNDerived())
+    int getNDerived() const;
+    void getDerivedResults(double value[], double error[]) const;
 
 
     // --- Integrate
 
     // Actual integrate implemention. With flags to skip the configured step adjustment/decorrelation.
     void integrate(int64_t Nmc, double average[], double error[], bool doFindMRT2step = true, bool doDecorrelation = true);
+
+    // Like integrate, but instead of sampling, the walker takes the positions of a binary walker trace (see storeWalkerPositionsOnFile
+    // and TraceFile.hpp). So observables may be evaluated after the sampling run, at the cost of reading the trace. The trial move is not used
+    // and the sampling functions are only evaluated for observables depending on them. But the results are treated like the ones of
+    // integrate with the current sampling functions, i.e. add the sampling functions of the sampling run (or none, if it was uniform in the domain).
+    // The first Nmc records are used (Nmc < 0: all). Regular files are memory-mapped, while others (e.g. named pipes, to let another process
+    // stream in the positions) are read until Nmc records are complete, so they require Nmc >= 0.
+    // NOTE: Afterwards, the walker is at the last replayed position. File output, MPI and parallel workers are not used.
+    void replay(const std::string &tracepath, double average[], double error[], int64_t Nmc = -1);
+
+    // Continue an interrupted integrate from the checkpoint at filepath (see setCheckpoint) and return its results, as if the run
+    // had not been interrupted. MCI has to be set up like for the interrupted run, i.e. same dimension, random engine type, trial move
+    // type, sampling functions and observables (in the same order). Step sizes, walker position and random state are taken from the checkpoint.
+    // NOTE: File output is not resumed, but checkpoints continue to be written if enabled. With MPI, use MPIMCI::resume.
+    void resume(const std::string &filepath, double average[], double error[]);
+
+    // Shared-memory parallel version of integrate, using nthreads walkers (nthreads < 1 -> use all hardware threads).
+    // Every thread samples its own walker with cloned sampling functions, trial move and observables and
+    // its own random generator (independent streams via jump-ahead if supported, else seeded from ours). The Nmc steps are split evenly among the walkers and the
+    // accumulated data is merged before the estimation, i.e. the errors are computed from all samples.
+    // NOTE 1: The step size is calibrated once, before cloning. Decorrelation is done by every walker.
+    // NOTE 2: The callback and file output are only used for the walker of the calling thread.
+    // NOTE 3: Fixed-block accumulation requires every walker's share of Nmc to be a multiple of blocksize*nskip.
+    void integrateParallel(int64_t Nmc, int nthreads, double average[], double error[], bool doFindMRT2step = true, bool doDecorrelation = true);
 };
 }  // namespace mci
 
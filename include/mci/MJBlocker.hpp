@@ -16,52 +16,64 @@ class MJBlocker
     // processing multi-dimensional data in one pass, with data passed as a flat C-style array. The data array
     // is expected to consist of ndata blocks of ndim doubles, just like what is produced by MCI observables.
     //
-    // NOTE 1: Just like the original, this algorithm requires the number of samples, ndata, to be a power of 2.
+    // NOTE 1: Unlike the original, this algorithm does not require the number of samples, ndata, to be a power of 2.
+    //         On every level with an odd number of samples, the last one is not passed on by the blocking transform
+    //         (but included in the statistics of its level), and the variances are computed around the level means.
     // NOTE 2: All required intermediate arrays are allocated to const pointers on object creation and the memory
     //         is not freed until object deletion. This means that a sequence of data arrays with the same layout
     //         can be processed without any reallocation in between.
+    // NOTE 3: Every blocking level is processed in a single pass, which computes the deviations from the mean on the fly
+    //         and writes the blocked data of the next level. estimate() needs a work array of half the data size, while
+    //         estimateInPlace() works destructively on the passed data and needs no work array (if in_place was set).
     //
 {
 public:
     // --- Public Consts
-    const int64_t ndata; // the number of samples, must be power of 2!
+    const int64_t ndata; // the number of samples (at least 2)
     const int ndim; // number of dimensions per sample
-    const int npow; // number of powers of 2 to go through
+    const int npow; // number of blocking levels to go through, i.e. floor(log2(ndata))
+    const bool inPlace; // only estimateInPlace() is allowed (no work array allocated)
 
 private:
     // --- Internals
 
-    // arrays storing variations of input x (length ndata*ndim)
-    double * const _x; // first copy of input x
-    double * const _X; // second copy of input x
+    // work array for the blocked data (length ndata/2*ndim, nullptr if inPlace)
+    double * const _x;
 
     // smaller helper arrays to be pre-allocated (length npow*ndim)
-    double * const _var; // for results of _gamma0() (variance)
-    double * const _gamma; // for results of gamma1()
-    double * const _M; // test statistics Mi
-    double * const _Msum; // cumulative sum of test statistics Mi
-
+    double * const _var; // variance (gamma_h(0)) per level
+    double * const _gamma; // lag-1 covariance (gamma_h(1)) per level
+    int64_t * const _nred; // number of samples on each blocking level (length npow)
+    double * const _prev; // last deviation of the previous pair (length ndim)
+    double * const _mean; // mean of the current level (length ndim)
+    double * const _sumred; // sum of the blocked data written for the next level (length ndim)
 
     // Init
-    void _computeMean(double mean[]) const; // compute multi-dimensional mean of input x
-    void _initX(const double mean[]); // set internal _X = x - mean
+    void _computeMean(const double x[], double mean[]) const; // compute multi-dimensional mean of input x
 
-    // Operations involving the copied data
-    void _gamma0(double var[]/*part of _var*/, int64_t nred); // compute variance (gamma_h(0))
-    void _gamma1(double gamma[]/*part of _gamma*/, int64_t nred); // compute gamma_h(1)
-    int64_t _transform(const double mean[], int64_t nred); // perform blocking transform on _x and _X, return nred/2
+    // compute _var/_gamma of level k from data in x (length nred*ndim) and write the blocked data to xred (may be x)
+    // mean is the mean of x on input and is set to the mean of xred on output
+    void _processLevel(int k, double mean[], const double x[], double xred[], int64_t nred);
 
-    // Post-Processing
-    void _generateM(); // performs cumulative sum of _M (and store in _M)
+    // run the algorithm on x, using xred as work array (may be x)
+    void _estimate(const double x[], double xred[], double avg[], double err[]);
 
 public:
     // --- User
 
-    MJBlocker(int64_t n_data, int n_dim); // the constructor checks if ndata is power of 2 (else throw)
+    MJBlocker(int64_t n_data, int n_dim, bool in_place = false); // the constructor checks if ndata >= 2 (else throw)
     ~MJBlocker();
 
     // Estimates average and variance of data array x, containing samples with dimension ndim
     void estimate(const double x[], double avg[], double err[]); // arrays have flat layout (ndata*ndim)
+
+    // Same as above, but x gets overwritten in the process (no work array is used)
+    void estimateInPlace(double x[], double avg[], double err[]);
+
+    // Select the blocking level by Jonsson's test statistics, from the variances var[k*stride] and
+    // lag-1 covariances gamma[k*stride] of nlevels blocking levels, with nred[k] samples on level k.
+    // The error of the mean is then given by sqrt(var[k*stride]/nred[k]) of the returned level k.
+    static int selectLevel(int nlevels, int stride, const double var[], const double gamma[], const int64_t nred[]);
 };
 } // namespace mci
 
@@ -22,8 +22,20 @@ int init();
 // set different random seeds per thread from a file
 void setSeed(mci::MCI &mci, const std::string &filename, int offset = 0); // with offset you can control how many seeds to skip initially
 
+// set the same master seed on all ranks, but let every rank use its own stream (i.e. no file needed)
+// NOTE: Requires a random engine with independent streams (see MCI::setRandomEngine), which guarantees
+// non-overlapping sequences for any number of ranks. The Philox engine selects the stream in O(1), xoshiro in O(log rank).
+void setSeed(mci::MCI &mci, uint64_t seed);
+
 // integrate in parallel and accumulate results
-void integrate(mci::MCI &mci, int64_t Nmc, double average[], double error[], bool doFindMRT2Step = true, bool doDecorrelation = true);
+// NOTE: By default, every rank estimates its own data and the averages/errors of all ranks are combined.
+// With flag_pool, the raw data of all ranks is merged on root before estimation instead, i.e. the result is estimated
+// as if one walker had sampled all steps. Then root needs the memory (or disk space) for the data of all ranks.
+void integrate(mci::MCI &mci, int64_t Nmc, double average[], double error[], bool doFindMRT2Step = true, bool doDecorrelation = true,
+               bool flag_pool = false);
+
+// continue an interrupted integrate from the checkpoints of all ranks (see MCI::setCheckpoint/resume) and accumulate results like above
+void resume(mci::MCI &mci, const std::string &filepath, double average[], double error[], bool flag_pool = false);
 
 // finalize MPI
 void finalize();
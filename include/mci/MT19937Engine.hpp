@@ -0,0 +1,56 @@
+#ifndef MCI_MT19937ENGINE_HPP
+#define MCI_MT19937ENGINE_HPP
+
+#include "mci/Checkpoint.hpp"
+#include "mci/RandomEngineInterface.hpp"
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace mci
+{
+// Wrapper of the standard library's 64-bit Mersenne Twister (MCI's default engine).
+// Jumping is not supported, so independent streams have to be obtained by seeding.
+class MT19937Engine final: public RandomEngineInterface
+{
+protected:
+    std::mt19937_64 _mt;
+
+    RandomEngineInterface * _clone() const final
+    {
+        auto * ret = new MT19937Engine();
+        ret->_mt = _mt; // copy state
+        return ret;
+    }
+
+public:
+    explicit MT19937Engine(uint64_t seed = std::mt19937_64::default_seed): _mt(seed) {}
+
+    void seed(uint64_t seed) final { _mt.seed(seed); }
+    void generate(uint64_t out[], int n) final
+    {
+        for (int i = 0; i < n; ++i) { out[i] = _mt(); }
+    }
+    void discard(uint64_t n) final { _mt.discard(n); }
+
+    bool hasIndependentStreams() const final { return false; }
+    void jump(uint64_t/*n*/) final { throw std::runtime_error("[MT19937Engine::jump] Jump-ahead is not supported by this engine."); }
+    void longJump(uint64_t/*n*/) final { throw std::runtime_error("[MT19937Engine::longJump] Jump-ahead is not supported by this engine."); }
+
+    void saveState(std::ostream &out) const final
+    {   // the standard only provides the textual representation of the state
+        std::ostringstream state;
+        state << _mt;
+        writeCheckpointString(out, state.str());
+    }
+    void loadState(std::istream &in) final
+    {
+        std::istringstream state(readCheckpointString(in));
+        state >> _mt;
+        if (state.fail()) { throw std::runtime_error("[MT19937Engine::loadState] Checkpoint contains an invalid engine state."); }
+    }
+};
+}  // namespace mci
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef MCI_MAPPEDFULLACCUMULATOR_HPP
+#define MCI_MAPPEDFULLACCUMULATOR_HPP
+
+#include "mci/AccumulatorInterface.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mci
+{
+// Class to handle accumulation of observables like FullAccumulator, i.e. storing every single sample,
+// but in a memory-mapped file instead of RAM. So the number of samples is limited by disk space and the
+// kernel pages the data in and out as needed (with sequential access hints). The file contains the raw
+// samples in [nstore][nobs] layout (native doubles) and is kept after deallocation (unless requested
+// otherwise), so the samples of the last run may be re-analyzed later.
+//
+// NOTE 1: For long runs, pair it with estimators which process the data in sequential passes without copying it,
+//         i.e. Uncorrelated or Correlated/MJBlocker (ObservableContainer evaluates the latter in a single streaming pass).
+//         FCBlocker and Autocorrelation need work memory proportional to the number of samples.
+// NOTE 2: Reset only rewinds the write position, i.e. the file keeps the samples until they are overwritten.
+// NOTE 3: Optionally, the kernel is advised to back the mapping by (transparent) huge pages, where supported.
+// NOTE 4: On checkpoints (see MCI::setCheckpoint), the samples are synced to the file and only the write position is saved.
+//         The file is not truncated on allocation, so that resume continues on the samples of the interrupted run.
+//
+class MappedFullAccumulator final: public AccumulatorInterface
+{
+protected:
+    const std::string _filepath; // path of the mapped file
+    const bool _flag_keep; // keep the file after deallocation?
+    const bool _flag_hugepages; // advise huge pages?
+
+    int _fd; // file descriptor (-1 if not open)
+    size_t _maplen; // length of the current mapping in bytes
+    int64_t _nstore; // number of allocated storage elements with _nobs length each
+    int64_t _ncapacity; // number of elements the file and mapping have room for (>= _nstore after reserveMerge)
+    int64_t _storeidx; // storage index offset for next write
+    int64_t _nfound; // number of doubles the file contained when it was opened (i.e. which a checkpoint may refer to)
+
+    void _map(int64_t ncapacity); // resize the file to ncapacity elements and (re)map it to _data
+    void _unmap(); // remove the mapping
+
+    // --- storage method to be implemented
+    void _allocate() final;
+    void _accumulate() final;
+    void _finalize() final;
+    void _reset() final;
+    void _deallocate() final;
+    void _merge(int64_t nstore, int64_t naccu, const double data[]) final;
+    void _reserveMerge(int64_t nstore) final;
+    void _saveState(std::ostream &out) const final;
+    void _loadState(std::istream &in) final;
+
+public:
+    MappedFullAccumulator(ObservableFunctionInterface &obs, int nskip, std::string filepath, bool flag_keep = true, bool flag_hugepages = false);
+
+    ~MappedFullAccumulator() final { this->_deallocate(); }
+
+    const std::string &getFilePath() const { return _filepath; }
+    bool isChunkMergeable() const final { return true; } // e.g. MPI ranks are streamed into the file
+    int64_t getNStore() const final { return _nstore; }
+};
+}  // namespace mci
+
+#endif
@@ -25,7 +25,6 @@ class MultiStepMove final: public TrialMoveInterface
 protected:
     int _nsteps; // how many sub-sampling steps to do
     double * const _origX; // used to backup the original xold
-    std::uniform_real_distribution<double> _rd; // used for own accept/reject
     std::unique_ptr<TrialMoveInterface> _trialMove; // the contained sub-move (init: uniform all-move)
     SamplingFunctionContainer _pdfcont; // sampling function container (init: empty)
 
@@ -42,10 +41,21 @@ protected:
     void _newToOld() final {}; // not needed
     void _oldToNew() final {}; // not needed
 
+    // the sub-move and sub-PDFs have their own state (the step sizes are saved via ours)
+    void _saveState(std::ostream &out) const final
+    {
+        _trialMove->saveState(out);
+        _pdfcont.saveState(out);
+    }
+    void _loadState(std::istream &in) final
+    {
+        _trialMove->loadState(in);
+        _pdfcont.loadState(in);
+    }
+
 public:
     MultiStepMove(int ndim, int nsteps):
             TrialMoveInterface(ndim, 0), _nsteps(nsteps), _origX(new double[ndim]),
-            _rd(std::uniform_real_distribution<double>(0., 1.)),
             _trialMove(new UniformVecMove(ndim, 1, 0.05)) /*default to uniform single-move*/
     {}
 
@@ -32,6 +32,24 @@ class ObservableContainer
 
         // Estimator function used to obtain result of MC integration
         std::function<void(double [] /*avg*/, double [] /*error*/)> estim; // corresponding accumulator is already bound
+        std::function<void(double [] /*avg*/, double [] /*error*/)> estimInPlace; // same, but may overwrite the data (empty if unsupported)
+        // same, but only for the columns [j0, j0+ncols) of the data, which get copied to buffer (length nstore*ncols) first
+        // (unless the data is column-major already)
+        std::function<void(int /*j0*/, int /*ncols*/, double [] /*buffer*/, double [] /*avg*/, double [] /*error*/)> estimCols;
+
+        // results of the last autocorrelation analysis (only for EstimatorType::Autocorrelation, else nullptr)
+        std::unique_ptr<double[]> tau; // integrated autocorrelation times (length nobs)
+        std::unique_ptr<double[]> ess; // effective sample sizes (length nobs)
+
+        // covariance matrix of the mean from the last estimate (only for EstimatorType::Covariance, else nullptr)
+        std::unique_ptr<double[]> cov; // nobs x nobs, row-major
+
+        // settings (remembered to recreate the element, e.g. for parallel workers)
+        int blocksize{}; // blocksize passed on addObservable
+        int nbins{}; // number of bins of a BinningAccumulator (0 if not used)
+        SampleStorage storage{}; // storage settings (see Factories.hpp)
+        bool flag_tiles{}; // may the estimation be split into column tiles (on parallel estimation)?
+        EstimatorType estimType{}; // type of the estimator
 
         // flags
         bool flag_equil{}; // equilibrate this observable when using automatic decorrelation?
@@ -44,8 +62,11 @@ private:
     int _nskip_PDF{0}; // stores the number of MC steps per update of the PDF dependency (i.e. call to pdf->prepareObservation(..))
 
     void _setDependsOnPDF(); // set flag to "any contained depobs depends on PDF"
+    void _estimateParallel(double average[], double error[], int nthreads, bool inPlace) const; // estimate on nthreads threads
 
 public:
+    static constexpr int ESTIMATOR_TILE_WIDTH = 64; // observables with more dimensions are estimated in tiles of columns, on parallel estimation
+
     // simple getters
     int size() const { return static_cast<int>(_cont.size()); }
     int getNObs() const { return this->size(); }
@@ -59,17 +80,36 @@ public:
     ObservableFunctionInterface &getObservableFunction(int i) const { return *(_cont[i].obs); }
     const AccumulatorInterface &getAccumulator(int i) const { return *(_cont[i].accu); }
     bool getFlagEquil(int i) const { return _cont[i].flag_equil; }
+    int getBlockSize(int i) const { return _cont[i].blocksize; }
+    int getNBins(int i) const { return _cont[i].nbins; }
+    const SampleStorage &getSampleStorage(int i) const { return _cont[i].storage; }
+    int getNSkip(int i) const { return _cont[i].accu->getNSkip(); }
+    EstimatorType getEstimatorType(int i) const { return _cont[i].estimType; }
 
     // operational methods
     // add observable (+internally accumulator&estimator)
     void addObservable(std::unique_ptr<ObservableFunctionInterface> obs /*we acquire ownership*/,
-                       int blocksize, int nskip, bool needsEquil, EstimatorType estimType);
+                       int blocksize, int nskip, bool needsEquil, EstimatorType estimType, int nbins = 0 /*if > 0, use BinningAccumulator*/,
+                       const SampleStorage &storage = SampleStorage() /*alternative storage or layout*/);
 
     void allocate(int64_t Nmc, const SamplingFunctionContainer &pdfcont); // allocate data memory and register dependencies
     void accumulate(const WalkerState &wlk); // process accumulation for new step, described by WalkerState
     void printObsValues(std::ofstream &file) const; // write last observables values to filestream
+    void getObsValues(double values[]) const; // copy last observables values to array (length getNObsDim())
     void finalize(); // used after sampling to apply all necessary data normalization
-    void estimate(double average[], double error[]) const; // eval estimators on finalized data and return average/error
+    void merge(const ObservableContainer &other); // merge finalized data of a container with equal layout (e.g. from other walkers)
+    void merge(int i, int64_t nsteps, int64_t naccu, int64_t nstore, const double data[]); // merge raw data into i-th accumulator (e.g. from other MPI ranks)
+    void reserveMerge(int i, int64_t nstore); // prepare the i-th accumulator for merging nstore more elements (in chunks, if it isChunkMergeable)
+    void saveState(std::ostream &out) const; // write the state of all accumulators while sampling (checkpointing)
+    void loadState(std::istream &in); // read it back (the container must be configured equally and allocated for the same Nmc)
+    // eval estimators on finalized data and return average/error
+    // With nthreads != 1, the observables and column tiles of large observables are estimated in parallel (< 1: all hardware threads).
+    void estimate(double average[], double error[], int nthreads = 1) const;
+    void estimateInPlace(double average[], double error[], int nthreads = 1); // same, but data may be overwritten (reset or deallocate afterwards)
+                                                                               // (row-major data with in-place estimator is not split into tiles)
+    void getAutocorrelation(double tau[], double ess[]) const; // tau_int/ESS from the last estimate (NaN if not available)
+    void getCovariance(int i, double cov[]) const; // covariance matrix of the i-th observable's mean from the last estimate (NaN if not available)
+    void scaleCovariance(double factor); // multiply all stored covariance matrices by factor (e.g. volume^2)
     void reset(); // obtain clean state, but keep allocation
     void deallocate(); // free data memory
     std::unique_ptr<ObservableFunctionInterface> pop_back(); // remove and return last obs
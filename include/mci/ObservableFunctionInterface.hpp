@@ -60,6 +60,14 @@ public:
     // pass isUpdateable=false to the constructor.
     virtual void updatedObservable(const double in[], int/*nchanged*/, const bool/*flags_xchanged[ndim]*/[], double out[]) { this->observableFunction(in, out); }
     //                             ^input = walker positions  ^how many inputs changed  ^which indices are new      ^resulting observables (passed containing old obs, so you may make use of those)
+
+    // This overload is what MCI actually calls. Additionally to the flags, it provides the nchanged indices which have changed
+    // (NOT necessarily in ascending order), so you can recompute in O(nchanged) instead of scanning all ndim flags.
+    // Per default it just calls the flag-based version above, so override either of them.
+    virtual void updatedObservable(const double in[], int nchanged, const int/*changedIdx[nchanged]*/[], const bool flags_xchanged[], double out[])
+    {
+        this->updatedObservable(in, nchanged, flags_xchanged, out);
+    }
 };
 }  // namespace mci
 
@@ -0,0 +1,19 @@
+#ifndef MCI_PARALLELFOR_HPP
+#define MCI_PARALLELFOR_HPP
+
+#include <cstdint>
+#include <functional>
+
+namespace mci
+{
+// Run task(itask, ithread) for all itask in [0, ntasks), on nthreads threads (including the calling one).
+// Tasks are handed out dynamically, so they may differ in cost. ithread is in [0, nthreads) and can be used
+// to select per-thread scratch memory. If nthreads < 1, all hardware threads are used.
+// The first exception thrown by a task is rethrown after all threads have finished.
+void parallelFor(int64_t ntasks, int nthreads, const std::function<void(int64_t/*itask*/, int/*ithread*/)> &task);
+
+// Resolve the actual number of threads to use for ntasks with nthreads requested (see above)
+int selectNThreads(int64_t ntasks, int nthreads);
+}  // namespace mci
+
+#endif
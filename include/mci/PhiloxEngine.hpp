@@ -0,0 +1,51 @@
+#ifndef MCI_PHILOXENGINE_HPP
+#define MCI_PHILOXENGINE_HPP
+
+#include "mci/RandomEngineInterface.hpp"
+
+#include <algorithm>
+
+namespace mci
+{
+// The counter-based Philox4x64-10 engine by J. Salmon et al. (Random123, SC'11).
+// Every 256-bit counter value is encrypted with the 128-bit key (k0 = seed, k1 = 0) to
+// four random 64-bit outputs, so discard() is O(1). Streams are obtained by counter offsets:
+// jump() advances by 2^128 blocks (i.e. counter word 2) and longJump() by 2^192 blocks (word 3).
+class PhiloxEngine final: public RandomEngineInterface
+{
+protected:
+    uint64_t _ctr[4]{}; // counter of the next block
+    uint64_t _key[2]{}; // key
+    uint64_t _block[4]{}; // current output block
+    int _bidx{}; // index of next output in _block (4 means empty)
+
+    RandomEngineInterface * _clone() const final
+    {
+        auto * ret = new PhiloxEngine();
+        std::copy(_ctr, _ctr + 4, ret->_ctr);
+        std::copy(_key, _key + 2, ret->_key);
+        std::copy(_block, _block + 4, ret->_block);
+        ret->_bidx = _bidx;
+        return ret;
+    }
+
+    void _addToCounter(uint64_t n, int word); // add n to counter word (with carry)
+    void _nextBlock(); // compute block from counter and increment counter
+
+public:
+    explicit PhiloxEngine(uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(uint64_t seed) final;
+    void generate(uint64_t out[], int n) final;
+    void discard(uint64_t n) final;
+
+    bool hasIndependentStreams() const final { return true; }
+    void jump(uint64_t n) final; // n times 2^128 blocks ahead
+    void longJump(uint64_t n) final; // n times 2^192 blocks ahead
+
+    void saveState(std::ostream &out) const final;
+    void loadState(std::istream &in) final;
+};
+}  // namespace mci
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef MCI_PROTOFUNCTIONINTERFACE_HPP
 #define MCI_PROTOFUNCTIONINTERFACE_HPP
 
+#include <algorithm>
+#include <iosfwd>
+
 namespace mci
 {
 // Base class for all proto functions
@@ -12,6 +15,8 @@ namespace mci
 // accepted position and a variable set (_protonew) for the newly proposed position.
 // Whenever the new position is accepted (externally), the method newToOld() get's called to
 // copy new values to old and on rejection oldToNew() does the opposite.
+// By default all proto values are copied, but if your selective update only touches few of them,
+// call markDirty() with the changed range and only that range will be copied (see below).
 //
 // Child classes have to implement the virtual protoFunction(...) method, which takes a set
 // of inputs and calculates the proto values. The derived interfaces decide how to make actual
@@ -21,6 +26,8 @@ namespace mci
 // to your old data. This makes sure the old values are initialized at the first step and
 // copied on newToOld. Update the data in protoFunction and in the derived interface's selective
 // updating methods.
+// For checkpointing (see MCI::setCheckpoint), the proto values are saved automatically. If your
+// class has further state that changes during sampling, implement _saveState/_loadState as well.
 class ProtoFunctionInterface
 {
 protected:
@@ -29,14 +36,42 @@ protected:
     double * _protoold; // ptr to the old proto values
     double * _protonew; // ptr to the new proto values
 
+    // dirty range of proto values, i.e. the ones that may differ between new and old
+    bool _flag_dirtyAll; // are all proto values dirty? (default state, reset on every newToOld/oldToNew)
+    int _dirtyBegin, _dirtyEnd; // [begin, end) range of dirty proto values, if !_flag_dirtyAll
+
     // internal setters
     void setNProto(int nproto); // you may freely choose the amount of values you need
 
+    // Mark proto values [begin, end) as changed in the current step. Repeated calls within one
+    // step extend the range to include all marked ranges. If you never call these methods in
+    // a step, all proto values are considered changed.
+    void markDirty(int begin, int end)
+    {
+        _flag_dirtyAll = false;
+        _dirtyBegin = std::min(_dirtyBegin, begin);
+        _dirtyEnd = std::max(_dirtyEnd, end);
+    }
+    void markDirty(int i) { this->markDirty(i, i + 1); }
+
     // Overwrite this if you have own data to copy on acceptance/rejection.
     // It will be called in the public newToOld()/oldToNew() methods.
     virtual void _newToOld() {};
     virtual void _oldToNew() {};
 
+    // Overwrite these if you have own state that changes while sampling (i.e. which isn't
+    // restored by construction/cloning), to make resumed runs continue bit-identically.
+    // They get called at the end of a step and may use the helpers from Checkpoint.hpp.
+    virtual void _saveState(std::ostream &/*out*/) const {};
+    virtual void _loadState(std::istream &/*in*/) {};
+
+    void _resetDirty() // reset to "all dirty" state
+    {
+        _flag_dirtyAll = true;
+        _dirtyBegin = _nproto;
+        _dirtyEnd = 0;
+    }
+
     ProtoFunctionInterface(int ndim, int nproto);
 
 public:
@@ -55,6 +90,10 @@ public:
     void newToOld(); // called on acceptance
     void oldToNew(); // called on rejection
 
+    // checkpointing (between steps, i.e. when old and new proto values are equal)
+    void saveState(std::ostream &out) const; // write proto values, call _saveState()
+    void loadState(std::istream &in); // read proto values (to old and new), call _loadState()
+
     // --- METHOD THAT MUST BE IMPLEMENTED
 
     // Function that MCI uses to calculate your proto-function values
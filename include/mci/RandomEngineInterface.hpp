@@ -0,0 +1,53 @@
+#ifndef MCI_RANDOMENGINEINTERFACE_HPP
+#define MCI_RANDOMENGINEINTERFACE_HPP
+
+#include "mci/Clonable.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <stdexcept>
+
+namespace mci
+{
+// Interface for 64-bit pseudo random number engines
+//
+// MCI does not draw from engines directly, but through a RandomGenerator (see RandomGenerator.hpp),
+// which buffers blocks of engine output and is passed to the trial moves. To implement your own engine,
+// derive from this class and implement the methods below, plus the protected _clone method.
+//
+// About streams: Engines that return true on hasIndependentStreams() provide jump(n)/longJump(n),
+// which advance the state by n huge, fixed distances (e.g. 2^128 and 2^192 outputs), in O(1) or O(log n)
+// (see the engines). The resulting subsequences can be used as non-overlapping streams for threads or MPI ranks.
+// Other engines should throw std::runtime_error on jump()/longJump().
+//
+// About checkpoints: To be used with MCI::setCheckpoint, an engine must also implement saveState()/loadState(),
+// which write/read the complete state in binary form (see Checkpoint.hpp). By default, they throw.
+class RandomEngineInterface: public Clonable<RandomEngineInterface>
+{
+public:
+    ~RandomEngineInterface() override = default;
+
+    // --- METHODS THAT MUST BE IMPLEMENTED
+
+    virtual void seed(uint64_t seed) = 0; // reset the engine into the state defined by seed
+    virtual void generate(uint64_t out[], int n) = 0; // fill out with the next n random 64-bit integers
+    virtual void discard(uint64_t n) = 0; // advance the state as if n numbers were generated (cost is engine specific)
+
+    virtual bool hasIndependentStreams() const = 0; // are jump()/longJump() supported?
+    virtual void jump(uint64_t n) = 0; // advance to the n-th next stream (jump distance depends on engine)
+    virtual void longJump(uint64_t n) = 0; // advance to the n-th next block of streams (i.e. even larger distance)
+
+    // --- OPTIONAL METHODS
+
+    virtual void saveState(std::ostream &/*out*/) const // write the complete engine state
+    {
+        throw std::runtime_error("[RandomEngineInterface::saveState] This engine doesn't support checkpointing.");
+    }
+    virtual void loadState(std::istream &/*in*/) // continue from a state written by saveState
+    {
+        throw std::runtime_error("[RandomEngineInterface::loadState] This engine doesn't support checkpointing.");
+    }
+};
+}  // namespace mci
+
+#endif
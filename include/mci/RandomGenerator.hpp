@@ -0,0 +1,92 @@
+#ifndef MCI_RANDOMGENERATOR_HPP
+#define MCI_RANDOMGENERATOR_HPP
+
+#include "mci/RandomEngineInterface.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <memory>
+
+namespace mci
+{
+// The random number generator used by MCI and passed to the trial moves.
+//
+// It owns a RandomEngineInterface and draws the engine's output in blocks into an internal buffer,
+// so that the virtual engine call is amortized over many numbers. The generator fulfills the
+// UniformRandomBitGenerator requirements of the standard library (returning 64-bit integers),
+// so it can be used with all standard random distributions.
+// Additionally, it provides buffered uniform (in [0,1)) and standard normal doubles, which are
+// converted in whole blocks from the engine output (53-bit conversion and ziggurat method, respectively).
+// NOTE: Seeding and jumping discard the remaining buffers, i.e. they act on the engine position. Discarding skips
+// the next n numbers of operator() and discards the buffered doubles, so that they are drawn after the skipped numbers.
+// NOTE 2: Because of the block conversion, a seed yields other uniform/normal doubles (and therefore other walks)
+// than the per-call distributions used before the buffering was introduced.
+class RandomGenerator
+{
+public:
+    static constexpr int BUFFER_SIZE = 256; // how many numbers we generate at once
+
+protected:
+    std::unique_ptr<RandomEngineInterface> _engine;
+    uint64_t * const _buffer; // buffered engine output (length BUFFER_SIZE)
+    double * const _ubuffer; // buffered uniform doubles (length BUFFER_SIZE)
+    double * const _nbuffer; // buffered normal doubles (length BUFFER_SIZE)
+    int _bufidx, _uidx, _nidx; // index of the next buffered number to return
+
+    void _refill()
+    {
+        _engine->generate(_buffer, BUFFER_SIZE);
+        _bufidx = 0;
+    }
+    void _refillUniform(); // 53-bit conversion of a block of engine output
+    void _refillNormal(); // ziggurat method on a block of engine output
+    void _clearBuffers() { _bufidx = _uidx = _nidx = BUFFER_SIZE; }
+
+public:
+    explicit RandomGenerator(std::unique_ptr<RandomEngineInterface> engine);
+    ~RandomGenerator();
+
+    RandomGenerator(const RandomGenerator &) = delete;
+    RandomGenerator &operator=(const RandomGenerator &) = delete;
+
+    // UniformRandomBitGenerator interface
+    using result_type = uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    result_type operator()()
+    {
+        if (_bufidx == BUFFER_SIZE) { this->_refill(); }
+        return _buffer[_bufidx++];
+    }
+
+    // buffered doubles
+    double uniform() // uniform in [0,1)
+    {
+        if (_uidx == BUFFER_SIZE) { this->_refillUniform(); }
+        return _ubuffer[_uidx++];
+    }
+    double normal() // standard normal (mean 0, standard deviation 1)
+    {
+        if (_nidx == BUFFER_SIZE) { this->_refillNormal(); }
+        return _nbuffer[_nidx++];
+    }
+
+    // engine handling
+    void setEngine(std::unique_ptr<RandomEngineInterface> engine); // replace engine (keeps its state)
+    const RandomEngineInterface &getEngine() const { return *_engine; }
+    bool hasIndependentStreams() const { return _engine->hasIndependentStreams(); }
+
+    // stream control
+    void seed(uint64_t seed); // seed the engine
+    void discard(uint64_t n); // skip the next n numbers (and the buffered doubles)
+    void jump(uint64_t n = 1); // see RandomEngineInterface
+    void longJump(uint64_t n = 1);
+
+    // checkpointing of engine state and buffers (requires an engine which supports it, see RandomEngineInterface)
+    void saveState(std::ostream &out) const;
+    void loadState(std::istream &in); // throws if the checkpoint was written with a different engine type
+};
+}  // namespace mci
+
+#endif
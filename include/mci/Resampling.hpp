@@ -0,0 +1,38 @@
+#ifndef MCI_RESAMPLING_HPP
+#define MCI_RESAMPLING_HPP
+
+#include <cstdint>
+#include <functional>
+
+namespace mci
+{
+// Resampling analysis of derived quantities, i.e. nonlinear functions of averages like <A>/<B>,
+// whose error can't be obtained from the separate errors of the averages.
+//
+// The data (e.g. block averages of Full/Block/BinningAccumulator, with the usual [n][nobs] layout) is first reduced
+// to ngroups group averages. The groups should be long enough to be uncorrelated. Then the derived function f
+// is evaluated on resampled averages of the groups:
+//   - Jackknife: leave out one group at a time, the value is bias corrected (ngroups resamples).
+//   - Bootstrap: draw ngroups groups with replacement (nresamples resamples), the value is f(average).
+//
+enum class ResamplingType
+{
+    Jackknife,
+    Bootstrap
+};
+
+// derived quantity function, writing nout values computed from nobs averages (must be thread-safe for nthreads > 1)
+using DerivedFunction = std::function<void(const double /*avg*/[], double /*out*/[])>;
+
+// Average the first nblocks/ngroups*ngroups rows of data (nblocks rows of nobs) in ngroups contiguous groups
+// and write them to groupavg[g*stride + j] (i.e. several observables can be written side by side).
+void calcGroupAverages(int64_t nblocks, int nobs, const double data[], int ngroups, int stride, double groupavg[]);
+
+// Resampling estimate of the nout values of f and their errors, from ngroups group averages (ngroups rows of nobs).
+// The resamples are distributed over nthreads threads (< 1: all hardware threads), while results are independent of
+// nthreads: Every bootstrap resample draws from its own stream of a Philox engine seeded with seed.
+void resampleDerived(ResamplingType type, int ngroups, int nobs, const double groupavg[], const DerivedFunction &f, int nout,
+                     double value[], double error[], int nresamples = 1000, uint64_t seed = 0, int nthreads = 1);
+}  // namespace mci
+
+#endif
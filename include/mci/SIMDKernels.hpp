@@ -0,0 +1,40 @@
+#ifndef MCI_SIMDKERNELS_HPP
+#define MCI_SIMDKERNELS_HPP
+
+#include <cstdint>
+
+namespace mci
+{
+// Explicitly vectorized kernels for the hot loops of the estimators, on data with the usual [n][ndim] layout.
+// The kernels vectorize over the observable dimensions (which are contiguous) and keep the accumulators of
+// several column vectors in registers while going through the samples. There are AVX-512 and AVX2 versions
+// (x86-64 with GCC/Clang only) and a scalar fallback, which is selected at runtime according to the CPU.
+//
+// NOTE: Every column is accumulated in sample order, but the vector versions use FMA instructions, so results
+//       may differ from the scalar version in the last bits.
+//
+enum class SIMDLevel
+{
+    Scalar,
+    AVX2, /* AVX2 + FMA */
+    AVX512 /* AVX-512F */
+};
+
+SIMDLevel getMaxSIMDLevel(); // highest level supported by the CPU (and build)
+SIMDLevel getSIMDLevel(); // the level currently used by the kernels (init: max)
+void setSIMDLevel(SIMDLevel level); // select the level used by the kernels, e.g. for testing or benchmarks (capped to max)
+
+// sum[j] = sum_i x[i*ndim + j] and, if sumsq != nullptr, sumsq[j] = sum_i x[i*ndim + j]^2
+void sumColumns(int64_t n, int ndim, const double x[], double sum[], double sumsq[] /*may be nullptr*/);
+
+// the same for a single contiguous column x (e.g. of column-major data), which is vectorized along x
+void sumContiguous(int64_t n, const double x[], double &sum, double * sumsq /*may be nullptr*/);
+
+// One blocking level of MJBlocker on the first 2*npairs samples of x: With X = x - mean, add X_i^2 to var,
+// the lag-1 products X_{i-1}*X_i to gamma (X_{-1} = prev, which is set to the last X on return) and write
+// the pair averages to xred (may be x) while adding them to sumred.
+void blockPairs(int64_t npairs, int ndim, const double x[], const double mean[], double xred[],
+                double var[], double gamma[], double prev[], double sumred[]);
+}  // namespace mci
+
+#endif
@@ -1,10 +1,13 @@
 #ifndef MCI_SRRDALLMOVE_HPP
 #define MCI_SRRDALLMOVE_HPP
 
+#include "mci/Checkpoint.hpp"
 #include "mci/TypedMoveInterface.hpp"
 
 #include <algorithm>
 #include <random>
+#include <sstream>
+#include <stdexcept>
 
 namespace mci
 {
@@ -14,6 +17,7 @@ namespace mci
 // specializations of the createSymRRD() function.
 // In any case, SRRD type must be callable and, when called with passed stdlib
 // random generator, return a random double from a symmetric distribution around 0.
+// For checkpointing, it must also be streamable (operator<< and operator>>) like them.
 // By including this header you automatically "use" instantiations for types that
 // have builtin support (see end of file).
 //
@@ -40,6 +44,20 @@ private:
     void _newToOld() final {}
     void _oldToNew() final {}
 
+    // distributions may cache values between draws (e.g. Student-t), so we save them textually
+    void _saveState(std::ostream &out) const final
+    {
+        std::ostringstream rdstate;
+        rdstate << _rd;
+        writeCheckpointString(out, rdstate.str());
+    }
+    void _loadState(std::istream &in) final
+    {
+        std::istringstream rdstate(readCheckpointString(in));
+        rdstate >> _rd;
+        if (rdstate.fail()) { throw std::runtime_error("[SRRDAllMove::loadState] Checkpoint contains an invalid distribution state."); }
+    }
+
 public:
     // Full constructor with scalar step init and optionally passed pre-made random dist
     SRRDAllMove(int ndim, int ntypes, const int typeEnds[] /*len ntypes*/, double initStepSize /*scalar init*/, const SRRD * rdist = nullptr):
@@ -70,7 +88,7 @@ public:
         int xidx = 0;
         for (int tidx = 0; tidx < _ntypes; ++tidx) {
             while (xidx < _typeEnds[tidx]) {
-                wlk.xnew[xidx] += _stepSizes[tidx]*_rd(*(_rgen));
+                wlk.xnew[xidx] += _stepSizes[tidx]*drawSymRRD(_rd, *_rgen);
                 ++xidx;
             }
         }
@@ -1,9 +1,11 @@
 #ifndef MCI_SRRDVECMOVE_HPP
 #define MCI_SRRDVECMOVE_HPP
 
+#include "mci/Checkpoint.hpp"
 #include "mci/TypedMoveInterface.hpp"
 
 #include <algorithm>
+#include <sstream>
 #include <stdexcept>
 #include <random>
 
@@ -36,6 +38,20 @@ private:
     void _newToOld() final {}
     void _oldToNew() final {}
 
+    // distributions may cache values between draws (e.g. Student-t), so we save them textually
+    void _saveState(std::ostream &out) const final
+    {
+        std::ostringstream rdstate;
+        rdstate << _rdidx << ' ' << _rdmov;
+        writeCheckpointString(out, rdstate.str());
+    }
+    void _loadState(std::istream &in) final
+    {
+        std::istringstream rdstate(readCheckpointString(in));
+        rdstate >> _rdidx >> _rdmov;
+        if (rdstate.fail()) { throw std::runtime_error("[SRRDVecMove::loadState] Checkpoint contains an invalid distribution state."); }
+    }
+
 public:
     // Full constructor with scalar step init and optionally passed pre-made random dist
     SRRDVecMove(int nvecs, int veclen, int ntypes, const int typeEnds[] /*len ntypes*/, double initStepSize /*scalar*/, const SRRD * rdist = nullptr):
@@ -87,7 +103,7 @@ public:
 
         // do step
         for (int i = 0; i < _veclen; ++i) {
-            wlk.xnew[xidx + i] += _stepSizes[tidx]*_rdmov(*_rgen);
+            wlk.xnew[xidx + i] += _stepSizes[tidx]*drawSymRRD(_rdmov, *_rgen);
             wlk.changedIdx[i] = xidx + i;
         }
         wlk.nchanged = _veclen; // how many indices we changed
@@ -4,6 +4,7 @@
 #include "mci/SamplingFunctionInterface.hpp"
 #include "mci/WalkerState.hpp"
 
+#include <iosfwd>
 #include <memory>
 #include <vector>
 
@@ -35,6 +36,8 @@ public:
     double getOldSamplingFunction() const; // returns the combined true sampling function value of the old step (potential use in trial moves)
     double computeAcceptance(const WalkerState &wlk); //compute then new sampling function and return acceptance of new coordinates
     void prepareObservation(const double x[]); // prepare the pdfs to be observed by observables
+    void saveState(std::ostream &out) const; // write the state of all pdfs (checkpointing)
+    void loadState(std::istream &in); // read it back (the pdfs must be configured equally)
 
     //void printProtoValues(std::ofstream &file) const; // write last protovalues to filestream
     std::unique_ptr<SamplingFunctionInterface> pop_back(); // remove and return last pdf
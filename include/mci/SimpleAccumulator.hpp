@@ -18,6 +18,9 @@ protected:
     void _finalize() final;
     void _reset() final;
     void _deallocate() final;
+    void _merge(int64_t nstore, int64_t naccu, const double data[]) final;
+    void _saveState(std::ostream &out) const final;
+    void _loadState(std::istream &in) final;
 
 public:
     SimpleAccumulator(ObservableFunctionInterface &obs, int nskip):
@@ -0,0 +1,83 @@
+#ifndef MCI_STREAMBLOCKACCUMULATOR_HPP
+#define MCI_STREAMBLOCKACCUMULATOR_HPP
+
+#include "mci/AccumulatorInterface.hpp"
+
+#include <cstdint>
+
+namespace mci
+{
+// Class to handle accumulation of observables for Marius Jonsson's automatic blocking (see MJBlocker.hpp),
+// without storing the samples. Instead, on every blocking level k (i.e. blocks of 2^k samples) we keep
+// running sums which are sufficient to compute the variance and lag-1 covariance of that level. Whenever
+// a level completes a pair of blocks, their average is passed on to the next level. So the memory is
+// only O(log2(naccu)*nobs), allowing arbitrarily long runs with correlated error estimation.
+//
+// NOTE 1: The stored data are not samples, but the level sums. They are only meant to be evaluated by the
+//         estimate() method below (used by EstimatorType::StreamMJBlocker).
+// NOTE 2: The estimate reproduces MJBlockerEstimator on the full data, i.e. an odd element at the tail
+//         of a level is not passed on and the variances are computed around the level means.
+// NOTE 3: Merging concatenates the sequences on every level, i.e. blocks are not formed across the seam.
+//
+class StreamBlockAccumulator final: public AccumulatorInterface
+{
+public:
+    // data fields per blocking level, all relative to the first sample (stored in the first row of data)
+    enum Field
+    {
+        SUM, /* sum of elements */
+        SUMSQ, /* sum of squared elements */
+        SUMLAG1, /* sum of products of successive elements */
+        FIRST, /* first element */
+        LAST, /* last element */
+        COUNT, /* number of elements on the level */
+        NFIELDS
+    };
+
+protected:
+    int _nlevels; // number of blocking levels (set on allocation)
+    double * const _carry; // helper to pass block averages up the levels (length _nobs)
+
+    double * _row(int level, Field field) { return _data + (1 + level*NFIELDS + field)*_nobs; }
+
+    // add the shifted sample carry (overwritten) to the level data of nlevels levels
+    static void _pushLevels(int nlevels, int nobs, double data[], double carry[]);
+    // add n samples x to the level data (the first sample of all must already be stored as shift)
+    static void _pushSamples(int nlevels, int nobs, int64_t n, const double x[], double data[], double carry[]);
+
+    // --- storage method to be implemented
+    void _allocate() final;
+    void _accumulate() final;
+    void _finalize() final {} // nothing to do
+    void _reset() final;
+    void _deallocate() final;
+    void _merge(int64_t nstore, int64_t naccu, const double data[]) final;
+    void _saveState(std::ostream &out) const final;
+    void _loadState(std::istream &in) final;
+
+public:
+    StreamBlockAccumulator(ObservableFunctionInterface &obs, int nskip):
+            AccumulatorInterface(obs, nskip), _nlevels(0), _carry(new double[_nobs]) {}
+
+    ~StreamBlockAccumulator() final
+    {
+        this->_deallocate();
+        delete[] _carry;
+    }
+
+    int getNLevels() const { return _nlevels; }
+    int64_t getNStore() const final { return (_nlevels > 0) ? 1 + _nlevels*NFIELDS : 0; }
+
+    // Compute average and error of the mean from the level data of a StreamBlockAccumulator
+    static void estimate(int64_t nstore, int nobs, const double data[], double average[], double error[]);
+
+    // Compute the same directly from n samples x ([n][nobs] layout), in a single sequential pass with O(log2(n)*nobs) memory
+    // (e.g. for samples which don't fit into memory, see MappedFullAccumulator)
+    static void estimateFromSamples(int64_t n, int nobs, const double x[], double average[], double error[]);
+
+    // The same for the data of a CompressedFullAccumulator, whose samples are decoded chunk by chunk (see CompressedSampleReader)
+    static void estimateFromCompressed(int64_t nstore, int nobs, const double data[], double average[], double error[]);
+};
+}  // namespace mci
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef MCI_TRACEFILE_HPP
+#define MCI_TRACEFILE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mci
+{
+// Format of the traces written while sampling (see MCI::storeObservablesOnFile/storeWalkerPositionsOnFile)
+enum class TraceFormat
+{
+    Text, /* one formatted line per record, with step index and values */
+    Binary, /* binary trace file with fixed-size records (see TraceHeader below) */
+    BinaryBlockAverage /* same, but every record holds the average over the freq steps starting at the step index */
+};
+
+// What the values of a trace are
+enum class TraceKind: int32_t
+{
+    Walker, /* walker positions (ndim values) */
+    Observables /* values of all observables (total observable dimension) */
+};
+
+// Header of a binary trace file. It is followed by fixed-size records of one int64_t step index and nvalues doubles,
+// everything in native byte order. The number of records follows from the file size.
+struct TraceHeader
+{
+    static constexpr int32_t VERSION = 1;
+
+    char magic[8]; // "MCITRACE"
+    int32_t version; // format version
+    int32_t kind; // TraceKind
+    int32_t ndim; // dimension of the walker
+    int32_t nvalues; // number of values per record
+    int32_t freq; // one record every freq steps
+    int32_t flag_blockavg; // 1 if the records are block averages over freq steps, else 0
+};
+
+
+// Writes binary trace files. Records are collected in chunks of about 1 MiB, which get written by a background thread,
+// so the sampling loop only copies the values. If the writer falls behind by several chunks, push blocks until it caught up.
+// With block averages, a partially filled last block is dropped on close.
+class TraceWriter
+{
+protected:
+    static constexpr int64_t CHUNK_BYTES = 1 << 20; // approximate size of a chunk
+    static constexpr size_t MAX_QUEUED_CHUNKS = 4; // chunks waiting to be written, before push blocks
+
+    const std::string _filepath;
+    TraceHeader _header;
+    const int64_t _recsize; // size of a record in bytes
+    const int64_t _chunkrecords; // records per chunk
+
+    std::vector<double> _blocksum; // sum of the current block (block average mode only)
+    int _nblock; // number of steps in the current block
+    int64_t _blockstart; // step index of the first step in the current block
+
+    std::vector<unsigned char> _chunk; // chunk being filled
+    int64_t _nchunk; // records in the current chunk
+    int64_t _nrecords; // total number of pushed records
+
+    // shared with the background thread
+    std::ofstream _file;
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::deque<std::vector<unsigned char>> _queue; // filled chunks to write
+    std::vector<std::vector<unsigned char>> _spare; // written chunks for reuse
+    bool _flag_stop; // no more chunks will be queued
+    bool _flag_failed; // did a write fail?
+    std::thread _thread;
+
+    void _run(); // background thread loop
+    void _addRecord(int64_t step, const double values[]); // append record to the current chunk
+    void _handOff(); // pass the current chunk to the background thread
+
+public:
+    TraceWriter(std::string filepath, TraceKind kind, int ndim, int nvalues, int freq, bool flag_blockavg = false);
+    ~TraceWriter(); // closes the file (without throwing)
+
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    // does push need the values of this step? (if not, the caller may skip gathering them)
+    bool needsValues(int64_t step) const { return _header.flag_blockavg != 0 || step%_header.freq == 0; }
+    // pass the values of a step (every step in block average mode, else at least every freq-th step)
+    void push(int64_t step, const double values[]);
+    // write remaining records, wait for the background thread and close the file (throws if writing failed)
+    void close();
+
+    const std::string &getFilePath() const { return _filepath; }
+    const TraceHeader &getHeader() const { return _header; }
+    int64_t getNRecords() const { return _nrecords; }
+};
+
+
+// Reads binary trace files written by TraceWriter (or by any other producer of the same format), in chunks of records.
+// Regular files are memory-mapped, while other files (e.g. named pipes or /dev/stdin) are streamed, i.e. the records
+// are read until the producer closes its end. A truncated last record (e.g. of an aborted run) is ignored.
+class TraceReader
+{
+protected:
+    const std::string _filepath;
+    TraceHeader _header{};
+    int64_t _recsize; // size of a record in bytes
+    int64_t _nrecords; // number of complete records (-1 if unknown, i.e. streamed)
+    int64_t _nread; // records read so far
+    bool _flag_eof; // reached the end of a streamed file?
+
+    int _fd; // file descriptor
+    const unsigned char * _map; // mapped file (nullptr if streamed)
+    size_t _maplen; // length of the mapping in bytes
+    std::vector<unsigned char> _buffer; // read buffer (streamed only)
+
+    int64_t _readBytes(unsigned char out[], int64_t nbytes); // read from stream until nbytes or end of file, returns read bytes
+    void _release(); // unmap and close the file
+
+public:
+    explicit TraceReader(std::string filepath); // throws if the file can't be opened or has an invalid header
+    ~TraceReader() { this->_release(); }
+
+    TraceReader(const TraceReader &) = delete;
+    TraceReader &operator=(const TraceReader &) = delete;
+
+    const std::string &getFilePath() const { return _filepath; }
+    const TraceHeader &getHeader() const { return _header; }
+    TraceKind getKind() const { return static_cast<TraceKind>(_header.kind); }
+    int getNDim() const { return _header.ndim; }
+    int getNValues() const { return _header.nvalues; }
+    int getFreq() const { return _header.freq; }
+    bool isBlockAverage() const { return _header.flag_blockavg != 0; }
+    bool isStreamed() const { return _map == nullptr; }
+    int64_t getNRecords() const { return _nrecords; } // -1 if streamed
+    int64_t getNRead() const { return _nread; }
+    bool done() const { return this->isStreamed() ? _flag_eof : _nread == _nrecords; }
+
+    // read up to nrecords next records into steps (may be nullptr) and values ([nrecords][nvalues]), returns number of read records
+    // (less than nrecords only at the end of the trace)
+    int64_t read(int64_t nrecords, int64_t steps[], double values[]);
+    void rewind(); // start over from the first record (not for streamed files)
+};
+}  // namespace mci
+
+#endif
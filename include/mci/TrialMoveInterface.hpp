@@ -3,8 +3,11 @@
 
 #include "mci/Clonable.hpp"
 #include "mci/ProtoFunctionInterface.hpp"
+#include "mci/RandomGenerator.hpp"
 #include "mci/WalkerState.hpp"
 
+#include <istream>
+#include <ostream>
 #include <random>
 
 namespace mci
@@ -17,14 +20,14 @@ class TrialMoveInterface: public ProtoFunctionInterface, public Clonable<TrialMo
 {
 protected:
     // we share the random generator with MCI, get's passed on bindRGen()
-    std::mt19937_64 * _rgen; // ptr to MCI's rgen
-    std::mt19937_64 * getRGen() const { return _rgen; }
+    RandomGenerator * _rgen; // ptr to MCI's rgen
+    RandomGenerator * getRGen() const { return _rgen; }
 
     TrialMoveInterface(int ndim, int nproto): ProtoFunctionInterface(ndim, nproto), _rgen(nullptr) {}
 
 public:
     // store ptr to MCI's rgen
-    void bindRGen(std::mt19937_64 &rgen)
+    void bindRGen(RandomGenerator &rgen)
     {
         _rgen = &rgen;
     }
@@ -77,7 +80,7 @@ public:
 // distributions which are symmetric around 0. This is done by first
 // generating a x>0 from the given distribution, and then decide on
 // the sign by a draw from bernoulli-distribution.
-// NOTE: Below we consider std::mt19937_64 as the only possible random generator.
+// NOTE: Below we consider mci::RandomGenerator as the only possible random generator.
 template <class PRRD> /* should be positive-real-valued stdlib random dist <double>*/
 struct SymmetrizedPRRD
 {
@@ -90,11 +93,15 @@ public:
     SymmetrizedPRRD() = default;
     explicit SymmetrizedPRRD(PRRD myPRRD) { prrd = myPRRD; }
 
-    double operator()(std::mt19937_64 &rgen)
+    double operator()(RandomGenerator &rgen)
     { // this overload allows it to be used like other random distributions
         const double val = prrd(rgen);
         return (bd(rgen)) ? val : -val; // return + or - val, with same probability
     }
+
+    // stream the wrapped distributions, like the standard ones (used for checkpoints)
+    friend std::ostream &operator<<(std::ostream &os, const SymmetrizedPRRD &srd) { return os << srd.bd << ' ' << srd.prrd; }
+    friend std::istream &operator>>(std::istream &is, SymmetrizedPRRD &srd) { return is >> srd.bd >> srd.prrd; }
 };
 
 
@@ -185,6 +192,31 @@ inline auto createSymRRD<SymmetrizedPRRD<std::fisher_f_distribution<double> > >(
 {
     return SymmetrizedPRRD<std::fisher_f_distribution<double> >(); // use default m=1, n=1
 }
+
+
+// A helper template used to draw from applicable real-valued random distributions
+// with our RandomGenerator. Per default the distribution is called with the generator,
+// but for the uniform and normal distributions we use the generator's buffered doubles
+// (which is considerably faster).
+template <class SRRD /* applicable random dist */>
+inline double drawSymRRD(SRRD &rd, RandomGenerator &rgen) // default specialization
+{
+    return rd(rgen);
+}
+
+// Specialization for uniform
+template <>
+inline double drawSymRRD<std::uniform_real_distribution<double> >(std::uniform_real_distribution<double> &rd, RandomGenerator &rgen)
+{
+    return rd.a() + (rd.b() - rd.a())*rgen.uniform();
+}
+
+// Specialization for gaussian
+template <>
+inline double drawSymRRD<std::normal_distribution<double> >(std::normal_distribution<double> &rd, RandomGenerator &rgen)
+{
+    return rd.mean() + rd.stddev()*rgen.normal();
+}
 }; // namespace mci
 
 #endif
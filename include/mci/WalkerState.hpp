@@ -48,8 +48,29 @@ public:
         needsObs = flag_obs;
     }
 
-    void newToOld() { std::copy(xnew, xnew + ndim, xold); } // on acceptance
-    void oldToNew() { std::copy(xold, xold + ndim, xnew); } // on rejection
+    // commit the step, copying only the changed indices (if nchanged < ndim)
+    void newToOld() // on acceptance
+    {
+        if (nchanged < ndim) {
+            for (int i = 0; i < nchanged; ++i) { xold[changedIdx[i]] = xnew[changedIdx[i]]; }
+        }
+        else {
+            this->newToOldFull();
+        }
+    }
+    void oldToNew() // on rejection
+    {
+        if (nchanged < ndim) {
+            for (int i = 0; i < nchanged; ++i) { xnew[changedIdx[i]] = xold[changedIdx[i]]; }
+        }
+        else {
+            this->oldToNewFull();
+        }
+    }
+
+    // full copies, to be used when xold/xnew were changed outside of a proper move
+    void newToOldFull() { std::copy(xnew, xnew + ndim, xold); }
+    void oldToNewFull() { std::copy(xold, xold + ndim, xnew); }
 };
 } // namespace mci
 
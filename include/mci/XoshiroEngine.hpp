@@ -0,0 +1,67 @@
+#ifndef MCI_XOSHIROENGINE_HPP
+#define MCI_XOSHIROENGINE_HPP
+
+#include "mci/RandomEngineInterface.hpp"
+
+#include <algorithm>
+
+namespace mci
+{
+// The xoshiro256++ engine by D. Blackman and S. Vigna (https://prng.di.unimi.it/).
+// Very fast, with 256 bits of state (period 2^256-1). The state is initialized from
+// the 64-bit seed via splitmix64, as recommended by the authors.
+// Supports independent streams: jump() advances by 2^128 and longJump() by 2^192 outputs.
+// Multiple jumps at once are composed by repeated squaring, i.e. jump(n) costs O(log n). Large discards
+// are done the same way with the one-step matrix, while short ones just step the engine.
+class XoshiroEngine final: public RandomEngineInterface
+{
+protected:
+    uint64_t _s[4]{}; // state
+
+    RandomEngineInterface * _clone() const final
+    {
+        auto * ret = new XoshiroEngine();
+        std::copy(_s, _s + 4, ret->_s);
+        return ret;
+    }
+
+    static uint64_t _rotl(const uint64_t x, const int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t _next()
+    {
+        const uint64_t result = _rotl(_s[0] + _s[3], 23) + _s[0];
+        const uint64_t t = _s[1] << 17;
+        _s[2] ^= _s[0];
+        _s[3] ^= _s[1];
+        _s[1] ^= _s[2];
+        _s[0] ^= _s[3];
+        _s[2] ^= t;
+        _s[3] = _rotl(_s[3], 45);
+        return result;
+    }
+
+    void _jump(const uint64_t jumpPoly[] /*len 4*/); // apply a jump polynomial
+    void _jump(const uint64_t jumpPoly[] /*len 4*/, uint64_t n); // apply it n times, in O(log n)
+
+public:
+    static constexpr uint64_t DISCARD_LOOP_MAX = uint64_t(1) << 20; // below, plain stepping is faster than squaring
+
+    explicit XoshiroEngine(uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(uint64_t seed) final;
+    void generate(uint64_t out[], int n) final
+    {
+        for (int i = 0; i < n; ++i) { out[i] = this->_next(); }
+    }
+    void discard(uint64_t n) final; // O(log n) by repeated squaring, for n > DISCARD_LOOP_MAX
+
+    bool hasIndependentStreams() const final { return true; }
+    void jump(uint64_t n) final; // n times 2^128 steps ahead
+    void longJump(uint64_t n) final; // n times 2^192 steps ahead
+
+    void saveState(std::ostream &out) const final;
+    void loadState(std::istream &in) final;
+};
+}  // namespace mci
+
+#endif
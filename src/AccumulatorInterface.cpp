@@ -1,12 +1,16 @@
 #include "mci/AccumulatorInterface.hpp"
 
+#include "mci/Checkpoint.hpp"
+
+#include <typeinfo>
+
 namespace mci
 {
 
 AccumulatorInterface::AccumulatorInterface(ObservableFunctionInterface &obs, const int nskip):
         _obs(obs), _flag_updobs(_obs.isUpdateable()), _nobs(_obs.getNObs()), _xndim(_obs.getNDim()),
         _nskip(nskip), _obs_values(new double[_nobs]), _flags_xchanged(_flag_updobs ? new bool[_xndim] : nullptr),
-        _nsteps(0), _data(nullptr)
+        _idx_xchanged(_flag_updobs ? new int[_xndim] : nullptr), _nsteps(0), _naccu(0), _data(nullptr)
 {
     if (nskip < 1) { throw std::invalid_argument("[AccumulatorInterface] Provided number of steps per evaluation was < 1 ."); }
     this->_init();
@@ -14,6 +18,7 @@ AccumulatorInterface::AccumulatorInterface(ObservableFunctionInterface &obs, con
 
 AccumulatorInterface::~AccumulatorInterface()
 {
+    delete[] _idx_xchanged;
     delete[] _flags_xchanged;
     delete[] _obs_values;
 }
@@ -59,6 +64,7 @@ void AccumulatorInterface::_processSelective(const WalkerState &wlk)
             for (int i = 0; i < wlk.nchanged; ++i) {
                 if (!_flags_xchanged[wlk.changedIdx[i]]) {
                     _flags_xchanged[wlk.changedIdx[i]] = true;
+                    _idx_xchanged[_nchanged] = wlk.changedIdx[i];
                     ++_nchanged; // increase internal change counter
                 }
             }
@@ -72,12 +78,13 @@ void AccumulatorInterface::_processSelective(const WalkerState &wlk)
         _skipidx = 0;
 
         if (_nchanged < _xndim) { // call optimized recompute
-            _obs.updatedObservable(wlk.xnew, _nchanged, _flags_xchanged, _obs_values);
+            _obs.updatedObservable(wlk.xnew, _nchanged, _idx_xchanged, _flags_xchanged, _obs_values);
+            for (int i = 0; i < _nchanged; ++i) { _flags_xchanged[_idx_xchanged[i]] = false; } // clear only the set flags
         }
         else { // call full obs compute
             _obs.observableFunction(wlk.xnew, _obs_values);
+            std::fill(_flags_xchanged, _flags_xchanged + _xndim, false); // flags may be partially set
         }
-        std::fill(_flags_xchanged, _flags_xchanged + _xndim, false);
         _nchanged = 0;
 
         this->_accumulate(); // call child storage implementation
@@ -92,6 +99,7 @@ void AccumulatorInterface::allocate(const int64_t nsteps)
     if (nsteps < 1) { throw std::invalid_argument("[AccumulatorInterface::allocate] Provided number of MC steps was < 1 ."); }
 
     _nsteps = nsteps;
+    _naccu = 1 + (_nsteps - 1)/_nskip;
     this->_allocate(); // call child allocate
 }
 
@@ -122,6 +130,14 @@ void AccumulatorInterface::finalize()
 }
 
 
+double * AccumulatorInterface::consumeData()
+{
+    if (!_flag_final) { throw std::runtime_error("[AccumulatorInterface::consumeData] Accumulator must be finalized before consuming data."); }
+    _flag_final = false; // the data won't be valid anymore
+    return _data;
+}
+
+
 void AccumulatorInterface::reset()
 {
     this->_reset(); // call child reset
@@ -135,5 +151,88 @@ void AccumulatorInterface::deallocate()
     this->_deallocate(); // call child deallocate
 
     _nsteps = 0;
+    _naccu = 0;
+}
+
+
+void AccumulatorInterface::merge(const AccumulatorInterface &other)
+{
+    if (typeid(*this) != typeid(other)) { throw std::invalid_argument("[AccumulatorInterface::merge] Only accumulators of the same type can be merged."); }
+    if (other._nobs != _nobs || other._nskip != _nskip) {
+        throw std::invalid_argument("[AccumulatorInterface::merge] Accumulators to merge must have equal number of observables and nskip.");
+    }
+    if (!other.isAllocated() || !other._flag_final) { throw std::runtime_error("[AccumulatorInterface::merge] Accumulator to merge must be allocated and finalized."); }
+
+    this->merge(other._nsteps, other._naccu, other.getNStore(), other.getData());
+}
+
+
+void AccumulatorInterface::merge(const int64_t nsteps, const int64_t naccu, const int64_t nstore, const double data[])
+{
+    if (!this->isAllocated() || !_flag_final) { throw std::runtime_error("[AccumulatorInterface::merge] Accumulator must be allocated and finalized before merging."); }
+    if (nsteps < 1 || naccu != 1 + (nsteps - 1)/_nskip) {
+        throw std::invalid_argument("[AccumulatorInterface::merge] Passed number of steps and accumulations are inconsistent.");
+    }
+
+    this->_merge(nstore, naccu, data); // call child merge (still sees the old counters)
+
+    _nsteps += nsteps;
+    _naccu += naccu;
+    _stepidx += nsteps;
+}
+
+
+void AccumulatorInterface::reserveMerge(const int64_t nstore)
+{
+    if (!this->isAllocated() || !_flag_final) { throw std::runtime_error("[AccumulatorInterface::reserveMerge] Accumulator must be allocated and finalized before merging."); }
+    if (nstore < 0) { throw std::invalid_argument("[AccumulatorInterface::reserveMerge] Passed number of elements was < 0 ."); }
+    this->_reserveMerge(nstore); // call child reserve
+}
+
+
+void AccumulatorInterface::saveState(std::ostream &out) const
+{
+    if (!this->isAllocated() || _flag_final) { throw std::runtime_error("[AccumulatorInterface::saveState] Accumulator must be allocated and not finalized."); }
+
+    writeCheckpointString(out, typeid(*this).name());
+    const int dims[3] = {_nobs, _xndim, _nskip};
+    writeCheckpointArray(out, dims, 3);
+    const int64_t counters[3] = {_nsteps, _naccu, _stepidx};
+    writeCheckpointArray(out, counters, 3);
+    writeCheckpointValue(out, _skipidx);
+    writeCheckpointValue(out, _nchanged);
+    writeCheckpointArray(out, _obs_values, _nobs);
+    if (_flag_updobs) {
+        writeCheckpointArray(out, _flags_xchanged, _xndim);
+        writeCheckpointArray(out, _idx_xchanged, _xndim);
+    }
+    this->_saveState(out); // child data
+}
+
+
+void AccumulatorInterface::loadState(std::istream &in)
+{
+    if (!this->isAllocated()) { throw std::runtime_error("[AccumulatorInterface::loadState] Accumulator must be allocated."); }
+
+    expectCheckpointString(in, typeid(*this).name(), "[AccumulatorInterface::loadState] Checkpoint was written by a different type of accumulator.");
+    int dims[3];
+    readCheckpointArray(in, dims, 3);
+    int64_t counters[3];
+    readCheckpointArray(in, counters, 3);
+    if (dims[0] != _nobs || dims[1] != _xndim || dims[2] != _nskip || counters[0] != _nsteps || counters[1] != _naccu) {
+        throw std::invalid_argument("[AccumulatorInterface::loadState] Checkpoint was written by a differently configured or allocated accumulator.");
+    }
+    if (counters[2] < 0 || counters[2] > _nsteps) { throw std::runtime_error("[AccumulatorInterface::loadState] Checkpoint contains an invalid step index."); }
+
+    this->reset();
+    _stepidx = counters[2];
+    _skipidx = readCheckpointValue<int>(in);
+    _nchanged = readCheckpointValue<int>(in);
+    readCheckpointArray(in, _obs_values, _nobs);
+    if (_flag_updobs) {
+        readCheckpointArray(in, _flags_xchanged, _xndim);
+        readCheckpointArray(in, _idx_xchanged, _xndim);
+    }
+    this->_loadState(in); // child data
 }
 }  // namespace mci
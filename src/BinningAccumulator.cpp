@@ -0,0 +1,145 @@
+#include "mci/BinningAccumulator.hpp"
+
+#include "mci/Checkpoint.hpp"
+
+#include <algorithm>
+
+namespace mci
+{
+
+int64_t coarsenBins(const int64_t nbins, const int nobs, double data[])
+{   // average neighbouring bins in place (an odd last bin is dropped), return new number of bins
+    const int64_t nnew = nbins/2;
+    for (int64_t i = 0; i < nnew; ++i) {
+        for (int j = 0; j < nobs; ++j) {
+            data[i*nobs + j] = 0.5*(data[2*i*nobs + j] + data[(2*i + 1)*nobs + j]);
+        }
+    }
+    return nnew;
+}
+
+
+void BinningAccumulator::_compact()
+{   // the bins still contain sums, so we just add them
+    const int64_t nhalf = _nbins/2;
+    for (int64_t i = 0; i < nhalf; ++i) {
+        for (int j = 0; j < _nobs; ++j) {
+            _data[i*_nobs + j] = _data[2*i*_nobs + j] + _data[(2*i + 1)*_nobs + j];
+        }
+    }
+    std::fill(_data + nhalf*_nobs, _data + _nbins*_nobs, 0.);
+
+    _nfull = nhalf;
+    _blocksize *= 2;
+    _storeidx = _nfull*_nobs;
+}
+
+
+void BinningAccumulator::_allocate()
+{
+    _nstore = _nbins;
+    _data = new double[this->getNData()]; // _nbins * _nobs layout
+    std::fill(_data, _data + this->getNData(), 0.);
+}
+
+
+void BinningAccumulator::_accumulate()
+{
+    for (int i = 0; i < _nobs; ++i) {
+        _data[_storeidx + i] += _obs_values[i];
+    }
+
+    if (++_bidx == _blocksize) {
+        _bidx = 0;
+        _storeidx += _nobs; // move to next bin
+        if (++_nfull == _nbins) { this->_compact(); }
+    }
+}
+
+
+void BinningAccumulator::_finalize()
+{   // normalize the full bins and drop the partial one
+    const double normf = 1./_blocksize;
+    for (int64_t i = 0; i < _nfull*_nobs; ++i) {
+        _data[i] *= normf;
+    }
+    _nstore = _nfull;
+}
+
+
+void BinningAccumulator::_reset()
+{   // reset must not fail on deallocated state
+    _blocksize = 1;
+    _nfull = 0;
+    _bidx = 0;
+    _storeidx = 0;
+    if (_data != nullptr) {
+        _nstore = _nbins;
+        std::fill(_data, _data + _nbins*_nobs, 0.);
+    }
+}
+
+
+void BinningAccumulator::_deallocate()
+{
+    delete[] _data;
+    _data = nullptr;
+    _nstore = 0;
+}
+
+
+void BinningAccumulator::_merge(const int64_t nstore, const int64_t naccu, const double data[])
+{
+    if (nstore < 0 || nstore > naccu) { throw std::invalid_argument("[BinningAccumulator::merge] Passed data has an invalid number of bins."); }
+    if (nstore == 0) { return; } // a short run which didn't fill a bin (e.g. a worker chunk), so only the counters are added
+
+    // the other's bins are full, i.e. nstore*blocksize <= naccu < 2*nstore*blocksize
+    int64_t blocksize_other = 1;
+    while (2*blocksize_other*nstore <= naccu) { blocksize_other *= 2; }
+
+    // bring both to the same block size and concatenate
+    auto * const bins = new double[(_nfull + nstore)*_nobs];
+    std::copy(_data, _data + _nfull*_nobs, bins);
+    int64_t nbins = _nfull;
+    for (; _blocksize < blocksize_other; _blocksize *= 2) { nbins = coarsenBins(nbins, _nobs, bins); }
+
+    double * const bins_other = bins + nbins*_nobs;
+    std::copy(data, data + nstore*_nobs, bins_other);
+    int64_t nbins_other = nstore;
+    for (int64_t bs = blocksize_other; bs < _blocksize; bs *= 2) { nbins_other = coarsenBins(nbins_other, _nobs, bins_other); }
+    nbins += nbins_other;
+
+    // like on accumulation, the bins get merged when all are filled
+    for (; nbins >= _nbins; _blocksize *= 2) { nbins = coarsenBins(nbins, _nobs, bins); }
+
+    std::copy(bins, bins + nbins*_nobs, _data);
+    delete[] bins;
+
+    _nfull = nbins;
+    _nstore = nbins;
+    _storeidx = nbins*_nobs;
+}
+
+
+void BinningAccumulator::_saveState(std::ostream &out) const
+{
+    const int64_t state[4] = {_blocksize, _nfull, _bidx, _storeidx};
+    writeCheckpointArray(out, state, 4);
+    writeCheckpointArray(out, _data, this->getNData());
+}
+
+
+void BinningAccumulator::_loadState(std::istream &in)
+{
+    int64_t state[4];
+    readCheckpointArray(in, state, 4);
+    if (state[0] < 1 || state[1] < 0 || state[1] >= _nbins || state[2] < 0 || state[2] >= state[0] || state[3] != state[1]*_nobs) {
+        throw std::runtime_error("[BinningAccumulator::loadState] Checkpoint contains invalid bin indices.");
+    }
+    _blocksize = state[0];
+    _nfull = state[1];
+    _bidx = state[2];
+    _storeidx = state[3];
+    readCheckpointArray(in, _data, this->getNData());
+}
+}  // namespace mci
@@ -1,5 +1,7 @@
 #include "mci/BlockAccumulator.hpp"
 
+#include "mci/Checkpoint.hpp"
+
 namespace mci
 {
 
@@ -12,20 +14,28 @@ void BlockAccumulator::_allocate()
         throw std::invalid_argument("[BlockAccumulator::allocate] Requested number of accumulations is not a multiple of the requested block size.");
     }
     _nblocks = this->getNAccu()/_blocksize;
-    _data = new double[this->getNData()]; // _nstore * _nobs layout
+    _ncapacity = _nblocks;
+    _data = new double[this->getNData()]; // _nstore * _nobs layout (or transposed)
     std::fill(_data, _data + this->getNData(), 0.);
 }
 
 
 void BlockAccumulator::_accumulate()
 {
-    for (int i = 0; i < _nobs; ++i) {
-        _data[_storeidx + i] += _obs_values[i];
+    if (_flag_colmajor) {
+        for (int i = 0; i < _nobs; ++i) {
+            _data[i*_nblocks + _storeidx] += _obs_values[i];
+        }
+    }
+    else {
+        for (int i = 0; i < _nobs; ++i) {
+            _data[_storeidx + i] += _obs_values[i];
+        }
     }
 
     if (++_bidx == _blocksize) {
         _bidx = 0;
-        _storeidx += _nobs; // move to next block
+        _storeidx += _flag_colmajor ? 1 : _nobs; // move to next block
     }
 }
 
@@ -33,10 +43,9 @@ void BlockAccumulator::_accumulate()
 void BlockAccumulator::_finalize()
 {
     const double normf = 1./_blocksize;
-    for (int64_t i = 0; i < _nblocks; ++i) {
-        for (int j = 0; j < _nobs; ++j) {
-            _data[i*_nobs + j] *= normf;
-        }
+    const int64_t ndata = this->getNData(); // the layout doesn't matter here
+    for (int64_t i = 0; i < ndata; ++i) {
+        _data[i] *= normf;
     }
 }
 
@@ -54,5 +63,62 @@ void BlockAccumulator::_deallocate()
     delete[] _data;
     _data = nullptr;
     _nblocks = 0;
+    _ncapacity = 0;
+}
+
+
+void BlockAccumulator::_merge(const int64_t nstore, const int64_t naccu, const double data[])
+{
+    if (nstore*_blocksize != naccu) {
+        throw std::invalid_argument("[BlockAccumulator::merge] Block accumulators to merge must have equal block size.");
+    }
+    const int64_t ndata = this->getNData();
+    if (_flag_colmajor) { // append per column
+        auto * newdata = new double[ndata + nstore*_nobs];
+        for (int i = 0; i < _nobs; ++i) {
+            std::copy(_data + i*_nblocks, _data + (i + 1)*_nblocks, newdata + i*(_nblocks + nstore));
+            std::copy(data + i*nstore, data + (i + 1)*nstore, newdata + i*(_nblocks + nstore) + _nblocks);
+        }
+        delete[] _data;
+        _data = newdata;
+        _ncapacity = _nblocks + nstore;
+    }
+    else {
+        this->_reserveMerge(nstore); // reallocates only if not reserved before
+        std::copy(data, data + nstore*_nobs, _data + ndata); // append other's blocks to ours
+    }
+
+    _nblocks += nstore;
+    _storeidx = _flag_colmajor ? _nblocks : this->getNData();
+}
+
+
+void BlockAccumulator::_reserveMerge(const int64_t nstore)
+{
+    if (_flag_colmajor || _nblocks + nstore <= _ncapacity) { return; } // column-major merges reallocate anyway
+    auto * newdata = new double[(_nblocks + nstore)*_nobs];
+    std::copy(_data, _data + this->getNData(), newdata);
+    delete[] _data;
+    _data = newdata;
+    _ncapacity = _nblocks + nstore;
+}
+
+
+void BlockAccumulator::_saveState(std::ostream &out) const
+{
+    writeCheckpointValue(out, _bidx);
+    writeCheckpointValue(out, _storeidx);
+    writeCheckpointArray(out, _data, this->getNData());
+}
+
+
+void BlockAccumulator::_loadState(std::istream &in)
+{
+    _bidx = readCheckpointValue<int>(in);
+    _storeidx = readCheckpointValue<int64_t>(in);
+    if (_bidx < 0 || _bidx >= _blocksize || _storeidx < 0 || _storeidx > (_flag_colmajor ? _nblocks : this->getNData())) {
+        throw std::runtime_error("[BlockAccumulator::loadState] Checkpoint contains invalid block indices.");
+    }
+    readCheckpointArray(in, _data, this->getNData());
 }
 }  // namespace mci
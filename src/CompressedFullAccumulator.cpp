@@ -0,0 +1,258 @@
+#include "mci/CompressedFullAccumulator.hpp"
+
+#include "mci/Checkpoint.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace mci
+{
+constexpr int CompressedFullAccumulator::HEADER_SIZE; // definition (C++14)
+
+constexpr int COMPRESSED_MIN_CAPACITY = 1024; // minimal number of doubles to allocate
+constexpr int COMPRESSED_MAX_ROWBYTES_PER_VALUE = 9; // header byte + 8 bytes
+constexpr int COMPRESSED_MAX_VARINT_BYTES = 10; // for 64 bit counts
+
+int64_t putVarInt(uint64_t value, unsigned char out[])
+{   // LEB128 encoding, returns number of written bytes
+    int64_t n = 0;
+    for (; value >= 0x80; value >>= 7) { out[n++] = static_cast<unsigned char>(value | 0x80); }
+    out[n++] = static_cast<unsigned char>(value);
+    return n;
+}
+
+uint64_t getVarInt(const unsigned char in[], int64_t &pos)
+{
+    uint64_t value = 0;
+    for (int shift = 0;; shift += 7) {
+        const unsigned char byte = in[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) { return value; }
+    }
+}
+
+int64_t putXORValue(const uint64_t x, unsigned char out[])
+{   // header byte with the number of leading (high nibble) and trailing zero bytes, then the remaining bytes (little endian)
+    int lz = 0;
+    while (lz < 8 && ((x >> (56 - 8*lz)) & 0xff) == 0) { ++lz; }
+    if (lz == 8) {
+        out[0] = 0x80;
+        return 1;
+    }
+    int tz = 0;
+    while (((x >> (8*tz)) & 0xff) == 0) { ++tz; }
+    out[0] = static_cast<unsigned char>((lz << 4) | tz);
+    int64_t n = 1;
+    for (int b = tz; b < 8 - lz; ++b) { out[n++] = static_cast<unsigned char>(x >> (8*b)); }
+    return n;
+}
+
+uint64_t getXORValue(const unsigned char in[], int64_t &pos)
+{
+    const int lz = in[pos] >> 4;
+    const int tz = in[pos] & 0x0f;
+    ++pos;
+    uint64_t x = 0;
+    for (int b = tz; b < 8 - lz; ++b) { x |= static_cast<uint64_t>(in[pos++]) << (8*b); }
+    return x;
+}
+
+
+// --- CompressedFullAccumulator
+
+void CompressedFullAccumulator::_reserve(const int64_t nbytes)
+{
+    const int64_t needed = HEADER_SIZE + (_nbytes + nbytes + 7)/8; // in doubles
+    if (needed <= _capacity) { return; }
+    int64_t newcap = std::max(needed, 2*_capacity);
+    newcap = ((newcap + _nobs - 1)/_nobs)*_nobs; // full rows
+    auto * newdata = new double[newcap];
+    std::copy(_data, _data + _capacity, newdata);
+    std::fill(newdata + _capacity, newdata + newcap, 0.);
+    delete[] _data;
+    _data = newdata;
+    _capacity = newcap;
+}
+
+
+void CompressedFullAccumulator::_flushRepeats()
+{
+    if (_nrepeat < 0) { return; }
+    _reserve(COMPRESSED_MAX_VARINT_BYTES);
+    _nbytes += putVarInt(static_cast<uint64_t>(_nrepeat), reinterpret_cast<unsigned char *>(_data + HEADER_SIZE) + _nbytes);
+    _nrepeat = -1;
+}
+
+
+void CompressedFullAccumulator::_append(const double values[])
+{
+    if (_nrepeat >= 0 && std::memcmp(values, _last, _nobs*sizeof(double)) == 0) { // repetition
+        ++_nrepeat;
+        ++_nsamples;
+        return;
+    }
+
+    this->_flushRepeats();
+    _reserve(static_cast<int64_t>(_nobs)*COMPRESSED_MAX_ROWBYTES_PER_VALUE);
+    unsigned char * const out = reinterpret_cast<unsigned char *>(_data + HEADER_SIZE) + _nbytes;
+    int64_t n = 0;
+    for (int i = 0; i < _nobs; ++i) {
+        uint64_t bits, lastbits;
+        std::memcpy(&bits, values + i, sizeof(double));
+        std::memcpy(&lastbits, _last + i, sizeof(double));
+        n += putXORValue(bits ^ lastbits, out + n);
+    }
+    _nbytes += n;
+    std::copy(values, values + _nobs, _last);
+    _nrepeat = 0;
+    ++_nsamples;
+}
+
+
+void CompressedFullAccumulator::_updateHeader()
+{
+    _data[0] = static_cast<double>(_nsamples);
+    _data[1] = static_cast<double>(_nbytes);
+    _nstore = (HEADER_SIZE + (_nbytes + 7)/8 + _nobs - 1)/_nobs;
+}
+
+
+void CompressedFullAccumulator::_allocate()
+{
+    _capacity = ((std::max<int64_t>(COMPRESSED_MIN_CAPACITY, HEADER_SIZE) + _nobs - 1)/_nobs)*_nobs;
+    _data = new double[_capacity];
+    std::fill(_data, _data + _capacity, 0.);
+    std::fill(_last, _last + _nobs, 0.); // the first sample is XOR-ed with zeros, i.e. stored as is
+    this->_updateHeader();
+}
+
+
+void CompressedFullAccumulator::_accumulate()
+{
+    this->_append(_obs_values);
+}
+
+
+void CompressedFullAccumulator::_finalize()
+{
+    this->_flushRepeats();
+    this->_updateHeader();
+}
+
+
+void CompressedFullAccumulator::_reset()
+{   // reset must not fail on deallocated state
+    _nbytes = 0;
+    _nsamples = 0;
+    _nrepeat = -1;
+    std::fill(_last, _last + _nobs, 0.);
+    if (_data != nullptr) {
+        std::fill(_data, _data + _capacity, 0.);
+        this->_updateHeader();
+    }
+}
+
+
+void CompressedFullAccumulator::_deallocate()
+{
+    delete[] _data;
+    _data = nullptr;
+    _capacity = 0;
+    _nstore = 0;
+}
+
+
+void CompressedFullAccumulator::_merge(const int64_t nstore, const int64_t naccu, const double data[])
+{
+    CompressedSampleReader reader(nstore, _nobs, data);
+    if (reader.getNSamples() != naccu) {
+        throw std::invalid_argument("[CompressedFullAccumulator::merge] Passed data must contain one element per accumulated step.");
+    }
+
+    // decode the other's samples and append them to ours (i.e. they get XOR-ed against our last sample)
+    const int64_t NCHUNK = 256;
+    auto * const chunk = new double[NCHUNK*_nobs];
+    for (int64_t nrows = reader.read(NCHUNK, chunk); nrows > 0; nrows = reader.read(NCHUNK, chunk)) {
+        for (int64_t i = 0; i < nrows; ++i) { this->_append(chunk + i*_nobs); }
+    }
+    delete[] chunk;
+
+    this->_flushRepeats();
+    this->_updateHeader();
+}
+
+
+// --- CompressedSampleReader
+
+CompressedSampleReader::CompressedSampleReader(const int64_t nstore, const int nobs, const double data[]):
+        _nobs(nobs), _nsamples(0), _nbytes(0), _stream(reinterpret_cast<const unsigned char *>(data + CompressedFullAccumulator::HEADER_SIZE)),
+        _pos(0), _nread(0), _nrepeat(0), _row(new double[nobs])
+{
+    if (nstore*nobs < CompressedFullAccumulator::HEADER_SIZE) {
+        throw std::invalid_argument("[CompressedSampleReader] Passed data is too short to contain the header.");
+    }
+    _nsamples = static_cast<int64_t>(data[0]);
+    _nbytes = static_cast<int64_t>(data[1]);
+    if (_nsamples < 0 || _nbytes < 0 || CompressedFullAccumulator::HEADER_SIZE + (_nbytes + 7)/8 > nstore*nobs) {
+        throw std::invalid_argument("[CompressedSampleReader] Passed data has an invalid header.");
+    }
+    this->rewind();
+}
+
+
+void CompressedSampleReader::rewind()
+{
+    _pos = 0;
+    _nread = 0;
+    _nrepeat = 0;
+    std::fill(_row.get(), _row.get() + _nobs, 0.);
+}
+
+
+int64_t CompressedSampleReader::read(const int64_t nrows, double out[])
+{
+    int64_t n = 0;
+    for (; n < nrows && _nread < _nsamples; ++n, ++_nread) {
+        if (_nrepeat == 0) { // decode the next stored sample and its repetition count
+            if (_pos >= _nbytes) { throw std::runtime_error("[CompressedSampleReader::read] Unexpected end of the encoded data."); }
+            for (int i = 0; i < _nobs; ++i) {
+                uint64_t bits;
+                std::memcpy(&bits, _row.get() + i, sizeof(double));
+                bits ^= getXORValue(_stream, _pos);
+                std::memcpy(_row.get() + i, &bits, sizeof(double));
+            }
+            _nrepeat = 1 + static_cast<int64_t>(getVarInt(_stream, _pos));
+        }
+        std::copy(_row.get(), _row.get() + _nobs, out + n*_nobs);
+        --_nrepeat;
+    }
+    return n;
+}
+
+
+void CompressedFullAccumulator::_saveState(std::ostream &out) const
+{   // only the encoded stream, the header is rewritten on finalize
+    const int64_t state[3] = {_nbytes, _nsamples, _nrepeat};
+    writeCheckpointArray(out, state, 3);
+    writeCheckpointArray(out, _last, _nobs);
+    writeCheckpointArray(out, reinterpret_cast<const unsigned char *>(_data + HEADER_SIZE), _nbytes);
+}
+
+
+void CompressedFullAccumulator::_loadState(std::istream &in)
+{
+    int64_t state[3];
+    readCheckpointArray(in, state, 3);
+    if (state[0] < 0 || state[1] < 0 || state[2] < -1) {
+        throw std::runtime_error("[CompressedFullAccumulator::loadState] Checkpoint contains invalid stream counters.");
+    }
+    readCheckpointArray(in, _last, _nobs);
+    this->_reserve(state[0]); // we are reset, i.e. _nbytes is 0
+    readCheckpointArray(in, reinterpret_cast<unsigned char *>(_data + HEADER_SIZE), state[0]);
+    _nbytes = state[0];
+    _nsamples = state[1];
+    _nrepeat = state[2];
+    this->_updateHeader();
+}
+}  // namespace mci
@@ -0,0 +1,157 @@
+#include "mci/CovarianceAccumulator.hpp"
+
+#include "mci/Checkpoint.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mci
+{
+
+void CovarianceAccumulator::_addBlock()
+{   // Welford's update, with the co-moment increment (n-1)/n * delta_i*delta_j (computed symmetrically)
+    double * const mean = _data + MEAN*_nobs;
+    double * const count = _data + COUNT*_nobs;
+    double * const comoment = _data + COMOMENT*_nobs;
+
+    const double n = count[0] + 1.;
+    const double normf = 1./_blocksize;
+    for (int i = 0; i < _nobs; ++i) {
+        _delta[i] = _blocksum[i]*normf - mean[i];
+        mean[i] += _delta[i]/n;
+        count[i] = n;
+    }
+    const double f = (n - 1.)/n;
+    for (int i = 0; i < _nobs; ++i) {
+        double * const row = comoment + i*_nobs;
+        for (int j = 0; j < _nobs; ++j) {
+            row[j] += f*(_delta[i]*_delta[j]);
+        }
+    }
+    std::fill(_blocksum, _blocksum + _nobs, 0.);
+}
+
+
+void CovarianceAccumulator::_allocate()
+{
+    if (this->getNAccu() < _blocksize) {
+        throw std::invalid_argument("[CovarianceAccumulator::allocate] Requested number of accumulations is smaller than the requested block size.");
+    }
+    _nstore = COMOMENT + _nobs;
+    _data = new double[this->getNData()]; // (COMOMENT + _nobs) * _nobs layout
+    std::fill(_data, _data + this->getNData(), 0.);
+}
+
+
+void CovarianceAccumulator::_accumulate()
+{
+    for (int i = 0; i < _nobs; ++i) {
+        _blocksum[i] += _obs_values[i];
+    }
+
+    if (++_bidx == _blocksize) {
+        _bidx = 0;
+        this->_addBlock();
+    }
+}
+
+
+void CovarianceAccumulator::_finalize()
+{   // drop the partial block
+    _bidx = 0;
+    std::fill(_blocksum, _blocksum + _nobs, 0.);
+}
+
+
+void CovarianceAccumulator::_reset()
+{   // reset must not fail on deallocated state
+    _bidx = 0;
+    std::fill(_blocksum, _blocksum + _nobs, 0.);
+    if (_data != nullptr) {
+        std::fill(_data, _data + this->getNData(), 0.);
+    }
+}
+
+
+void CovarianceAccumulator::_deallocate()
+{
+    delete[] _data;
+    _data = nullptr;
+    _nstore = 0;
+}
+
+
+void CovarianceAccumulator::_merge(const int64_t nstore, const int64_t naccu, const double data[])
+{
+    if (nstore != COMOMENT + _nobs) {
+        throw std::invalid_argument("[CovarianceAccumulator::merge] Passed data has an invalid number of rows.");
+    }
+    const double nb = data[COUNT*_nobs];
+    const auto nblocks_other = static_cast<int64_t>(nb);
+    if (nblocks_other*_blocksize > naccu || (nblocks_other + 1)*_blocksize <= naccu) {
+        throw std::invalid_argument("[CovarianceAccumulator::merge] Covariance accumulators to merge must have equal block size.");
+    }
+    if (nb == 0.) { return; } // nothing to add
+
+    double * const mean = _data + MEAN*_nobs;
+    double * const count = _data + COUNT*_nobs;
+    double * const comoment = _data + COMOMENT*_nobs;
+    const double na = count[0];
+    const double n = na + nb;
+    for (int i = 0; i < _nobs; ++i) {
+        _delta[i] = data[MEAN*_nobs + i] - mean[i];
+        mean[i] += _delta[i]*nb/n;
+        count[i] = n;
+    }
+    const double f = na*nb/n;
+    for (int i = 0; i < _nobs; ++i) {
+        for (int j = 0; j < _nobs; ++j) {
+            comoment[i*_nobs + j] += data[(COMOMENT + i)*_nobs + j] + f*(_delta[i]*_delta[j]);
+        }
+    }
+}
+
+
+void CovarianceAccumulator::estimate(const int64_t nstore, const int nobs, const double data[], double average[], double error[])
+{
+    const double n = (nstore == COMOMENT + nobs) ? data[COUNT*nobs] : 0.;
+    if (n < 2.) {
+        throw std::invalid_argument("[CovarianceAccumulator::estimate] At least two accumulated blocks are required.");
+    }
+    const double normf = 1./(n*(n - 1.));
+    for (int j = 0; j < nobs; ++j) {
+        average[j] = data[MEAN*nobs + j];
+        error[j] = sqrt(std::max(0., data[(COMOMENT + j)*nobs + j]*normf));
+    }
+}
+
+
+void CovarianceAccumulator::covariance(const int64_t nstore, const int nobs, const double data[], double cov[])
+{
+    const double n = (nstore == COMOMENT + nobs) ? data[COUNT*nobs] : 0.;
+    if (n < 2.) {
+        throw std::invalid_argument("[CovarianceAccumulator::covariance] At least two accumulated blocks are required.");
+    }
+    const double normf = 1./(n*(n - 1.));
+    for (int64_t i = 0; i < static_cast<int64_t>(nobs)*nobs; ++i) {
+        cov[i] = data[COMOMENT*nobs + i]*normf;
+    }
+}
+
+
+void CovarianceAccumulator::_saveState(std::ostream &out) const
+{
+    writeCheckpointValue(out, _bidx);
+    writeCheckpointArray(out, _blocksum, _nobs);
+    writeCheckpointArray(out, _data, this->getNData());
+}
+
+
+void CovarianceAccumulator::_loadState(std::istream &in)
+{
+    _bidx = readCheckpointValue<int>(in);
+    if (_bidx < 0 || _bidx >= _blocksize) { throw std::runtime_error("[CovarianceAccumulator::loadState] Checkpoint contains an invalid block index."); }
+    readCheckpointArray(in, _blocksum, _nobs);
+    readCheckpointArray(in, _data, this->getNData());
+}
+}  // namespace mci
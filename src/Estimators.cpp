@@ -1,10 +1,23 @@
 #include "mci/Estimators.hpp"
+#include "mci/CompressedFullAccumulator.hpp"
 #include "mci/MJBlocker.hpp"
+#include "mci/SIMDKernels.hpp"
+#include "mci/StreamBlockAccumulator.hpp"
+#include "mci/CovarianceAccumulator.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <complex>
 #include <numeric>
 #include <string>
 #include <stdexcept>
+#include <vector>
+
+// settings of Francesco's auto blocker
+const int FC_MIN_BLOCKS = 6, FC_MAX_BLOCKS = 50; // range of the number of blocks
+const int FC_MAX_PLATEAU_AVERAGE = 4; // plateau deltas are computed over up to this many neighbours on each side
+const int FC_NBLOCKINGS = FC_MAX_BLOCKS - FC_MIN_BLOCKS + 1;
+const int FC_NDELTAS = FC_NBLOCKINGS - 2*FC_MAX_PLATEAU_AVERAGE;
 
 double calcErrDelta(const int mode, const double err[9])
 {   // for Francesco's plateau finding algorithm
@@ -30,9 +43,124 @@ double calcErrDelta(const int mode, const double err[9])
     }
 }
 
+void calcFCBlockings(const int64_t n, const int ndim, const double x[], const int minBlocks, const int maxBlocks, double av[], double err[],
+                     mci::EstimatorWorkspace &ws)
+{   // for Francesco's blocker: averages/errors for all nblocks in [minBlocks, maxBlocks], from a single pass over the data
+    // collect the unique block boundaries of all blockings (the rest beyond n/nblocks*nblocks is ignored)
+    std::vector<int64_t> &bounds = ws.fcbounds;
+    bounds.clear();
+    for (int nblocks = minBlocks; nblocks <= maxBlocks; ++nblocks) {
+        const int64_t nperblock = n/nblocks;
+        for (int64_t i = 0; i <= nblocks; ++i) { bounds.push_back(i*nperblock); }
+    }
+    std::sort(bounds.begin(), bounds.end());
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+    // sum up the data segments between the boundaries
+    const auto nseg = static_cast<int64_t>(bounds.size()) - 1;
+    std::vector<double> &segsum = ws.fcsegsum;
+    segsum.resize(static_cast<size_t>(nseg*ndim));
+    for (int64_t s = 0; s < nseg; ++s) {
+        mci::sumColumns(bounds[s + 1] - bounds[s], ndim, x + bounds[s]*ndim, segsum.data() + s*ndim, nullptr);
+    }
+
+    // every block consists of consecutive segments
+    std::vector<double> &blockav = ws.blockav;
+    blockav.resize(static_cast<size_t>(maxBlocks*ndim));
+    for (int nblocks = minBlocks; nblocks <= maxBlocks; ++nblocks) {
+        const int64_t nperblock = n/nblocks;
+        const double norm = 1./nperblock;
+        int64_t s = 0;
+        for (int64_t i = 0; i < nblocks; ++i) {
+            std::fill(blockav.begin() + i*ndim, blockav.begin() + (i + 1)*ndim, 0.);
+            for (; bounds[s] < (i + 1)*nperblock; ++s) {
+                for (int j = 0; j < ndim; ++j) { blockav[i*ndim + j] += segsum[s*ndim + j]; }
+            }
+            for (int j = 0; j < ndim; ++j) { blockav[i*ndim + j] *= norm; }
+        }
+        mci::MultiDimUncorrelatedEstimator(nblocks, ndim, blockav.data(), av + (nblocks - minBlocks)*ndim, err + (nblocks - minBlocks)*ndim);
+    }
+}
+
+
+void fftRadix2(std::vector<std::complex<double>> &a, const bool inverse, std::vector<std::complex<double>> &twiddle)
+{   // in-place iterative radix-2 FFT (a.size() must be a power of 2), the inverse is not normalized
+    // twiddle holds the forward twiddle factors and is only recomputed if the length changed
+    const size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; ++i) { // bit reversal permutation
+        size_t bit = n >> 1;
+        for (; (j & bit) != 0; bit >>= 1) { j ^= bit; }
+        j ^= bit;
+        if (i < j) { std::swap(a[i], a[j]); }
+    }
+
+    if (twiddle.size() != n/2) { // exact twiddle factors, to avoid error accumulation
+        constexpr double PI = 3.14159265358979323846; // M_PI is not standard C++
+        twiddle.resize(n/2);
+        for (size_t k = 0; k < n/2; ++k) { twiddle[k] = std::polar(1., -2.*PI*k/n); }
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const size_t tstride = n/len;
+        for (size_t i = 0; i < n; i += len) {
+            for (size_t k = 0; k < len/2; ++k) {
+                const std::complex<double> u = a[i + k];
+                const std::complex<double> w = twiddle[k*tstride];
+                const std::complex<double> v = a[i + k + len/2]*(inverse ? std::conj(w) : w);
+                a[i + k] = u + v;
+                a[i + k + len/2] = u - v;
+            }
+        }
+    }
+}
+
+double calcAutocorrTime(const int64_t n, const int ndim, const double x[], const double mean,
+                        std::vector<std::complex<double>> &buf, std::vector<std::complex<double>> &twiddle)
+{   // integrated autocorrelation time tau = 1 + 2*sum_t rho(t) of the x[i*ndim] data (via FFT), with Sokal's window
+    const double SOKAL_C = 5.;
+    std::fill(buf.begin(), buf.end(), std::complex<double>(0.));
+    for (int64_t i = 0; i < n; ++i) { buf[i] = x[i*ndim] - mean; } // zero padded to avoid circular correlation
+
+    fftRadix2(buf, false, twiddle);
+    for (auto &c : buf) { c = std::norm(c); }
+    fftRadix2(buf, true, twiddle); // now buf[t].real() is (unnormalized) autocovariance at lag t
+
+    const double c0 = buf[0].real();
+    if (c0 <= 0.) { return 1.; } // constant data
+    double tau = 1.;
+    for (int64_t t = 1; t < n; ++t) {
+        tau += 2.*buf[t].real()/c0;
+        if (t >= SOKAL_C*tau) { break; } // the window is large enough
+    }
+    return std::max(tau, 1./n); // for anticorrelated data tau may become very small
+}
+
 
 namespace mci
 {
+// --- Workspace
+
+void EstimatorWorkspace::reserveFCBlocker(const int ndim)
+{
+    blockav.reserve(static_cast<size_t>(FC_MAX_BLOCKS*ndim));
+    fcav.resize(static_cast<size_t>(FC_NBLOCKINGS*ndim));
+    fcerr.resize(static_cast<size_t>(FC_NBLOCKINGS*ndim));
+    fcaccdelta.resize(static_cast<size_t>(FC_NDELTAS*ndim));
+    fcimin.resize(static_cast<size_t>(ndim));
+}
+
+MJBlocker &EstimatorWorkspace::getMJBlocker(const int64_t ndata, const int ndim, const bool in_place)
+{
+    if (!mjblk || mjblk->ndata != ndata || mjblk->ndim != ndim || mjblk->inPlace != in_place) {
+        mjblk.reset(); // free the old one first
+        mjblk.reset(new MJBlocker(ndata, ndim, in_place));
+    }
+    return *mjblk;
+}
+
+
+// --- Estimators
+
 void OneDimUncorrelatedEstimator(const int64_t n, const double x[], double &average, double &error)
 {
     if (n < 2) {
@@ -57,6 +185,12 @@ void OneDimUncorrelatedEstimator(const int64_t n, const double x[], double &aver
 
 
 void OneDimBlockEstimator(const int64_t n, const double x[], const int64_t nblocks, double &average, double &error)
+{
+    EstimatorWorkspace ws;
+    OneDimBlockEstimator(n, x, nblocks, average, error, ws);
+}
+
+void OneDimBlockEstimator(const int64_t n, const double x[], const int64_t nblocks, double &average, double &error, EstimatorWorkspace &ws)
 {
     if (n < nblocks) {
         throw std::invalid_argument("[OneDimBlockEstimator] n must be >= nblocks");
@@ -65,39 +199,41 @@ void OneDimBlockEstimator(const int64_t n, const double x[], const int64_t nbloc
     const int64_t nperblock = n/nblocks; // if there is a rest, it is ignored
     const double norm = 1./nperblock;
 
-    auto av = new double[nblocks];
+    ws.blockav.resize(static_cast<size_t>(nblocks));
+    double * const av = ws.blockav.data();
     for (int64_t i1 = 0; i1 < nblocks; ++i1) {
         av[i1] = std::accumulate(x + i1*nperblock, x + (i1 + 1)*nperblock, 0.);
         av[i1] *= norm;
     }
 
     OneDimUncorrelatedEstimator(nblocks, av, average, error);
-    delete[] av;
 }
 
 
 // The original default auto-blocker, implemented by Francesco Calcavecchia.
 // In the factory default we now use our adaption of Marius Johnssons blocker
-// (see MJBlocker.hpp), whenever ndata is a power of 2.
+// (see MJBlocker.hpp).
 void OneDimFCBlockerEstimator(const int64_t n, const double x[], double &average, double &error)
 {
-    const int MIN_BLOCKS = 6, MAX_BLOCKS = 50;
-    const int MAX_PLATEAU_AVERAGE = 4;
+    EstimatorWorkspace ws;
+    OneDimFCBlockerEstimator(n, x, average, error, ws);
+}
+
+void OneDimFCBlockerEstimator(const int64_t n, const double x[], double &average, double &error, EstimatorWorkspace &ws)
+{
+    const int MIN_BLOCKS = FC_MIN_BLOCKS, MAX_BLOCKS = FC_MAX_BLOCKS;
+    const int MAX_PLATEAU_AVERAGE = FC_MAX_PLATEAU_AVERAGE;
 
     if (n < MAX_BLOCKS) {
         throw std::invalid_argument("[OneDimFCBlockerEstimator] n must be >= " + std::to_string(MAX_BLOCKS));
     }
 
-    const int nav = MAX_BLOCKS - MIN_BLOCKS + 1;
+    const int nav = FC_NBLOCKINGS;
     double av[nav];
     double err[nav];
-    for (int i1 = 0; i1 < nav; ++i1) {
-        const int nblocks = i1 + MIN_BLOCKS;
-        OneDimBlockEstimator(n, x, nblocks, av[i1], err[i1]);
-        //std::cout << "Nblocks = " << nblocks << "   average = " << av[i1] << "   error = " << err[i1] << std::endl;
-    }
+    calcFCBlockings(n, 1, x, MIN_BLOCKS, MAX_BLOCKS, av, err, ws); // all blockings in one pass
 
-    const int naccd = nav - 2*MAX_PLATEAU_AVERAGE;
+    const int naccd = FC_NDELTAS;
     double accdelta[naccd];
     std::fill(accdelta, accdelta + naccd, 0.);
     for (int i2 = MAX_PLATEAU_AVERAGE; i2 < naccd + MAX_PLATEAU_AVERAGE; ++i2) {
@@ -130,19 +266,35 @@ void MultiDimUncorrelatedEstimator(const int64_t n, const int ndim, const double
 
     const double SMALLEST_ERROR = 1.e-300;
 
-    std::fill(average, average + ndim, 0.);
-    std::fill(error, error + ndim, 0.);
+    sumColumns(n, ndim, x, average, error); // vectorized sums and sums of squares (see SIMDKernels.hpp)
 
-    for (int64_t i = 0; i < n; ++i) {
-        for (int j = 0; j < ndim; ++j) {
-            average[j] += x[i*ndim + j];
-            error[j] += x[i*ndim + j]*x[i*ndim + j];
+    const double norm = 1./n;
+    const double norm2 = 1./(n - 1.);
+    for (int j = 0; j < ndim; ++j) {
+        average[j] *= norm;
+        error[j] = error[j]*norm - average[j]*average[j];
+        if (error[j] > SMALLEST_ERROR) {
+            error[j] = sqrt(error[j]*norm2);
+        }
+        else {
+            error[j] = 0.;
         }
     }
+}
+
+
+void ColumnMajorUncorrelatedEstimator(const int64_t n, const int ndim, const double x[], double average[], double error[])
+{
+    if (n < 2) {
+        throw std::invalid_argument("[ColumnMajorUncorrelatedEstimator] n must be larger than 1");
+    }
+
+    const double SMALLEST_ERROR = 1.e-300;
 
     const double norm = 1./n;
     const double norm2 = 1./(n - 1.);
     for (int j = 0; j < ndim; ++j) {
+        sumContiguous(n, x + j*n, average[j], error + j); // vectorized along the column (see SIMDKernels.hpp)
         average[j] *= norm;
         error[j] = error[j]*norm - average[j]*average[j];
         if (error[j] > SMALLEST_ERROR) {
@@ -156,6 +308,13 @@ void MultiDimUncorrelatedEstimator(const int64_t n, const int ndim, const double
 
 
 void MultiDimBlockEstimator(const int64_t n, const int ndim, const double x[], const int64_t nblocks, double average[], double error[])
+{
+    EstimatorWorkspace ws;
+    MultiDimBlockEstimator(n, ndim, x, nblocks, average, error, ws);
+}
+
+void MultiDimBlockEstimator(const int64_t n, const int ndim, const double x[], const int64_t nblocks, double average[], double error[],
+                            EstimatorWorkspace &ws)
 {   // we create an explicit multidimensional implementation, for better efficiency
     if (n < nblocks) {
         throw std::invalid_argument("MCI error MultiDimBlockEstimator() : n must be >= nblocks");
@@ -165,54 +324,47 @@ void MultiDimBlockEstimator(const int64_t n, const int ndim, const double x[], c
     const double norm = 1./nperblock;
     const int64_t ndata = nblocks*ndim;
 
-    auto * av = new double[ndata]; // let's play it safe and heap-allocate
-    std::fill(av, av + ndata, 0.);
+    ws.blockav.resize(static_cast<size_t>(ndata));
+    double * const av = ws.blockav.data();
 
-    for (int64_t i1 = 0; i1 < nblocks; ++i1) {
-        for (int64_t i2 = i1*nperblock; i2 < (i1 + 1)*nperblock; ++i2) {
-            for (int j = 0; j < ndim; ++j) {
-                av[i1*ndim + j] += x[i2*ndim + j];
-            }
-        }
+    for (int64_t i1 = 0; i1 < nblocks; ++i1) { // vectorized block sums
+        sumColumns(nperblock, ndim, x + i1*nperblock*ndim, av + i1*ndim, nullptr);
     }
     for (int64_t i = 0; i < ndata; ++i) {
         av[i] *= norm;
     }
 
     MultiDimUncorrelatedEstimator(nblocks, ndim, av, average, error);
-
-    delete[] av;
 }
 
 
 // The original default auto-blocker, implemented by Francesco Calcavecchia.
 // In the factory default we now use our adaption of Marius Johnssons blocker
-// (see MJBlocker.hpp), whenever ndata is a power of 2.
+// (see MJBlocker.hpp).
 void MultiDimFCBlockerEstimator(const int64_t n, const int ndim, const double x[], double average[], double error[])
+{
+    EstimatorWorkspace ws;
+    MultiDimFCBlockerEstimator(n, ndim, x, average, error, ws);
+}
+
+void MultiDimFCBlockerEstimator(const int64_t n, const int ndim, const double x[], double average[], double error[], EstimatorWorkspace &ws)
 {   // we create an explicit multidimensional implementation, for better efficiency
-    const int MIN_BLOCKS = 6, MAX_BLOCKS = 50;
-    const int MAX_PLATEAU_AVERAGE = 4;
+    const int MIN_BLOCKS = FC_MIN_BLOCKS, MAX_BLOCKS = FC_MAX_BLOCKS;
+    const int MAX_PLATEAU_AVERAGE = FC_MAX_PLATEAU_AVERAGE;
 
     if (n < MAX_BLOCKS) {
         throw std::invalid_argument("MCI error MultiDimFCBlockerEstimator() : n must be >= " + std::to_string(MAX_BLOCKS));
     }
 
-    const int nav = MAX_BLOCKS - MIN_BLOCKS + 1;
-    const int nav_total = nav*ndim;
-    auto * av = new double[nav_total];
-    auto * err = new double[nav_total];
-
-    for (int i1 = 0; i1 < nav; ++i1) {
-        const int nblocks = i1 + MIN_BLOCKS;
-        MultiDimBlockEstimator(n, ndim, x, nblocks, av + i1*ndim, err + i1*ndim);
-    }
+    ws.reserveFCBlocker(ndim); // no-op if the workspace was prepared for this ndim
+    double * const av = ws.fcav.data();
+    double * const err = ws.fcerr.data();
 
-    double delta[ndim];
-    std::fill(delta, delta + ndim, 0.);
+    calcFCBlockings(n, ndim, x, MIN_BLOCKS, MAX_BLOCKS, av, err, ws); // all blockings in one pass
 
-    const int naccd = nav - 2*MAX_PLATEAU_AVERAGE;
+    const int naccd = FC_NDELTAS;
     const int naccd_total = naccd*ndim;
-    auto * accdelta = new double[naccd_total];
+    double * const accdelta = ws.fcaccdelta.data();
     std::fill(accdelta, accdelta + naccd_total, 0.);
 
     double errh[9]; // unfortunately we need to copy some values for passing
@@ -225,7 +377,7 @@ void MultiDimFCBlockerEstimator(const int64_t n, const int ndim, const double x[
         }
     }
 
-    int i_min[ndim];
+    int * const i_min = ws.fcimin.data();
     std::fill(i_min, i_min + ndim, 0);
     for (int i2 = 1; i2 < MAX_BLOCKS - MIN_BLOCKS + 1 - 2*MAX_PLATEAU_AVERAGE; ++i2) {
         for (int j = 0; j < ndim; ++j) {
@@ -239,10 +391,6 @@ void MultiDimFCBlockerEstimator(const int64_t n, const int ndim, const double x[
         average[j] = 0.2*(av[(index - 2)*ndim + j] + av[(index - 1)*ndim + j] + av[index*ndim + j] + av[(index + 1)*ndim + j] + av[(index + 2)*ndim + j]);
         error[j] = 0.2*(err[(index - 2)*ndim + j] + err[(index - 1)*ndim + j] + err[index*ndim + j] + err[(index + 1)*ndim + j] + err[(index + 2)*ndim + j]);
     }
-
-    delete[] accdelta;
-    delete[] err;
-    delete[] av;
 }
 
 
@@ -258,12 +406,18 @@ void UncorrelatedEstimator(const int64_t n, const int ndim, const double x[], do
 }
 
 void FCBlockerEstimator(const int64_t n, const int ndim, const double x[], double average[], double error[])
+{
+    EstimatorWorkspace ws;
+    FCBlockerEstimator(n, ndim, x, average, error, ws);
+}
+
+void FCBlockerEstimator(const int64_t n, const int ndim, const double x[], double average[], double error[], EstimatorWorkspace &ws)
 {
     if (ndim > 1) {
-        MultiDimFCBlockerEstimator(n, ndim, x, average, error);
+        MultiDimFCBlockerEstimator(n, ndim, x, average, error, ws);
     }
     else {
-        OneDimFCBlockerEstimator(n, x, average[0], error[0]);
+        OneDimFCBlockerEstimator(n, x, average[0], error[0], ws);
     }
 }
 
@@ -274,17 +428,137 @@ void MJBlockerEstimator(int64_t n, int ndim, const double x[], double average[],
     mjblk.estimate(x, average, error); // run the algorithm
 }
 
-// If n power of 2, use MJBlocker, else FCBlocker
+void MJBlockerEstimator(int64_t n, int ndim, const double x[], double average[], double error[], EstimatorWorkspace &ws)
+{
+    ws.getMJBlocker(n, ndim, false).estimate(x, average, error); // reuse the MJBlocker object, if possible
+}
+
+// The same, but evaluated on the level sums of a StreamBlockAccumulator
+void StreamMJBlockerEstimator(int64_t nstore, int ndim, const double x[], double average[], double error[])
+{
+    StreamBlockAccumulator::estimate(nstore, ndim, x, average, error);
+}
+
+// The same, but with the level sums computed from the samples on the fly
+void MJBlockerSinglePassEstimator(const int64_t n, const int ndim, const double x[], double average[], double error[])
+{
+    StreamBlockAccumulator::estimateFromSamples(n, ndim, x, average, error);
+}
+
+// Single pass estimators on compressed samples
+void CompressedUncorrelatedEstimator(const int64_t nstore, const int ndim, const double x[], double average[], double error[])
+{
+    CompressedSampleReader reader(nstore, ndim, x);
+    const int64_t n = reader.getNSamples();
+    if (n < 2) {
+        throw std::invalid_argument("[CompressedUncorrelatedEstimator] n must be larger than 1");
+    }
+
+    const double SMALLEST_ERROR = 1.e-300;
+
+    const int64_t nchunk = std::max<int64_t>(1, CompressedSampleReader::CHUNK_SIZE/ndim); // rows per chunk
+    std::vector<double> chunk(static_cast<size_t>(std::min(nchunk, n)*ndim));
+    std::vector<double> sum(static_cast<size_t>(ndim)), sumsq(static_cast<size_t>(ndim));
+    std::fill(average, average + ndim, 0.);
+    std::fill(error, error + ndim, 0.);
+    for (int64_t nrows = reader.read(nchunk, chunk.data()); nrows > 0; nrows = reader.read(nchunk, chunk.data())) {
+        sumColumns(nrows, ndim, chunk.data(), sum.data(), sumsq.data());
+        for (int j = 0; j < ndim; ++j) {
+            average[j] += sum[j];
+            error[j] += sumsq[j];
+        }
+    }
+
+    const double norm = 1./n; // like MultiDimUncorrelatedEstimator
+    const double norm2 = 1./(n - 1.);
+    for (int j = 0; j < ndim; ++j) {
+        average[j] *= norm;
+        error[j] = error[j]*norm - average[j]*average[j];
+        error[j] = (error[j] > SMALLEST_ERROR) ? sqrt(error[j]*norm2) : 0.;
+    }
+}
+
+void CompressedMJBlockerEstimator(const int64_t nstore, const int ndim, const double x[], double average[], double error[])
+{
+    StreamBlockAccumulator::estimateFromCompressed(nstore, ndim, x, average, error);
+}
+
+// The same for the running moments of a CovarianceAccumulator
+void CovarianceEstimator(const int64_t nstore, const int ndim, const double x[], double average[], double error[])
+{
+    CovarianceAccumulator::estimate(nstore, ndim, x, average, error);
+}
+
+// Default estimator for correlated data
 void CorrelatedEstimator(const int64_t n, const int ndim, const double x[], double average[], double error[])
 {
-    if ((static_cast<uint64_t>(n) & (static_cast<uint64_t>(n) - 1)) != 0) { // n is not a power of 2
-        FCBlockerEstimator(n, ndim, x, average, error);
+    MJBlockerEstimator(n, ndim, x, average, error);
+}
+
+void CorrelatedEstimator(const int64_t n, const int ndim, const double x[], double average[], double error[], EstimatorWorkspace &ws)
+{
+    MJBlockerEstimator(n, ndim, x, average, error, ws);
+}
+
+// In-place versions
+void MJBlockerEstimatorInPlace(int64_t n, int ndim, double x[], double average[], double error[])
+{
+    MJBlocker mjblk(n, ndim, true); // create MJBlocker object without work array
+    mjblk.estimateInPlace(x, average, error); // run the algorithm on x
+}
+
+void MJBlockerEstimatorInPlace(int64_t n, int ndim, double x[], double average[], double error[], EstimatorWorkspace &ws)
+{
+    ws.getMJBlocker(n, ndim, true).estimateInPlace(x, average, error);
+}
+
+void CorrelatedEstimatorInPlace(const int64_t n, const int ndim, double x[], double average[], double error[])
+{
+    MJBlockerEstimatorInPlace(n, ndim, x, average, error);
+}
+
+void CorrelatedEstimatorInPlace(const int64_t n, const int ndim, double x[], double average[], double error[], EstimatorWorkspace &ws)
+{
+    MJBlockerEstimatorInPlace(n, ndim, x, average, error, ws);
+}
+
+// Autocorrelation analysis via FFT
+void AutocorrelationAnalysis(const int64_t n, const int ndim, const double x[], double average[], double error[], double tau[], double ess[])
+{
+    EstimatorWorkspace ws;
+    AutocorrelationAnalysis(n, ndim, x, average, error, tau, ess, ws);
+}
+
+void AutocorrelationAnalysis(const int64_t n, const int ndim, const double x[], double average[], double error[], double tau[], double ess[],
+                             EstimatorWorkspace &ws)
+{
+    if (n < 2) {
+        throw std::invalid_argument("[AutocorrelationAnalysis] n must be larger than 1");
     }
-    else {
-        MJBlockerEstimator(n, ndim, x, average, error);
+
+    MultiDimUncorrelatedEstimator(n, ndim, x, average, error); // average and the uncorrelated error
+
+    int64_t nfft = 1;
+    while (nfft < 2*n) { nfft *= 2; }
+    ws.fft.resize(static_cast<size_t>(nfft)); // reused for every dimension
+    for (int j = 0; j < ndim; ++j) {
+        const double tauj = calcAutocorrTime(n, ndim, x + j, average[j], ws.fft, ws.twiddle);
+        error[j] *= sqrt(tauj); // the variance of the mean grows by tau
+        if (tau != nullptr) { tau[j] = tauj; }
+        if (ess != nullptr) { ess[j] = n/tauj; }
     }
 }
 
+void AutocorrelationEstimator(const int64_t n, const int ndim, const double x[], double average[], double error[])
+{
+    AutocorrelationAnalysis(n, ndim, x, average, error, nullptr, nullptr);
+}
+
+void AutocorrelationEstimator(const int64_t n, const int ndim, const double x[], double average[], double error[], EstimatorWorkspace &ws)
+{
+    AutocorrelationAnalysis(n, ndim, x, average, error, nullptr, nullptr, ws);
+}
+
 // Noop Estimator
 void NoopEstimator(int64_t/*n*/, int ndim, const double x[], double average[], double error[])
 {
@@ -1,18 +1,28 @@
 #include "mci/FullAccumulator.hpp"
 
+#include "mci/Checkpoint.hpp"
+
 namespace mci
 {
 
 void FullAccumulator::_allocate()
 {
     _nstore = this->getNAccu();
-    _data = new double[this->getNData()]; // _nstore * _nobs layout
+    _ncapacity = _nstore;
+    _data = new double[this->getNData()]; // _nstore * _nobs layout (or transposed)
     std::fill(_data, _data + this->getNData(), 0.); // not strictly necessary
 }
 
 
 void FullAccumulator::_accumulate()
 {
+    if (_flag_colmajor) {
+        for (int i = 0; i < _nobs; ++i) {
+            _data[i*_nstore + _storeidx] = _obs_values[i];
+        }
+        ++_storeidx;
+        return;
+    }
     std::copy(_obs_values, _obs_values + _nobs, _data + _storeidx);
     _storeidx += _nobs;
 }
@@ -30,5 +40,68 @@ void FullAccumulator::_deallocate()
     delete[] _data;
     _data = nullptr;
     _nstore = 0;
+    _ncapacity = 0;
+}
+
+
+void FullAccumulator::_merge(const int64_t nstore, const int64_t naccu, const double data[])
+{
+    if (nstore != naccu) { throw std::invalid_argument("[FullAccumulator::merge] Passed data must contain one element per accumulated step."); }
+    const int64_t ndata = this->getNData();
+    if (_flag_colmajor) { // append per column
+        auto * newdata = new double[ndata + nstore*_nobs];
+        for (int i = 0; i < _nobs; ++i) {
+            std::copy(_data + i*_nstore, _data + (i + 1)*_nstore, newdata + i*(_nstore + nstore));
+            std::copy(data + i*nstore, data + (i + 1)*nstore, newdata + i*(_nstore + nstore) + _nstore);
+        }
+        delete[] _data;
+        _data = newdata;
+        _ncapacity = _nstore + nstore;
+    }
+    else {
+        this->_reserveMerge(nstore); // reallocates only if not reserved before
+        std::copy(data, data + nstore*_nobs, _data + ndata); // append other's samples to ours
+    }
+
+    _nstore += nstore;
+    _storeidx = _flag_colmajor ? _nstore : this->getNData();
+}
+
+
+void FullAccumulator::_reserveMerge(const int64_t nstore)
+{
+    if (_flag_colmajor || _nstore + nstore <= _ncapacity) { return; } // column-major merges reallocate anyway
+    auto * newdata = new double[(_nstore + nstore)*_nobs];
+    std::copy(_data, _data + this->getNData(), newdata);
+    delete[] _data;
+    _data = newdata;
+    _ncapacity = _nstore + nstore;
+}
+
+
+void FullAccumulator::_saveState(std::ostream &out) const
+{   // only the samples written so far
+    writeCheckpointValue(out, _storeidx);
+    if (_flag_colmajor) {
+        for (int i = 0; i < _nobs; ++i) { writeCheckpointArray(out, _data + i*_nstore, _storeidx); }
+    }
+    else {
+        writeCheckpointArray(out, _data, _storeidx);
+    }
+}
+
+
+void FullAccumulator::_loadState(std::istream &in)
+{
+    _storeidx = readCheckpointValue<int64_t>(in);
+    if (_storeidx < 0 || _storeidx > (_flag_colmajor ? _nstore : this->getNData())) {
+        throw std::runtime_error("[FullAccumulator::loadState] Checkpoint contains an invalid storage index.");
+    }
+    if (_flag_colmajor) {
+        for (int i = 0; i < _nobs; ++i) { readCheckpointArray(in, _data + i*_nstore, _storeidx); }
+    }
+    else {
+        readCheckpointArray(in, _data, _storeidx);
+    }
 }
 }  // namespace mci
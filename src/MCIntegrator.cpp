@@ -1,10 +1,19 @@
 #include "mci/MCIntegrator.hpp"
 
+#include "mci/Checkpoint.hpp"
 #include "mci/OrthoPeriodicDomain.hpp"
 #include "mci/UnboundDomain.hpp"
 
 #include <iostream>
 #include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <exception>
+#include <limits>
+#include <thread>
+#include <typeinfo>
+
+#include <unistd.h>
 
 #if USE_MPI == 1
 #include <mpi.h>
@@ -37,6 +46,20 @@ void MPIReduceAvgErr(const int nobsdim, double avg[]/*inout*/, double err[]/*ino
 
 namespace mci
 {
+constexpr char CHECKPOINT_MAGIC[8] = {'M', 'C', 'I', 'C', 'H', 'K', 'P', 'T'};
+constexpr int32_t CHECKPOINT_VERSION = 1;
+constexpr char WARMSTART_MAGIC[8] = {'M', 'C', 'I', 'W', 'A', 'R', 'M', 'S'};
+
+inline uint64_t mixSeed(uint64_t z) // splitmix64 finalizer
+{
+    z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27))*0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+#if USE_MPI == 1
+constexpr int64_t MPI_CHUNK_SIZE = 1 << 22; // max. number of values per message, when sending accumulated data to root
+#endif
 
 //  --- Integrate
 
@@ -46,7 +69,8 @@ void MCI::integrate(const int64_t Nmc, double average[], double error[], const b
         throw std::domain_error("[MCI::integrate] Integrating over an infinite domain requires a sampling function.");
     }
 
-    if (_pdfcont.hasPDF()) {
+    const bool flag_warm = _pdfcont.hasPDF() && this->loadWarmStart(doFindMRT2step, doDecorrelation);
+    if (_pdfcont.hasPDF() && !flag_warm) { // a stored warm-up replaces both
         //find the optimal mrt2 step
         if (doFindMRT2step) { this->findMRT2Step(); }
         // take care to do the initial decorrelation of the walker
@@ -54,31 +78,148 @@ void MCI::integrate(const int64_t Nmc, double average[], double error[], const b
     }
 
     if (Nmc > 0) {
-        // allocation of the accumulators where the data will be stored
+        this->sampleObservables(Nmc, true); // sample the observables (with file output)
+        if (this->isWarmedUp(doFindMRT2step, doDecorrelation, flag_warm)) { this->storeWarmStart(); } // the final walker position is equilibrated
+        this->estimateObservables(average, error); // estimate average and standard deviation
+    }
+}
+
+void MCI::replay(const std::string &tracepath, double average[], double error[], int64_t Nmc)
+{
+    TraceReader reader(tracepath);
+    if (reader.getKind() != TraceKind::Walker || reader.isBlockAverage()) {
+        throw std::invalid_argument("[MCI::replay] Passed trace file must contain single walker positions.");
+    }
+    if (reader.getNDim() != _ndim) {
+        throw std::invalid_argument("[MCI::replay] Passed trace file's walker dimension is not equal to MCI's number of walkers.");
+    }
+    if (Nmc < 0) {
+        if (reader.isStreamed()) { throw std::invalid_argument("[MCI::replay] Replaying a streamed trace file requires the number of steps."); }
+        Nmc = reader.getNRecords();
+    }
+    else if (!reader.isStreamed() && Nmc > reader.getNRecords()) {
+        throw std::invalid_argument("[MCI::replay] Passed trace file contains less than the requested number of steps.");
+    }
+
+    if (Nmc > 0) {
         _obscont.allocate(Nmc, _pdfcont);
+        this->replayObservables(reader, Nmc);
+        this->estimateObservables(average, error);
+    }
+}
 
-        //sample the observables
-        if (_flagobsfile) { _obsfile.open(_pathobsfile); }
-        if (_flagwlkfile) { _wlkfile.open(_pathwlkfile); }
-        this->sample(Nmc, _obscont, true); // let sample accumulate data
-        if (_flagobsfile) { _obsfile.close(); }
-        if (_flagwlkfile) { _wlkfile.close(); }
-
-        // estimate average and standard deviation
-        _obscont.estimate(average, error);
-
-        // if we sampled randomly, scale results by volume
-        if (!_pdfcont.hasPDF()) {
-            const double vol = _domain->getVolume();
-            for (int i = 0; i < _obscont.getNObsDim(); ++i) {
-                average[i] *= vol;
-                error[i] *= vol;
-            }
+void MCI::resume(const std::string &filepath, double average[], double error[])
+{
+    this->resumeObservables(filepath);
+    this->estimateObservables(average, error);
+}
+
+#if USE_MPI == 1
+void MCI::integrateMPI(const int64_t Nmc, double average[], double error[], const bool doFindMRT2step, const bool doDecorrelation, const bool flag_pool)
+{
+    if (!_pdfcont.hasPDF() && !_domain->isFinite()) {
+        throw std::domain_error("[MCI::integrateMPI] Integrating over an infinite domain requires a sampling function.");
+    }
+
+    int flag_warm = 0;
+    if (_pdfcont.hasPDF()) {
+        // the warm-up synchronizes the ranks, so it may only be skipped if all of them have a stored one
+        // (else the loaded values are just the starting point)
+        flag_warm = this->loadWarmStart(doFindMRT2step, doDecorrelation) ? 1 : 0;
+        int flag_allwarm;
+        MPI_Allreduce(&flag_warm, &flag_allwarm, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+        if (flag_allwarm == 0) {
+            if (doFindMRT2step) { this->findMRT2Step(); }
+            if (doDecorrelation) { this->initialDecorrelation(); }
         }
+    }
 
-        // deallocate
-        _obscont.deallocate();
+    if (Nmc > 0) {
+        this->sampleObservables(Nmc, true);
+        if (this->isWarmedUp(doFindMRT2step, doDecorrelation, flag_warm == 1)) { this->storeWarmStart(); }
+        this->estimateObservablesMPI(average, error, flag_pool); // combine the results of all ranks
+    }
+}
+#endif
+
+void MCI::integrateParallel(const int64_t Nmc, int nthreads, double average[], double error[], const bool doFindMRT2step, const bool doDecorrelation)
+{
+    if (nthreads < 1) { // use all available hardware threads
+        nthreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    if (Nmc < nthreads) { // every walker needs at least one step
+        nthreads = static_cast<int>(std::max(int64_t(1), Nmc));
+    }
+    if (nthreads == 1) { // nothing to parallelize
+        this->integrate(Nmc, average, error, doFindMRT2step, doDecorrelation);
+        return;
+    }
+
+    if (!_pdfcont.hasPDF() && !_domain->isFinite()) {
+        throw std::domain_error("[MCI::integrateParallel] Integrating over an infinite domain requires a sampling function.");
+    }
+    if (_flagchkfile) {
+        throw std::logic_error("[MCI::integrateParallel] Checkpointing is not supported on parallel integration.");
+    }
+
+    // find the optimal mrt2 step (only once, the workers inherit it, like a stored warm-up)
+    const bool flag_warm = _pdfcont.hasPDF() && this->loadWarmStart(doFindMRT2step, doDecorrelation);
+    const bool flag_decorr = _pdfcont.hasPDF() && doDecorrelation && !flag_warm;
+    if (_pdfcont.hasPDF() && doFindMRT2step && !flag_warm) { this->findMRT2Step(); }
+
+    // create the workers (all except the one of the calling thread)
+    std::vector<std::unique_ptr<MCI>> workers;
+    for (int i = 1; i < nthreads; ++i) {
+        workers.push_back(this->createWorker(i));
+    }
+    if (_rgen.hasIndependentStreams()) { _rgen.jump(); } // don't overlap with the last worker's stream
+
+    // split the MC steps, distributing the remainder onto the first walkers
+    const int64_t nmcPerThread = Nmc/nthreads;
+    const int64_t nmcRemainder = Nmc%nthreads;
+    std::vector<int64_t> nmcThread(static_cast<size_t>(nthreads));
+    for (int i = 0; i < nthreads; ++i) {
+        nmcThread[i] = (i < nmcRemainder) ? nmcPerThread + 1 : nmcPerThread;
     }
+
+    // run the workers
+    std::vector<std::exception_ptr> errors(static_cast<size_t>(nthreads));
+    std::vector<std::thread> threads;
+    for (int i = 1; i < nthreads; ++i) {
+        threads.emplace_back([&workers, &nmcThread, &errors, flag_decorr, i]()
+                             {
+                                 try {
+                                     MCI &worker = *workers[i - 1];
+                                     if (flag_decorr) { worker.initialDecorrelation(); }
+                                     worker.sampleObservables(nmcThread[i], false);
+                                 }
+                                 catch (...) {
+                                     errors[i] = std::current_exception();
+                                 }
+                             });
+    }
+    try { // our own walker, the only one with callback and file output
+        if (flag_decorr) { this->initialDecorrelation(); }
+        this->sampleObservables(nmcThread[0], true);
+    }
+    catch (...) {
+        errors[0] = std::current_exception();
+    }
+    for (auto &thread : threads) { thread.join(); }
+    for (auto &err : errors) {
+        if (err) { std::rethrow_exception(err); }
+    }
+
+    // merge the workers' data into ours
+    for (auto &worker : workers) {
+        _obscont.merge(worker->_obscont);
+        _acc += worker->_acc;
+        _rej += worker->_rej;
+    }
+    if (this->isWarmedUp(doFindMRT2step, doDecorrelation, flag_warm)) { this->storeWarmStart(); } // our walker's final position
+
+    // estimate average and standard deviation from all data
+    this->estimateObservables(average, error);
 }
 
 
@@ -96,7 +237,7 @@ void MCI::findMRT2Step()
     // MPI check
     int nranks = 1; // we will set a different value when MPI enabled
 #if USE_MPI == 1
-    const bool flag_mpi = isMPIUsable();
+    const bool flag_mpi = !_flagworker && isMPIUsable();
     if (flag_mpi) {
         MPI_Comm_size(MPI_COMM_WORLD, &nranks);
     }
@@ -185,7 +326,7 @@ void MCI::initialDecorrelation()
         // MPI check
         int nranks = 1; // we will set a different value when MPI enabled
 #if USE_MPI == 1
-        const bool flag_mpi = isMPIUsable();
+        const bool flag_mpi = !_flagworker && isMPIUsable();
         if (flag_mpi) {
             MPI_Comm_size(MPI_COMM_WORLD, &nranks);
         }
@@ -249,6 +390,274 @@ void MCI::initialDecorrelation()
 
 // --- Sampling
 
+void MCI::sampleObservables(const int64_t Nmc, const bool flagFiles)
+{
+    // allocation of the accumulators where the data will be stored
+    _obscont.allocate(Nmc, _pdfcont);
+
+    //sample the observables
+    const bool flag_obsfile = flagFiles && _flagobsfile;
+    const bool flag_wlkfile = flagFiles && _flagwlkfile;
+    if (flag_obsfile) {
+        if (_formatobsfile == TraceFormat::Text) { _obsfile.open(_pathobsfile); }
+        else {
+            _obstrace.reset(new TraceWriter(_pathobsfile, TraceKind::Observables, _ndim, _obscont.getNObsDim(), _freqobsfile,
+                                            _formatobsfile == TraceFormat::BinaryBlockAverage));
+            _obstracebuf.resize(static_cast<size_t>(_obscont.getNObsDim()));
+        }
+    }
+    if (flag_wlkfile) {
+        if (_formatwlkfile == TraceFormat::Text) { _wlkfile.open(_pathwlkfile); }
+        else {
+            _wlktrace.reset(new TraceWriter(_pathwlkfile, TraceKind::Walker, _ndim, _ndim, _freqwlkfile,
+                                            _formatwlkfile == TraceFormat::BinaryBlockAverage));
+        }
+    }
+    this->sample(Nmc, _obscont, flagFiles); // let sample accumulate data
+    if (flag_obsfile) {
+        if (_obstrace) {
+            _obstrace->close();
+            _obstrace.reset();
+        }
+        else { _obsfile.close(); }
+    }
+    if (flag_wlkfile) {
+        if (_wlktrace) {
+            _wlktrace->close();
+            _wlktrace.reset();
+        }
+        else { _wlkfile.close(); }
+    }
+}
+
+int64_t MCI::checkDerived() const
+{
+    // all observables must hold block averages for the same steps
+    int64_t nblocks = 0, nsteps = 0;
+    for (int i = 0; i < _obscont.getNObs(); ++i) {
+        const AccumulatorInterface &accu = _obscont.getAccumulator(i);
+        if (dynamic_cast<const FullAccumulator *>(&accu) == nullptr && dynamic_cast<const BlockAccumulator *>(&accu) == nullptr
+            && dynamic_cast<const BinningAccumulator *>(&accu) == nullptr) {
+            throw std::invalid_argument("[MCI::estimateDerived] Derived quantities require Full, Block or Binning accumulators for all observables.");
+        }
+        if (i == 0) {
+            nblocks = accu.getNStore();
+            nsteps = accu.getNSteps();
+        }
+        else if (accu.getNStore() != nblocks || accu.getNSteps() != nsteps) {
+            throw std::invalid_argument("[MCI::estimateDerived] Derived quantities require all observables to store the same number of blocks.");
+        }
+    }
+    if (nblocks < 2) {
+        throw std::invalid_argument("[MCI::estimateDerived] Derived quantities require at least 2 stored blocks.");
+    }
+    return nblocks;
+}
+
+void MCI::estimateDerived()
+{
+    const int nderived = this->getNDerived();
+    _derivedValue.assign(static_cast<size_t>(nderived), std::numeric_limits<double>::quiet_NaN());
+    _derivedError.assign(static_cast<size_t>(nderived), std::numeric_limits<double>::quiet_NaN());
+    if (nderived == 0) { return; }
+    const int64_t nblocks = this->checkDerived();
+
+    // average the blocks in groups, with all observables side by side
+    const int nobsdim = _obscont.getNObsDim();
+    const auto ngroups = static_cast<int>(std::min(static_cast<int64_t>(_NresamplingGroups), nblocks));
+    std::vector<double> groupavg(static_cast<size_t>(ngroups)*nobsdim);
+    int offset = 0;
+    for (int i = 0; i < _obscont.getNObs(); ++i) {
+        const AccumulatorInterface &accu = _obscont.getAccumulator(i);
+        if (_obscont.getSampleStorage(i).flag_colmajor) { // column by column
+            for (int j = 0; j < accu.getNObs(); ++j) {
+                calcGroupAverages(nblocks, 1, accu.getData() + j*nblocks, ngroups, nobsdim, groupavg.data() + offset + j);
+            }
+        }
+        else { calcGroupAverages(nblocks, accu.getNObs(), accu.getData(), ngroups, nobsdim, groupavg.data() + offset); }
+        offset += accu.getNObs();
+    }
+    if (!_pdfcont.hasPDF()) { // like the averages, if we sampled randomly
+        const double vol = _domain->getVolume();
+        for (auto &avg : groupavg) { avg *= vol; }
+    }
+
+    // evaluate all derived functions on every resample
+    const auto allDerived = [this](const double avg[], double out[])
+    {
+        int outoffset = 0;
+        for (size_t k = 0; k < _derivedFuncs.size(); ++k) {
+            _derivedFuncs[k](avg, out + outoffset);
+            outoffset += _derivedNOut[k];
+        }
+    };
+    resampleDerived(_resamplingType, ngroups, nobsdim, groupavg.data(), allDerived, nderived,
+                    _derivedValue.data(), _derivedError.data(), _Nresamples, _resamplingSeed, _NestimatorThreads);
+}
+
+void MCI::estimateObservables(double average[], double error[])
+{
+    // derived quantities first, because the estimation may overwrite the data
+    this->estimateDerived();
+
+    // estimate average and standard deviation (the data is not needed anymore, so we allow in-place estimation)
+    _obscont.estimateInPlace(average, error, _NestimatorThreads);
+
+    // if we sampled randomly, scale results by volume
+    if (!_pdfcont.hasPDF()) {
+        const double vol = _domain->getVolume();
+        for (int i = 0; i < _obscont.getNObsDim(); ++i) {
+            average[i] *= vol;
+            error[i] *= vol;
+        }
+        _obscont.scaleCovariance(vol*vol);
+    }
+
+    // deallocate
+    _obscont.deallocate();
+}
+
+#if USE_MPI == 1
+void MCI::estimateObservablesMPI(double average[], double error[], const bool flag_pool)
+{
+    // check the data for the derived quantities on all ranks first, so that no rank throws while the others wait in MPI calls
+    if (this->getNDerived() > 0) {
+        std::string errmsg;
+        try { this->checkDerived(); }
+        catch (const std::invalid_argument &e) { errmsg = e.what(); }
+        int flag_ok = errmsg.empty() ? 1 : 0;
+        MPI_Allreduce(MPI_IN_PLACE, &flag_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+        if (flag_ok == 0) {
+            throw std::invalid_argument(errmsg.empty() ? "[MCI::estimateObservablesMPI] Derived quantities can't be estimated on another rank." : errmsg);
+        }
+    }
+
+    if (!flag_pool) { // every rank estimates on its own, then the results are averaged
+        this->estimateObservables(average, error);
+        const int nobsdim = _obscont.getNObsDim();
+        std::vector<double> tempavg(static_cast<size_t>(nobsdim)), temperr(static_cast<size_t>(nobsdim));
+        MPIReduceAvgErr(nobsdim, average, error, tempavg.data(), temperr.data());
+        if (this->getNDerived() > 0) {
+            const int nderived = this->getNDerived();
+            tempavg.resize(static_cast<size_t>(nderived));
+            temperr.resize(static_cast<size_t>(nderived));
+            MPIReduceAvgErr(nderived, _derivedValue.data(), _derivedError.data(), tempavg.data(), temperr.data());
+        }
+        return;
+    }
+
+    int myrank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &myrank);
+    this->mergeObservablesMPI();
+
+    // estimate on root and broadcast
+    if (myrank == 0) {
+        this->estimateObservables(average, error);
+    }
+    else {
+        _obscont.deallocate();
+    }
+    MPI_Bcast(average, _obscont.getNObsDim(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    MPI_Bcast(error, _obscont.getNObsDim(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    if (this->getNDerived() > 0) {
+        _derivedValue.resize(static_cast<size_t>(this->getNDerived()));
+        _derivedError.resize(static_cast<size_t>(this->getNDerived()));
+        MPI_Bcast(_derivedValue.data(), this->getNDerived(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+        MPI_Bcast(_derivedError.data(), this->getNDerived(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    }
+}
+
+void MCI::mergeObservablesMPI()
+{
+    int myrank, nranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &myrank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+
+    // The data is sent in messages of whole storage elements with at most MPI_CHUNK_SIZE values (i.e. far below the int counts of MPI).
+    // If the accumulator allows, root merges every message as it arrives, else it collects the data of one rank first.
+    std::vector<double> data; // receive buffer
+    for (int i = 0; i < _obscont.getNObs(); ++i) {
+        const AccumulatorInterface &accu = _obscont.getAccumulator(i);
+        const int64_t nobs = accu.getNObs();
+        const int64_t nchunk = std::max<int64_t>(1, MPI_CHUNK_SIZE/nobs); // storage elements per message
+        if (myrank == 0) {
+            for (int r = 1; r < nranks; ++r) {
+                int64_t sizes[3]; // nsteps, naccu, nstore
+                MPI_Recv(sizes, 3, MPI_INT64_T, r, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                const bool flag_chunks = accu.isChunkMergeable() && sizes[2] > 0 && sizes[1]%sizes[2] == 0;
+                if (flag_chunks) {
+                    _obscont.reserveMerge(i, sizes[2]);
+                    data.resize(static_cast<size_t>(std::min(nchunk, sizes[2])*nobs));
+                }
+                else {
+                    data.resize(static_cast<size_t>(sizes[2]*nobs));
+                }
+                int64_t nstepsleft = sizes[0];
+                for (int64_t j = 0; j < sizes[2]; j += nchunk) {
+                    const int64_t nstore = std::min(nchunk, sizes[2] - j);
+                    double * const buffer = flag_chunks ? data.data() : data.data() + j*nobs;
+                    MPI_Recv(buffer, static_cast<int>(nstore*nobs), MPI_DOUBLE, r, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                    if (flag_chunks) { // every element stands for naccu/nstore accumulations, i.e. nskip times as many steps
+                        const int64_t naccu = nstore*(sizes[1]/sizes[2]);
+                        const int64_t nsteps = (j + nstore < sizes[2]) ? naccu*accu.getNSkip() : nstepsleft; // the last chunk takes the rest
+                        _obscont.merge(i, nsteps, naccu, nstore, buffer);
+                        nstepsleft -= nsteps;
+                    }
+                }
+                if (!flag_chunks) { _obscont.merge(i, sizes[0], sizes[1], sizes[2], data.data()); }
+            }
+        }
+        else {
+            const int64_t sizes[3] = {accu.getNSteps(), accu.getNAccu(), accu.getNStore()};
+            MPI_Send(sizes, 3, MPI_INT64_T, 0, 0, MPI_COMM_WORLD);
+            for (int64_t j = 0; j < sizes[2]; j += nchunk) {
+                const int64_t nstore = std::min(nchunk, sizes[2] - j);
+                MPI_Send(accu.getData() + j*nobs, static_cast<int>(nstore*nobs), MPI_DOUBLE, 0, 1, MPI_COMM_WORLD);
+            }
+        }
+    }
+}
+#endif
+
+std::unique_ptr<MCI> MCI::createWorker(const int iworker)
+{
+    std::unique_ptr<MCI> worker(new MCI(_ndim));
+    worker->_flagworker = true;
+    if (_rgen.hasIndependentStreams()) { // worker takes the next stream
+        _rgen.jump();
+        worker->_rgen.setEngine(_rgen.getEngine().clone());
+    }
+    else { // seeded from our generator, so a seeded master yields reproducible workers
+        worker->_rgen.setEngine(_rgen.getEngine().clone());
+        worker->setSeed(_rgen());
+    }
+
+    // clone objects
+    worker->setDomain(*_domain);
+    worker->setTrialMove(*_trialMove); // including current step sizes
+    for (int i = 0; i < _pdfcont.getNPDF(); ++i) {
+        worker->addSamplingFunction(_pdfcont.getSamplingFunction(i));
+    }
+    for (int i = 0; i < _obscont.getNObs(); ++i) {
+        SampleStorage storage = _obscont.getSampleStorage(i);
+        if (!storage.mapfile.empty()) { // every worker needs its own (temporary) file
+            storage.mapfile += ".worker" + std::to_string(iworker);
+            storage.flag_keepfile = false;
+        }
+        worker->_obscont.addObservable(_obscont.getObservableFunction(i).clone(), _obscont.getBlockSize(i),
+                                       _obscont.getNSkip(i), _obscont.getFlagEquil(i), _obscont.getEstimatorType(i), _obscont.getNBins(i),
+                                       storage);
+    }
+
+    // copy settings and walker position
+    worker->_NfindMRT2Iterations = _NfindMRT2Iterations;
+    worker->_NdecorrelationSteps = _NdecorrelationSteps;
+    worker->_targetaccrate = _targetaccrate;
+    worker->setX(_wlkstate.xold);
+
+    return worker;
+}
+
 void MCI::initializeSampling(ObservableContainer * obsCont)
 {
     const bool flag_obs = (obsCont != nullptr);
@@ -291,11 +700,18 @@ void MCI::sample(const int64_t npoints, ObservableContainer &container, const bo
 {
     // Initialize
     this->initializeSampling(&container);
-    bool flag_callbackPDF = container.dependsOnPDF(); // initialize flag to keep track of when a PDF callback is necessary
+
+    // run the main loop, with initialized flag to keep track of when a PDF callback is necessary
+    this->continueSample(npoints, container, flagMC, flagMC && _flagchkfile, container.dependsOnPDF());
+}
+
+void MCI::continueSample(const int64_t npoints, ObservableContainer &container, const bool flagFiles, const bool flagCheckpoint, bool flag_callbackPDF)
+{
     const bool flagpdf = _pdfcont.hasPDF();
+    int64_t nextchk = flagCheckpoint ? (_ridx/_freqchkfile + 1)*_freqchkfile : npoints; // number of completed steps at the next checkpoint
 
     // run the main loop for sampling
-    for (_ridx = 0; _ridx < npoints; ++_ridx) {
+    for (; _ridx < npoints; ++_ridx) {
         // do MC step
         if (flagpdf) { // use sampling function
             this->doStepMRT2();
@@ -312,8 +728,14 @@ void MCI::sample(const int64_t npoints, ObservableContainer &container, const bo
         container.accumulate(_wlkstate);
 
         // file output
-        if (flagMC && _flagobsfile) { this->storeObservables(); } // store obs on file
-        if (flagMC && _flagwlkfile) { this->storeWalkerPositions(); } // store walkers on file
+        if (flagFiles && _flagobsfile) { this->storeObservables(); } // store obs on file
+        if (flagFiles && _flagwlkfile) { this->storeWalkerPositions(); } // store walkers on file
+
+        // checkpoint (not after the last step)
+        if (_ridx + 1 == nextchk && nextchk < npoints) {
+            this->storeCheckpoint(npoints, flag_callbackPDF);
+            nextchk += _freqchkfile;
+        }
     }
 
     // finalize data
@@ -321,6 +743,101 @@ void MCI::sample(const int64_t npoints, ObservableContainer &container, const bo
 }
 
 
+void MCI::resumeObservables(const std::string &filepath)
+{
+    const std::string path = this->getRankFilePath(filepath);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) { throw std::runtime_error("[MCI::resume] Failed to open checkpoint file " + path + "."); }
+
+    // header
+    char magic[8];
+    readCheckpointArray(file, magic, 8);
+    if (!std::equal(CHECKPOINT_MAGIC, CHECKPOINT_MAGIC + 8, magic)) { throw std::invalid_argument("[MCI::resume] File " + path + " is not a checkpoint file."); }
+    expectCheckpointValue(file, CHECKPOINT_VERSION, "[MCI::resume] Checkpoint file has an unsupported version.");
+    expectCheckpointValue(file, static_cast<int32_t>(_ndim), "[MCI::resume] Checkpoint was written with a different number of dimensions.");
+    int64_t counters[4]; // Nmc, next step index, accepted and rejected steps
+    readCheckpointArray(file, counters, 4);
+    const bool flag_callbackPDF = readCheckpointValue<bool>(file);
+    if (counters[0] < 1 || counters[1] < 1 || counters[1] >= counters[0]) { throw std::runtime_error("[MCI::resume] Checkpoint contains invalid step counters."); }
+
+    // restore the complete sampling state
+    _obscont.allocate(counters[0], _pdfcont);
+    try {
+        readCheckpointArray(file, _wlkstate.xold, _ndim);
+        _wlkstate.initialize(true);
+        _rgen.loadState(file);
+        expectCheckpointValue(file, _trialMove->getNStepSizes(), "[MCI::resume] Checkpoint contains a different number of step sizes.");
+        for (int i = 0; i < _trialMove->getNStepSizes(); ++i) { _trialMove->setStepSize(i, readCheckpointValue<double>(file)); }
+        _trialMove->loadState(file);
+        _pdfcont.loadState(file);
+        _obscont.loadState(file);
+    }
+    catch (...) {
+        _obscont.deallocate();
+        throw;
+    }
+    file.close();
+
+    // the PDFs have been prepared for observation at the current position, but may have state beyond the proto values
+    if (_pdfcont.hasPDF() && _obscont.dependsOnPDF() && !flag_callbackPDF) { _pdfcont.prepareObservation(_wlkstate.xold); }
+
+    _ridx = counters[1];
+    _acc = counters[2];
+    _rej = counters[3];
+    this->continueSample(counters[0], _obscont, false, _flagchkfile, flag_callbackPDF);
+}
+
+
+void MCI::replayObservables(TraceReader &reader, const int64_t Nmc)
+{
+    const int64_t REPLAY_CHUNK = 4096; // number of positions to read at once
+
+    // like initializeSampling, but without trial move and pdf (the proto values are only computed if observed)
+    _acc = 0;
+    _rej = 0;
+    _obscont.reset();
+    bool flag_callbackPDF = _obscont.dependsOnPDF();
+
+    std::vector<double> positions(static_cast<size_t>(std::min(REPLAY_CHUNK, Nmc)*_ndim));
+    for (_ridx = 0; _ridx < Nmc;) {
+        const int64_t npos = reader.read(std::min(REPLAY_CHUNK, Nmc - _ridx), nullptr, positions.data());
+        if (npos == 0) { throw std::runtime_error("[MCI::replay] Trace file ended before the requested number of steps."); }
+        for (int64_t i = 0; i < npos; ++i, ++_ridx) {
+            // the "move" to the next position, with the changed indices (so that updateable observables profit)
+            const double * const x = positions.data() + i*_ndim;
+            _wlkstate.nchanged = 0;
+            for (int j = 0; j < _ndim; ++j) {
+                if (x[j] != _wlkstate.xold[j]) {
+                    _wlkstate.xnew[j] = x[j];
+                    _wlkstate.changedIdx[_wlkstate.nchanged++] = j;
+                }
+            }
+            if (_ridx == 0) { // first position is always new
+                std::copy(x, x + _ndim, _wlkstate.xnew);
+                _wlkstate.nchanged = _ndim;
+            }
+            _wlkstate.accepted = (_wlkstate.nchanged > 0);
+            _wlkstate.accepted ? ++_acc : ++_rej;
+
+            if (_obscont.dependsOnPDF()) { // same logic as in sample()
+                const bool flag_PDFObs = _ridx%_obscont.getNSkipPDF() == 0;
+                if ((flag_callbackPDF || _wlkstate.accepted) && flag_PDFObs) {
+                    _pdfcont.initializeProtoValues(_wlkstate.xnew);
+                    _pdfcont.prepareObservation(_wlkstate.xnew);
+                    flag_callbackPDF = false;
+                }
+                else if (_wlkstate.accepted) { flag_callbackPDF = true; }
+            }
+
+            _obscont.accumulate(_wlkstate);
+            if (_wlkstate.accepted) { _wlkstate.newToOld(); }
+        }
+    }
+
+    _obscont.finalize();
+}
+
+
 // --- Walking
 
 void MCI::doStepMRT2() // do MC step, sampling from _pdfcont
@@ -340,7 +857,7 @@ void MCI::doStepMRT2() // do MC step, sampling from _pdfcont
     const double pdfAcc = _pdfcont.computeAcceptance(_wlkstate);
 
     // determine if the proposed x is accepted or not
-    _wlkstate.accepted = (_rd(_rgen) <= pdfAcc*moveAcc);
+    _wlkstate.accepted = (_rgen.uniform() <= pdfAcc*moveAcc);
     _wlkstate.accepted ? ++_acc : ++_rej; // increase counters
 
     // call callback
@@ -362,7 +879,7 @@ void MCI::doStepMRT2() // do MC step, sampling from _pdfcont
 void MCI::doStepRandom() // do MC step, sampling randomly (used when _pdfcont is empty)
 {
     // set xnew to new random values within the domain
-    for (int i = 0; i < _ndim; ++i) { _wlkstate.xnew[i] = _rd(_rgen); } // between 0 and 1
+    for (int i = 0; i < _ndim; ++i) { _wlkstate.xnew[i] = _rgen.uniform(); } // between 0 and 1
     _domain->scaleToDomain(_wlkstate.xnew); // make it proper coordinates
     _wlkstate.nchanged = _ndim;
 
@@ -448,7 +965,8 @@ std::unique_ptr<TrialMoveInterface> MCI::setTrialMove(SRRDType srrd, int veclen,
 
 // --- Observables
 
-void MCI::addObservable(std::unique_ptr<ObservableFunctionInterface> obs, int blocksize, int nskip, const bool flag_equil, const EstimatorType estimType)
+void MCI::addObservableElement(std::unique_ptr<ObservableFunctionInterface> obs, int blocksize, int nskip, const bool flag_equil,
+                               const EstimatorType estimType, const int nbins, const SampleStorage &storage)
 {
     // sanity
     blocksize = std::max(0, blocksize);
@@ -461,7 +979,59 @@ void MCI::addObservable(std::unique_ptr<ObservableFunctionInterface> obs, int bl
     }
 
     // add accumulator&estimator from factory functions
-    _obscont.addObservable(std::move(obs), blocksize, nskip, flag_equil, estimType);
+    _obscont.addObservable(std::move(obs), blocksize, nskip, flag_equil, estimType, nbins, storage);
+}
+
+void MCI::addObservable(std::unique_ptr<ObservableFunctionInterface> obs, const int blocksize, const int nskip, const bool flag_equil, const EstimatorType estimType)
+{
+    this->addObservableElement(std::move(obs), blocksize, nskip, flag_equil, estimType, 0);
+}
+
+void MCI::addBinnedObservable(std::unique_ptr<ObservableFunctionInterface> obs, const int nbins, const int nskip, const bool flag_equil, const EstimatorType estimType)
+{
+    if (nbins < 2 || nbins%2 != 0) {
+        throw std::invalid_argument("[MCI::addBinnedObservable] Requested number of bins must be even and >= 2.");
+    }
+    this->addObservableElement(std::move(obs), 1, nskip, flag_equil, estimType, nbins);
+}
+
+void MCI::addCompressedObservable(std::unique_ptr<ObservableFunctionInterface> obs, const int nskip, const bool flag_equil, const EstimatorType estimType)
+{
+    if (estimType != EstimatorType::Uncorrelated && estimType != EstimatorType::Correlated && estimType != EstimatorType::MJBlocker) {
+        throw std::invalid_argument("[MCI::addCompressedObservable] Requested estimator is not supported for compressed samples.");
+    }
+    SampleStorage storage;
+    storage.flag_compress = true;
+    this->addObservableElement(std::move(obs), 1, nskip, flag_equil, estimType, 0, storage);
+}
+
+void MCI::addMappedObservable(std::unique_ptr<ObservableFunctionInterface> obs, const std::string &filepath, const int nskip, const bool flag_equil,
+                              const EstimatorType estimType, const bool flag_hugepages)
+{
+    if (estimType == EstimatorType::StreamMJBlocker || estimType == EstimatorType::Covariance) {
+        throw std::invalid_argument("[MCI::addMappedObservable] Requested estimator requires its own accumulator.");
+    }
+    if (filepath.empty()) {
+        throw std::invalid_argument("[MCI::addMappedObservable] Requested file path is empty.");
+    }
+    SampleStorage storage;
+    storage.mapfile = this->getRankFilePath(filepath); // with MPI, every rank keeps its own samples
+    storage.flag_hugepages = flag_hugepages;
+    this->addObservableElement(std::move(obs), 1, nskip, flag_equil, estimType, 0, storage);
+}
+
+void MCI::addColumnMajorObservable(std::unique_ptr<ObservableFunctionInterface> obs, const int blocksize, const int nskip, const bool flag_equil,
+                                   const EstimatorType estimType)
+{
+    if (estimType == EstimatorType::StreamMJBlocker || estimType == EstimatorType::Covariance) {
+        throw std::invalid_argument("[MCI::addColumnMajorObservable] Requested estimator requires its own accumulator.");
+    }
+    if (blocksize < 1) {
+        throw std::invalid_argument("[MCI::addColumnMajorObservable] Requested blocksize must be > 0.");
+    }
+    SampleStorage storage;
+    storage.flag_colmajor = true;
+    this->addObservableElement(std::move(obs), blocksize, nskip, flag_equil, estimType, 0, storage);
 }
 
 void MCI::addObservable(std::unique_ptr<ObservableFunctionInterface> obs, const int blocksize, const int nskip, const bool flag_equil, const bool flag_correlated)
@@ -479,6 +1049,54 @@ std::unique_ptr<ObservableFunctionInterface> MCI::popObservable()
     return _obscont.pop_back(); // remove obs from container and return it
 }
 
+// --- Derived quantities
+
+void MCI::addDerivedQuantity(const DerivedFunction &f, const int nout)
+{
+    if (!f || nout < 1) {
+        throw std::invalid_argument("[MCI::addDerivedQuantity] A derived quantity requires a function with at least one output.");
+    }
+    _derivedFuncs.push_back(f);
+    _derivedNOut.push_back(nout);
+}
+
+void MCI::clearDerivedQuantities()
+{
+    _derivedFuncs.clear();
+    _derivedNOut.clear();
+    _derivedValue.clear();
+    _derivedError.clear();
+}
+
+void MCI::setResampling(const ResamplingType type, const int ngroups, const int nresamples)
+{
+    if (ngroups < 2 || nresamples < 2) {
+        throw std::invalid_argument("[MCI::setResampling] Number of groups and resamples must be at least 2.");
+    }
+    _resamplingType = type;
+    _NresamplingGroups = ngroups;
+    _Nresamples = nresamples;
+}
+
+int MCI::getNDerived() const
+{
+    int nderived = 0;
+    for (const int nout : _derivedNOut) { nderived += nout; }
+    return nderived;
+}
+
+void MCI::getDerivedResults(double value[], double error[]) const
+{
+    const int nderived = this->getNDerived();
+    if (static_cast<int>(_derivedValue.size()) != nderived) { // no integration since the last change
+        std::fill(value, value + nderived, std::numeric_limits<double>::quiet_NaN());
+        std::fill(error, error + nderived, std::numeric_limits<double>::quiet_NaN());
+        return;
+    }
+    std::copy(_derivedValue.begin(), _derivedValue.end(), value);
+    std::copy(_derivedError.begin(), _derivedError.end(), error);
+}
+
 // --- Sampling functions
 
 void MCI::addSamplingFunction(std::unique_ptr<SamplingFunctionInterface> pdf)
@@ -492,10 +1110,12 @@ void MCI::addSamplingFunction(std::unique_ptr<SamplingFunctionInterface> pdf)
 
 // --- File Output
 
-void MCI::storeObservablesOnFile(const std::string &filepath, const int freq)
+void MCI::storeObservablesOnFile(const std::string &filepath, const int freq, const TraceFormat format)
 {
+    if (freq < 1) { throw std::invalid_argument("[MCI::storeObservablesOnFile] Requested frequency was < 1 ."); }
     _pathobsfile = filepath;
     _freqobsfile = freq;
+    _formatobsfile = format;
     _flagobsfile = true;
 }
 
@@ -503,23 +1123,32 @@ void MCI::clearObservableFile()
 {
     _pathobsfile = "";
     _freqobsfile = 0;
+    _formatobsfile = TraceFormat::Text;
     _flagobsfile = false;
 }
 
 void MCI::storeObservables()
 {
-    if (_ridx%_freqobsfile == 0) {
+    if (_obstrace) {
+        if (_obstrace->needsValues(_ridx)) {
+            _obscont.getObsValues(_obstracebuf.data());
+            _obstrace->push(_ridx, _obstracebuf.data());
+        }
+    }
+    else if (_ridx%_freqobsfile == 0) {
         _obsfile << _ridx;
         _obscont.printObsValues(_obsfile);
-        _obsfile << std::endl;
+        _obsfile << '\n'; // no flush
     }
 }
 
 
-void MCI::storeWalkerPositionsOnFile(const std::string &filepath, const int freq)
+void MCI::storeWalkerPositionsOnFile(const std::string &filepath, const int freq, const TraceFormat format)
 {
+    if (freq < 1) { throw std::invalid_argument("[MCI::storeWalkerPositionsOnFile] Requested frequency was < 1 ."); }
     _pathwlkfile = filepath;
     _freqwlkfile = freq;
+    _formatwlkfile = format;
     _flagwlkfile = true;
 }
 
@@ -527,26 +1156,191 @@ void MCI::clearWalkerFile()
 {
     _pathwlkfile = "";
     _freqwlkfile = 0;
+    _formatwlkfile = TraceFormat::Text;
     _flagwlkfile = false;
 }
 
 void MCI::storeWalkerPositions()
 {
-    if (_ridx%_freqwlkfile == 0) {
+    if (_wlktrace) { _wlktrace->push(_ridx, _wlkstate.xold); }
+    else if (_ridx%_freqwlkfile == 0) {
         _wlkfile << _ridx;
         for (int j = 0; j < _ndim; ++j) {
             _wlkfile << "   " << _wlkstate.xold[j];
         }
-        _wlkfile << std::endl;
+        _wlkfile << '\n'; // no flush
+    }
+}
+
+
+void MCI::setCheckpoint(const std::string &filepath, const int64_t freq)
+{
+    if (freq < 1) { throw std::invalid_argument("[MCI::setCheckpoint] Requested frequency was < 1 ."); }
+    if (filepath.empty()) { throw std::invalid_argument("[MCI::setCheckpoint] Requested file path is empty."); }
+    _pathchkfile = filepath;
+    _freqchkfile = freq;
+    _flagchkfile = true;
+}
+
+void MCI::clearCheckpoint()
+{
+    _pathchkfile = "";
+    _freqchkfile = 0;
+    _flagchkfile = false;
+}
+
+std::string MCI::getRankFilePath(const std::string &filepath) const
+{
+#if USE_MPI == 1
+    if (!_flagworker && isMPIUsable()) { // every rank has its own checkpoint
+        int myrank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &myrank);
+        if (myrank > 0) { return filepath + ".rank" + std::to_string(myrank); }
+    }
+#endif
+    return filepath;
+}
+
+void MCI::storeCheckpoint(const int64_t npoints, const bool flag_callbackPDF)
+{
+    const std::string path = this->getRankFilePath(_pathchkfile);
+    const std::string tmppath = path + ".tmp";
+    std::ofstream file(tmppath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) { throw std::runtime_error("[MCI::storeCheckpoint] Failed to open file " + tmppath + "."); }
+
+    // header
+    writeCheckpointArray(file, CHECKPOINT_MAGIC, 8);
+    writeCheckpointValue(file, CHECKPOINT_VERSION);
+    writeCheckpointValue(file, static_cast<int32_t>(_ndim));
+    const int64_t counters[4] = {npoints, _ridx + 1, _acc, _rej}; // we are at the end of step _ridx
+    writeCheckpointArray(file, counters, 4);
+    writeCheckpointValue(file, flag_callbackPDF);
+
+    // sampling state (at the end of a step, xold equals xnew and the old proto values equal the new ones)
+    writeCheckpointArray(file, _wlkstate.xold, _ndim);
+    _rgen.saveState(file);
+    writeCheckpointValue(file, _trialMove->getNStepSizes());
+    for (int i = 0; i < _trialMove->getNStepSizes(); ++i) { writeCheckpointValue(file, _trialMove->getStepSize(i)); }
+    _trialMove->saveState(file);
+    _pdfcont.saveState(file);
+    _obscont.saveState(file);
+
+    file.close();
+    if (file.fail()) { throw std::runtime_error("[MCI::storeCheckpoint] Failed to write file " + tmppath + "."); }
+    if (std::rename(tmppath.c_str(), path.c_str()) != 0) { // replace the previous checkpoint
+        throw std::runtime_error("[MCI::storeCheckpoint] Failed to rename " + tmppath + " to " + path + ".");
+    }
+}
+
+void MCI::setWarmStart(const std::string &storedir, const std::string &tag)
+{
+    if (storedir.empty()) { throw std::invalid_argument("[MCI::setWarmStart] Requested store directory is empty."); }
+    const auto isValid = [](const char c) { return (isalnum(static_cast<unsigned char>(c)) != 0) || c == '-' || c == '_' || c == '.'; };
+    if (tag.empty() || !std::all_of(tag.begin(), tag.end(), isValid) || tag.find_first_not_of('.') == std::string::npos) {
+        throw std::invalid_argument("[MCI::setWarmStart] Requested tag must consist of letters, digits, '-', '_' and '.' (not only dots).");
+    }
+    _warmdir = storedir;
+    _warmtag = tag;
+    _flagwarm = true;
+}
+
+void MCI::clearWarmStart()
+{
+    _warmdir = "";
+    _warmtag = "";
+    _flagwarm = false;
+}
+
+std::string MCI::getWarmStartPath() const
+{
+    return this->getRankFilePath(_warmdir + "/" + _warmtag + ".warm");
+}
+
+bool MCI::loadWarmStart(const bool flag_steps, const bool flag_walker)
+{
+    if (!_flagwarm || (!flag_steps && !flag_walker)) { return false; }
+
+    std::ifstream file(this->getWarmStartPath(), std::ios::binary);
+    if (!file.is_open()) { return false; } // no entry yet
+
+    // read everything before applying anything, any mismatch or damage makes it a miss
+    std::vector<double> stepSizes(static_cast<size_t>(_trialMove->getNStepSizes()));
+    std::vector<double> x(static_cast<size_t>(_ndim));
+    try {
+        char magic[8];
+        readCheckpointArray(file, magic, 8);
+        if (!std::equal(WARMSTART_MAGIC, WARMSTART_MAGIC + 8, magic)) { return false; }
+        if (readCheckpointValue<int32_t>(file) != CHECKPOINT_VERSION) { return false; }
+        if (readCheckpointValue<int32_t>(file) != _ndim) { return false; }
+        if (readCheckpointString(file) != typeid(*_trialMove).name()) { return false; }
+        if (readCheckpointValue<double>(file) != _targetaccrate) { return false; }
+        if (readCheckpointValue<int>(file) != _trialMove->getNStepSizes()) { return false; }
+        readCheckpointArray(file, stepSizes.data(), _trialMove->getNStepSizes());
+        readCheckpointArray(file, x.data(), _ndim);
+    }
+    catch (const std::exception &) { return false; } // truncated or damaged
+
+    if (flag_steps) {
+        for (int i = 0; i < _trialMove->getNStepSizes(); ++i) { _trialMove->setStepSize(i, stepSizes[i]); }
+    }
+    if (flag_walker) { this->setX(x.data()); }
+    return true;
+}
+
+bool MCI::isWarmedUp(const bool doFindMRT2step, const bool doDecorrelation, const bool flag_loaded) const
+{   // the loaded entry (if any) provided the requested parts, else they were only done with a non-zero number of iterations/steps
+    return doFindMRT2step && doDecorrelation && (flag_loaded || (_NfindMRT2Iterations != 0 && _NdecorrelationSteps != 0));
+}
+
+void MCI::storeWarmStart()
+{
+    if (!_flagwarm || !_pdfcont.hasPDF()) { return; } // without PDF, there is no warm-up
+
+    // write to a file of our own, then replace the entry (concurrent processes may use the same tag)
+    const std::string path = this->getWarmStartPath();
+    const std::string tmppath = path + ".tmp" + std::to_string(getpid());
+    bool flag_ok = false;
+    {
+        std::ofstream file(tmppath, std::ios::binary | std::ios::trunc);
+        if (file.is_open()) {
+            writeCheckpointArray(file, WARMSTART_MAGIC, 8);
+            writeCheckpointValue(file, CHECKPOINT_VERSION);
+            writeCheckpointValue(file, static_cast<int32_t>(_ndim));
+            writeCheckpointString(file, typeid(*_trialMove).name());
+            writeCheckpointValue(file, _targetaccrate);
+            writeCheckpointValue(file, _trialMove->getNStepSizes());
+            for (int i = 0; i < _trialMove->getNStepSizes(); ++i) { writeCheckpointValue(file, _trialMove->getStepSize(i)); }
+            writeCheckpointArray(file, _wlkstate.xold, _ndim);
+            file.close();
+            flag_ok = !file.fail();
+        }
     }
+    if (flag_ok && std::rename(tmppath.c_str(), path.c_str()) == 0) { return; }
+    std::remove(tmppath.c_str());
+    std::cout << "Warning [MCI::storeWarmStart]: Failed to write the warm-start entry " << path << "." << std::endl; // the results are still fine
 }
 
 
 // --- Setters
 
-void MCI::setSeed(const uint_fast64_t seed) // fastest unsigned integer which is at least 64 bit (as expected by rgen)
+void MCI::setSeed(const uint_fast64_t seed, const uint64_t stream) // fastest unsigned integer which is at least 64 bit (as expected by rgen)
 {
+    if (stream > 0 && !_rgen.hasIndependentStreams()) {
+        throw std::invalid_argument("[MCI::setSeed] Selecting a stream requires a random engine with independent streams.");
+    }
     _rgen.seed(seed);
+    if (stream > 0) { _rgen.longJump(stream); } // longJump, so that threads may still use jump() within the stream
+    _resamplingSeed = mixSeed(mixSeed(seed) ^ stream); // differs from seed, so it doesn't repeat the sampling stream of a Philox engine
+}
+
+void MCI::setRandomEngine(const RNGType rngtype)
+{
+    _rgen.setEngine(createRandomEngine(rngtype, _rdev()));
+}
+
+void MCI::setRandomEngine(std::unique_ptr<RandomEngineInterface> engine)
+{
+    _rgen.setEngine(std::move(engine));
 }
 
 void MCI::setTargetAcceptanceRate(const double targetaccrate)
@@ -605,27 +1399,25 @@ void MCI::setX(const double x[])
 
 void MCI::moveX() // for external user, to manually use trialMove on xold
 {
-    _wlkstate.oldToNew(); // our trial moves expect proper xnew
+    _wlkstate.oldToNewFull(); // our trial moves expect proper xnew
     _trialMove->computeTrialMove(_wlkstate);
     _domain->applyDomain(_wlkstate);
-    _wlkstate.newToOld(); // but here we want to set xold
+    _wlkstate.newToOldFull(); // but here we want to set xold
 }
 
 void MCI::newRandomX() // also meant for the user
 {
-    for (int i = 0; i < _ndim; ++i) { _wlkstate.xnew[i] = _rd(_rgen); } // draw random numbers between 0 and 1
+    for (int i = 0; i < _ndim; ++i) { _wlkstate.xnew[i] = _rgen.uniform(); } // draw random numbers between 0 and 1
     _domain->scaleToDomain(_wlkstate.xnew); // shift/scale to proper domain coordinates
-    _wlkstate.newToOld();
+    _wlkstate.newToOldFull();
 }
 
 
 //   --- Constructor and Destructor
 
-MCI::MCI(const int ndim): _ndim(ndim), _wlkstate(_ndim, false)
+MCI::MCI(const int ndim): _ndim(ndim), _rgen(createRandomEngine(RNGType::MT19937_64, _rdev())), _wlkstate(_ndim, false)
 {
-    // initialize random generator
-    _rgen = std::mt19937_64(_rdev()); // passed through to trial moves (for seed consistency)
-    _rd = std::uniform_real_distribution<double>(0., 1.); // used for acceptance (and random moves without pdf)
+    // NOTE: the random generator is passed through to trial moves (for seed consistency)
 
     // domain
     this->resetDomain(); // default to unbound domain
@@ -637,14 +1429,21 @@ MCI::MCI(const int ndim): _ndim(ndim), _wlkstate(_ndim, false)
     _targetaccrate = 0.5;
     _NfindMRT2Iterations = -50; // default to max 50 auto-iterations
     _NdecorrelationSteps = -10000; // default to max 10k auto-steps
+    _NestimatorThreads = 1; // default to serial estimation
+    _resamplingSeed = mixSeed(_rdev()); // until setSeed is called
 
     // initialize file flags
     _flagwlkfile = false;
     _flagobsfile = false;
+    _flagchkfile = false;
+    _flagwarm = false;
 
     //initialize the running counters
     _ridx = 0;
     _acc = 0;
     _rej = 0;
+
+    // by default we are not a worker
+    _flagworker = false;
 }
 }  // namespace mci
@@ -1,4 +1,5 @@
 #include "mci/MJBlocker.hpp"
+#include "mci/SIMDKernels.hpp"
 
 #include <algorithm>
 
@@ -16,140 +17,122 @@ namespace mci
 {
 // --- Constructor/Destructor
 
-MJBlocker::MJBlocker(const int64_t n_data, const int n_dim):
-        ndata(n_data), ndim(n_dim), npow(static_cast<int>(log2(n_data))), // below we check that n is a power of two, so d is a (small) integer
-        _x(new double[ndata*ndim]), _X(new double[ndata*ndim]),
-        _var(new double[npow*ndim]), _gamma(new double[npow*ndim]),
-        _M(new double[npow*ndim]), _Msum(new double[npow*ndim])
+int countPow2(int64_t n)
+{   // floor(log2(n)) for n >= 1
+    int npow = 0;
+    for (; n > 1; n /= 2) { ++npow; }
+    return npow;
+}
+
+MJBlocker::MJBlocker(const int64_t n_data, const int n_dim, const bool in_place):
+        ndata(n_data), ndim(n_dim), npow(countPow2(n_data)),
+        inPlace(in_place), _x((inPlace || ndata < 2) ? nullptr : new double[ndata/2*ndim]),
+        _var(new double[npow*ndim]), _gamma(new double[npow*ndim]), _nred(new int64_t[npow]),
+        _prev(new double[ndim]), _mean(new double[ndim]), _sumred(new double[ndim])
 {
-    if (ndata <= 0) {
-        throw std::invalid_argument("[MJBlocker] ndata must be a natural number.");
-    }
-    if ((static_cast<uint64_t>(ndata) & (static_cast<uint64_t>(ndata) - 1)) != 0) { // ndata must be power of two
-        throw std::invalid_argument("[MJBlocker] ndata must be a power of two.");
+    if (ndata < 2) {
+        throw std::invalid_argument("[MJBlocker] ndata must be at least 2.");
     }
 }
 
 MJBlocker::~MJBlocker()
 {
-    delete[] _Msum;
-    delete[] _M;
+    delete[] _sumred;
+    delete[] _mean;
+    delete[] _prev;
+    delete[] _nred;
     delete[] _gamma;
     delete[] _var;
-    delete[] _X;
     delete[] _x;
 }
 
 // --- Initializers
 
 // estimates mean of x
-void MJBlocker::_computeMean(double mean[]) const
+void MJBlocker::_computeMean(const double x[], double mean[]) const
 {
-    std::fill(mean, mean + ndim, 0.);
-    for (int64_t i = 0; i < ndata; ++i) {
-        for (int j = 0; j < ndim; ++j) {
-            mean[j] += _x[i*ndim + j];
-        }
-    }
+    sumColumns(ndata, ndim, x, mean, nullptr);
     for (int j = 0; j < ndim; ++j) { mean[j] /= ndata; }
 }
 
-// stores x minus mean
-void MJBlocker::_initX(const double mean[])
-{
-    for (int64_t i = 0; i < ndata; ++i) {
-        for (int j = 0; j < ndim; ++j) {
-            _X[i*ndim + j] = _x[i*ndim + j] - mean[j];
-        }
-    }
-}
-
-// --- Operations involving the copies of input data
+// --- Level processing
 
-// estimates gamma_h(0) for all h
-void MJBlocker::_gamma0(double var[], const int64_t nred)
+// estimates gamma_h(0) and gamma_h(1) and performs the blocking transformation, in one pass over pairs of samples
+void MJBlocker::_processLevel(const int k, double mean[], const double x[], double xred[], const int64_t nred)
 {
+    double * const var = _var + k*ndim;
+    double * const gamma = _gamma + k*ndim;
     std::fill(var, var + ndim, 0.);
-    for (int64_t i = 0; i < nred; ++i) {
-        for (int j = 0; j < ndim; ++j) {
-            var[j] += _X[i*ndim + j]*_X[i*ndim + j];
-        }
-    }
-    for (int j = 0; j < ndim; ++j) { var[j] /= nred; }
-}
-
-// estimates gamma_h(1) for all h
-void MJBlocker::_gamma1(double gamma[], const int64_t nred)
-{
     std::fill(gamma, gamma + ndim, 0.);
-    for (int64_t i = 0; i < nred - 1; ++i) {
+    std::fill(_sumred, _sumred + ndim, 0.);
+    std::fill(_prev, _prev + ndim, 0.); // there is no lag-1 product for the first element
+
+    const int64_t npairs = nred/2;
+    blockPairs(npairs, ndim, x, mean, xred, var, gamma, _prev, _sumred); // vectorized kernel (see SIMDKernels.hpp)
+    if (nred%2 == 1) { // the odd tail is part of this level, but is not passed on
         for (int j = 0; j < ndim; ++j) {
-            gamma[j] += _X[i*ndim + j]*_X[(i + 1)*ndim + j];
+            const double Xa = x[(nred - 1)*ndim + j] - mean[j];
+            var[j] += Xa*Xa;
+            gamma[j] += _prev[j]*Xa;
         }
     }
-    for (int j = 0; j < ndim; ++j) { gamma[j] /= nred; }
-}
+    for (int j = 0; j < ndim; ++j) {
+        var[j] /= nred;
+        gamma[j] /= nred;
+    }
+    _nred[k] = nred;
 
-// performs blocking transformation
-int64_t MJBlocker::_transform(const double mean[], const int64_t nred)
-{
-    for (int64_t i = 0; i < nred/2; ++i) {
-        for (int j = 0; j < ndim; ++j) {
-            _x[i*ndim + j] = 0.5*(_x[(2*i)*ndim + j] + _x[(2*i + 1)*ndim + j]);
-            _X[i*ndim + j] = _x[i*ndim + j] - mean[j];
-        }
+    // mean of the next level (differs from the mean of this level, if the tail was dropped)
+    if (nred%2 == 1 && npairs > 0) {
+        for (int j = 0; j < ndim; ++j) { mean[j] = _sumred[j]/npairs; }
     }
-    return nred/2;
 }
 
-// generate test statistics Mk (in reverse order) and perform cumulative sum (stored in _Msum)
-void MJBlocker::_generateM()
-{
-    for (int i = 0; i < npow; ++i) {
-        for (int k = 0; k < ndim; ++k) {
-            _M[(npow - i - 1)*ndim + k] = pow(_gamma[i*ndim + k]/_var[i*ndim + k], 2)*pow(2, npow - i);
-        }
-    }
 
-    // compute cumulative sum
-    std::fill(_Msum, _Msum + npow*ndim, 0.);
-    for (int i = 0; i < npow; ++i) {
-        for (int j = 0; j <= i; ++j) {
-            for (int k = 0; k < ndim; ++k) {
-                _Msum[i*ndim + k] += _M[j*ndim + k];
-            }
-        }
+// find the lowest level for which the cumulative test statistic (summed from the top level down) is below the quantile
+int MJBlocker::selectLevel(const int nlevels, const int stride, const double var[], const double gamma[], const int64_t nred[])
+{
+    int level = nlevels - 1; // fall back to the top level (can't happen for nred[top] == 2)
+    double Msum = 0.;
+    for (int i = 0; i < nlevels; ++i) {
+        const int k = nlevels - 1 - i; // going down from the top level
+        const double ratio = gamma[k*stride]/var[k*stride];
+        Msum += ratio*ratio*nred[k];
+        if (Msum < quantile[i]) { level = k; }
     }
+    return level;
 }
 
 
 // the algorithm which computes the variance of the sample mean.
-void MJBlocker::estimate(const double x[], double avg[], double err[])
+void MJBlocker::_estimate(const double x[], double xred[], double avg[], double err[])
 {
-    std::copy(x, x + ndata*ndim, _x); // first copy our input data ( we don't want to modify the input )
-    this->_computeMean(avg); // store average of x in avg
-    this->_initX(avg); // store x minus avg in _X
+    this->_computeMean(x, avg); // store average of x in avg
+    std::copy(avg, avg + ndim, _mean);
 
     // compute covariance and variance and apply blocking transform
-    int64_t nred = ndata; // will go through powers of 2
+    int64_t nred = ndata; // will go through (roughly) powers of 2
+    const double * xk = x; // data of level k
     for (int k = 0; k < npow; ++k) {
-        this->_gamma0(_var + k*ndim, nred);
-        this->_gamma1(_gamma + k*ndim, nred);
-        nred = this->_transform(avg, nred);
+        this->_processLevel(k, _mean, xk, xred, nred);
+        xk = xred;
+        nred /= 2;
     }
 
-    this->_generateM(); // compute cumulative test statistics sum
-    for (int l = 0; l < ndim; ++l) { // find the first k such that Mk < quantile[k]
-        int k;
-        for (k = npow - 1; k >= 0; --k) {
-            if (_Msum[k*ndim + l] < quantile[k]) {
-                break;
-            }
-        }
-        k = npow - (k + 1);
-
-        // and finally compute the errors
-        err[l] = sqrt(_var[k*ndim + l]/pow(2, npow - k));
+    for (int l = 0; l < ndim; ++l) { // find the level where the test statistics indicate decorrelation
+        const int k = MJBlocker::selectLevel(npow, ndim, _var + l, _gamma + l, _nred);
+        err[l] = sqrt(_var[k*ndim + l]/_nred[k]); // and finally compute the errors
     }
 }
+
+void MJBlocker::estimate(const double x[], double avg[], double err[])
+{
+    if (inPlace) { throw std::runtime_error("[MJBlocker::estimate] MJBlocker was created for in-place estimation only."); }
+    this->_estimate(x, _x, avg, err); // we don't want to modify the input
+}
+
+void MJBlocker::estimateInPlace(double x[], double avg[], double err[])
+{
+    this->_estimate(x, x, avg, err);
+}
 } // namespace mci
@@ -65,7 +65,16 @@ void setSeed(MCI &mci, const std::string &filename, const int offset)
 }
 
 
-void integrate(MCI &mci, const int64_t Nmc, double average[], double error[], const bool doFindMRT2Step, const bool doDecorrelation)
+void setSeed(MCI &mci, const uint64_t seed)
+{
+    if (!mci.getRandomEngine().hasIndependentStreams()) {
+        throw std::runtime_error("Seeding by streams requires a random engine with independent streams.");
+    }
+    mci.setSeed(seed, static_cast<uint64_t>(myrank()));
+}
+
+
+void integrate(MCI &mci, const int64_t Nmc, double average[], double error[], const bool doFindMRT2Step, const bool doDecorrelation, const bool flag_pool)
 {
     // make sure the user has MPI in the correct state
     int isinit, isfinal;
@@ -74,22 +83,23 @@ void integrate(MCI &mci, const int64_t Nmc, double average[], double error[], co
     MPI_Finalized(&isfinal);
     if (isfinal == 1) { throw std::runtime_error("MPI already finalized!"); }
 
-    int nranks = size();
-
-    // the results are stored in myAverage/Error and then reduced into the same average/error for all processes
-    double myAverage[mci.getNObsDim()];
-    double myError[mci.getNObsDim()];
+    // the results of all processes are combined (or their data is merged and estimated on root), so all get the same average/error
+    mci.integrateMPI(Nmc, average, error, doFindMRT2Step, doDecorrelation, flag_pool);
+}
 
-    mci.integrate(Nmc, myAverage, myError, doFindMRT2Step, doDecorrelation);
 
-    MPI_Allreduce(myAverage, average, mci.getNObsDim(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    for (double &e : myError) { e = e*e; } // we will sum the error squares
-    MPI_Allreduce(myError, error, mci.getNObsDim(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+void resume(MCI &mci, const std::string &filepath, double average[], double error[], const bool flag_pool)
+{
+    // make sure the user has MPI in the correct state
+    int isinit, isfinal;
+    MPI_Initialized(&isinit);
+    if (isinit == 0) { throw std::runtime_error("MPI not initialized!"); }
+    MPI_Finalized(&isfinal);
+    if (isfinal == 1) { throw std::runtime_error("MPI already finalized!"); }
 
-    for (int i = 0; i < mci.getNObsDim(); ++i) {
-        average[i] /= nranks;
-        error[i] = sqrt(error[i])/nranks;
-    }
+    // every rank continues from its own checkpoint, then the results are combined like in integrate
+    mci.resumeObservables(filepath);
+    mci.estimateObservablesMPI(average, error, flag_pool);
 }
 
 
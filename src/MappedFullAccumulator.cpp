@@ -0,0 +1,147 @@
+#include "mci/MappedFullAccumulator.hpp"
+
+#include "mci/Checkpoint.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mci
+{
+
+MappedFullAccumulator::MappedFullAccumulator(ObservableFunctionInterface &obs, const int nskip, std::string filepath,
+                                             const bool flag_keep, const bool flag_hugepages):
+        AccumulatorInterface(obs, nskip), _filepath(std::move(filepath)), _flag_keep(flag_keep), _flag_hugepages(flag_hugepages),
+        _fd(-1), _maplen(0), _nstore(0), _ncapacity(0), _storeidx(0), _nfound(0)
+{
+    if (_filepath.empty()) { throw std::invalid_argument("[MappedFullAccumulator] Requested file path is empty."); }
+}
+
+
+void MappedFullAccumulator::_map(const int64_t ncapacity)
+{
+    this->_unmap();
+    const auto len = static_cast<size_t>(ncapacity*_nobs)*sizeof(double);
+    if (ftruncate(_fd, static_cast<off_t>(len)) != 0) {
+        throw std::runtime_error("[MappedFullAccumulator::map] Failed to resize file " + _filepath + ": " + std::strerror(errno));
+    }
+    void * const ptr = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (ptr == MAP_FAILED) {
+        throw std::runtime_error("[MappedFullAccumulator::map] Failed to map file " + _filepath + ": " + std::strerror(errno));
+    }
+    madvise(ptr, len, MADV_SEQUENTIAL); // only hints, so we ignore failures
+#ifdef MADV_HUGEPAGE
+    if (_flag_hugepages) { madvise(ptr, len, MADV_HUGEPAGE); }
+#endif
+    _data = static_cast<double *>(ptr);
+    _maplen = len;
+    _ncapacity = ncapacity;
+}
+
+
+void MappedFullAccumulator::_unmap()
+{
+    if (_data != nullptr) {
+        munmap(_data, _maplen);
+        _data = nullptr;
+        _maplen = 0;
+    }
+}
+
+
+void MappedFullAccumulator::_allocate()
+{
+    _fd = open(_filepath.c_str(), O_RDWR | O_CREAT, 0644); // no O_TRUNC, a checkpoint may refer to the samples in the file
+    if (_fd < 0) {
+        throw std::runtime_error("[MappedFullAccumulator::allocate] Failed to open file " + _filepath + ": " + std::strerror(errno));
+    }
+    struct stat st{};
+    _nfound = (fstat(_fd, &st) == 0) ? static_cast<int64_t>(st.st_size/sizeof(double)) : 0;
+    _nstore = this->getNAccu();
+    this->_map(_nstore); // resized to the new length, the samples get overwritten while accumulating
+}
+
+
+void MappedFullAccumulator::_accumulate()
+{
+    std::copy(_obs_values, _obs_values + _nobs, _data + _storeidx);
+    _storeidx += _nobs;
+}
+
+
+void MappedFullAccumulator::_finalize()
+{   // write back asynchronously, so that the samples survive the process also on a crash afterwards
+    msync(_data, _maplen, MS_ASYNC);
+}
+
+
+void MappedFullAccumulator::_reset()
+{
+    _storeidx = 0;
+}
+
+
+void MappedFullAccumulator::_deallocate()
+{
+    this->_unmap();
+    if (_fd >= 0) {
+        close(_fd);
+        _fd = -1;
+        if (!_flag_keep) { unlink(_filepath.c_str()); }
+    }
+    _nstore = 0;
+    _ncapacity = 0;
+    _nfound = 0;
+}
+
+
+void MappedFullAccumulator::_merge(const int64_t nstore, const int64_t naccu, const double data[])
+{
+    if (nstore != naccu) { throw std::invalid_argument("[MappedFullAccumulator::merge] Passed data must contain one element per accumulated step."); }
+    const int64_t ndata = this->getNData();
+    this->_reserveMerge(nstore); // grows the file only if not reserved before
+    std::copy(data, data + nstore*_nobs, _data + ndata); // append other's samples to ours
+    _nstore += nstore;
+    _storeidx = this->getNData();
+}
+
+
+void MappedFullAccumulator::_reserveMerge(const int64_t nstore)
+{
+    if (_nstore + nstore > _ncapacity) { this->_map(_nstore + nstore); }
+}
+
+
+void MappedFullAccumulator::_saveState(std::ostream &out) const
+{   // the samples stay in the file, so we only save the write position (and the last sample, to verify the file on resume)
+    if (_storeidx > 0 && msync(_data, _maplen, MS_SYNC) != 0) {
+        throw std::runtime_error("[MappedFullAccumulator::saveState] Failed to sync file " + _filepath + ": " + std::strerror(errno));
+    }
+    writeCheckpointValue(out, _storeidx);
+    if (_storeidx > 0) { writeCheckpointArray(out, _data + _storeidx - _nobs, _nobs); }
+}
+
+
+void MappedFullAccumulator::_loadState(std::istream &in)
+{
+    _storeidx = readCheckpointValue<int64_t>(in);
+    if (_storeidx < 0 || _storeidx > this->getNData() || _storeidx%_nobs != 0) {
+        throw std::runtime_error("[MappedFullAccumulator::loadState] Checkpoint contains an invalid storage index.");
+    }
+    if (_storeidx > 0) {
+        std::unique_ptr<double[]> last(new double[_nobs]);
+        readCheckpointArray(in, last.get(), _nobs);
+        if (_storeidx > _nfound || std::memcmp(last.get(), _data + _storeidx - _nobs, _nobs*sizeof(double)) != 0) {
+            throw std::runtime_error("[MappedFullAccumulator::loadState] File " + _filepath + " doesn't contain the samples of the checkpoint.");
+        }
+    }
+}
+}  // namespace mci
@@ -21,7 +21,7 @@ double MultiStepMove::trialMove(WalkerState &wlk, const double/*pold*/[], double
         // find the corresponding sampling function acceptance
         const double pdfAcc = _pdfcont.computeAcceptance(wlk);
         // determine if the proposed x is accepted or not
-        wlk.accepted = (_rd(*_rgen) <= pdfAcc*moveAcc);
+        wlk.accepted = (_rgen->uniform() <= pdfAcc*moveAcc);
         // set state according to result
         if (wlk.accepted) {
             _pdfcont.newToOld();
@@ -1,7 +1,13 @@
 #include "mci/ObservableContainer.hpp"
+#include "mci/Checkpoint.hpp"
+#include "mci/ParallelFor.hpp"
+
+#include <algorithm>
+#include <limits>
 
 namespace mci
 {
+constexpr int ObservableContainer::ESTIMATOR_TILE_WIDTH; // definition (C++14)
 
 int gcd_helper(int a, int b) { // simple recursive greatest common divisor computation
     if (a > b) {
@@ -35,24 +41,147 @@ void ObservableContainer::_setDependsOnPDF()
 }
 
 void ObservableContainer::addObservable(std::unique_ptr<ObservableFunctionInterface> obs,
-                                        const int blocksize, const int nskip, const bool needsEquil, const EstimatorType estimType)
+                                        const int blocksize, const int nskip, const bool needsEquil, const EstimatorType estimType, const int nbins,
+                                        const SampleStorage &storage)
 {
     ObservableContainerElement newElement;
     // obs+accu
     newElement.obs = std::move(obs); // ownership by element
     _nobsdim += newElement.obs->getNObs();
     newElement.depobs = dynamic_cast<DependentObservableInterface *>(newElement.obs.get()); // might be nullptr
-    newElement.accu = createAccumulator(*newElement.obs, blocksize, nskip); // use create from Factories.hpp
+    newElement.accu = createAccumulator(*newElement.obs, blocksize, nskip, estimType, nbins, storage); // use create from Factories.hpp
+    const bool compressed = (dynamic_cast<const CompressedFullAccumulator *>(newElement.accu.get()) != nullptr); // data must be decoded
+    const bool mapped = (dynamic_cast<const MappedFullAccumulator *>(newElement.accu.get()) != nullptr); // data must be kept and not copied
+    const bool colmajor = storage.flag_colmajor; // data is in [nobs][nstore] layout (createAccumulator throws on unsupported combinations)
 
-    // estimator lambda functional (again use create from Factories.hpp)
-    newElement.estim = [accu = newElement.accu.get() /*OK*/, estimator = createEstimator(estimType)](double average[], double error[])
+    // estimator lambda functional (again use create from Factories.hpp), with scratch memory kept over all calls
+    const auto workspace = createEstimatorWorkspace(estimType, newElement.obs->getNObs());
+    newElement.estim = [accu = newElement.accu.get() /*OK*/, estimator = createEstimator(estimType, workspace)](double average[], double error[])
     {
         if (!accu->isFinalized()) {
             throw std::runtime_error("[ObservableContainer.estim] Estimator was called, but accumulator is not finalized.");
         }
         estimator(accu->getNStore(), accu->getNObs(), accu->getData(), average, error);
     };
+    if (estimType == EstimatorType::Autocorrelation) { // we also keep the additional results
+        const int nobs = newElement.accu->getNObs();
+        newElement.tau.reset(new double[nobs]);
+        newElement.ess.reset(new double[nobs]);
+        std::fill(newElement.tau.get(), newElement.tau.get() + nobs, std::numeric_limits<double>::quiet_NaN());
+        std::fill(newElement.ess.get(), newElement.ess.get() + nobs, std::numeric_limits<double>::quiet_NaN());
+        newElement.estim = [accu = newElement.accu.get(), tau = newElement.tau.get(), ess = newElement.ess.get(), workspace](double average[], double error[])
+        {
+            if (!accu->isFinalized()) {
+                throw std::runtime_error("[ObservableContainer.estim] Estimator was called, but accumulator is not finalized.");
+            }
+            AutocorrelationAnalysis(accu->getNStore(), accu->getNObs(), accu->getData(), average, error, tau, ess, *workspace);
+        };
+    }
+    if (estimType == EstimatorType::Covariance) { // keep the covariance matrix as well
+        const int nobs = newElement.accu->getNObs();
+        newElement.cov.reset(new double[static_cast<size_t>(nobs)*nobs]);
+        std::fill(newElement.cov.get(), newElement.cov.get() + static_cast<size_t>(nobs)*nobs, std::numeric_limits<double>::quiet_NaN());
+        newElement.estim = [accu = newElement.accu.get(), cov = newElement.cov.get()](double average[], double error[])
+        {
+            if (!accu->isFinalized()) {
+                throw std::runtime_error("[ObservableContainer.estim] Estimator was called, but accumulator is not finalized.");
+            }
+            CovarianceAccumulator::estimate(accu->getNStore(), accu->getNObs(), accu->getData(), average, error);
+            CovarianceAccumulator::covariance(accu->getNStore(), accu->getNObs(), accu->getData(), cov);
+        };
+    }
+    if (compressed) { // the samples are decoded chunk by chunk into a single pass estimator (see MCI::addCompressedObservable)
+        EstimatorFunction estimator = nullptr;
+        if (estimType == EstimatorType::Uncorrelated) { estimator = CompressedUncorrelatedEstimator; }
+        else if (estimType == EstimatorType::Correlated || estimType == EstimatorType::MJBlocker) { estimator = CompressedMJBlockerEstimator; }
+        newElement.estim = [accu = newElement.accu.get(), estimator](double average[], double error[])
+        {
+            if (!accu->isFinalized()) {
+                throw std::runtime_error("[ObservableContainer.estim] Estimator was called, but accumulator is not finalized.");
+            }
+            if (estimator == nullptr) {
+                throw std::invalid_argument("[ObservableContainer.estim] Compressed samples support only the Uncorrelated and Correlated/MJBlocker estimators.");
+            }
+            estimator(accu->getNStore(), accu->getNObs(), accu->getData(), average, error);
+        };
+    }
+    if (mapped && (estimType == EstimatorType::Correlated || estimType == EstimatorType::MJBlocker)) { // auto-blocking in a single pass over the file
+        newElement.estim = [accu = newElement.accu.get()](double average[], double error[])
+        {
+            if (!accu->isFinalized()) {
+                throw std::runtime_error("[ObservableContainer.estim] Estimator was called, but accumulator is not finalized.");
+            }
+            MJBlockerSinglePassEstimator(accu->getNStore(), accu->getNObs(), accu->getData(), average, error);
+        };
+    }
+    if (colmajor) { // every column is estimated on its own
+        newElement.estim = [accu = newElement.accu.get(), estimator = createColumnMajorEstimator(estimType, workspace),
+                            tau = newElement.tau.get(), ess = newElement.ess.get(), workspace](double average[], double error[])
+        {
+            if (!accu->isFinalized()) {
+                throw std::runtime_error("[ObservableContainer.estim] Estimator was called, but accumulator is not finalized.");
+            }
+            const int64_t nstore = accu->getNStore();
+            const double * const data = accu->getData();
+            if (tau != nullptr) {
+                for (int j = 0; j < accu->getNObs(); ++j) {
+                    AutocorrelationAnalysis(nstore, 1, data + j*nstore, average + j, error + j, tau + j, ess + j, *workspace);
+                }
+            }
+            else { estimator(nstore, accu->getNObs(), data, average, error); }
+        };
+    }
+
+    const auto inPlaceEstimator = createInPlaceEstimator(estimType);
+    if (inPlaceEstimator && !compressed && !mapped) {
+        newElement.estimInPlace = [accu = newElement.accu.get(), estimator = colmajor ? createColumnMajorInPlaceEstimator(estimType, workspace)
+                                                                                      : createInPlaceEstimator(estimType, workspace)](double average[], double error[])
+        {
+            estimator(accu->getNStore(), accu->getNObs(), accu->consumeData(), average, error); // consumeData throws if not finalized
+        };
+    }
+
+    // column tiles are estimated on a copy, so we may always use the in-place version
+    // (tiles are processed concurrently, so here we use the estimators without shared workspace)
+    newElement.estimCols = [accu = newElement.accu.get(), estimator = createEstimator(estimType), inPlaceEstimator,
+                            tau = newElement.tau.get(), ess = newElement.ess.get()](const int j0, const int ncols, double buffer[], double average[], double error[])
+    {
+        if (!accu->isFinalized()) {
+            throw std::runtime_error("[ObservableContainer.estimCols] Estimator was called, but accumulator is not finalized.");
+        }
+        const int64_t nstore = accu->getNStore();
+        const int nobs = accu->getNObs();
+        const double * const data = accu->getData();
+        for (int64_t i = 0; i < nstore; ++i) { // gather the columns
+            std::copy(data + i*nobs + j0, data + i*nobs + j0 + ncols, buffer + i*ncols);
+        }
+        if (tau != nullptr) { AutocorrelationAnalysis(nstore, ncols, buffer, average, error, tau + j0, ess + j0); }
+        else if (inPlaceEstimator) { inPlaceEstimator(nstore, ncols, buffer, average, error); }
+        else { estimator(nstore, ncols, buffer, average, error); }
+    };
+    if (colmajor) { // the columns are contiguous already, so we estimate them without copying (and buffer is unused)
+        newElement.estimCols = [accu = newElement.accu.get(), estimator = createColumnMajorEstimator(estimType),
+                                tau = newElement.tau.get(), ess = newElement.ess.get()](const int j0, const int ncols, double * /*buffer*/, double average[], double error[])
+        {
+            if (!accu->isFinalized()) {
+                throw std::runtime_error("[ObservableContainer.estimCols] Estimator was called, but accumulator is not finalized.");
+            }
+            const int64_t nstore = accu->getNStore();
+            const double * const data = accu->getData() + j0*nstore;
+            if (tau != nullptr) {
+                for (int j = 0; j < ncols; ++j) {
+                    AutocorrelationAnalysis(nstore, 1, data + j*nstore, average + j, error + j, tau + j0 + j, ess + j0 + j);
+                }
+            }
+            else { estimator(nstore, ncols, data, average, error); }
+        };
+    }
 
+    newElement.blocksize = blocksize;
+    newElement.nbins = nbins;
+    newElement.storage = storage;
+    newElement.flag_tiles = !newElement.cov && !compressed && !mapped; // the covariance needs all columns, the others would copy the data
+    newElement.estimType = estimType;
     newElement.flag_equil = needsEquil;
     _cont.push_back(std::move(newElement)); // and then into container
     this->_setDependsOnPDF(); // keep it simple and call this to update the depend flag
@@ -93,6 +222,17 @@ void ObservableContainer::printObsValues(std::ofstream &file) const
 }
 
 
+void ObservableContainer::getObsValues(double values[]) const
+{
+    int offset = 0;
+    for (auto &el : _cont) {
+        const int nobs = el.accu->getNObs();
+        std::copy(el.accu->getObsValues(), el.accu->getObsValues() + nobs, values + offset);
+        offset += nobs;
+    }
+}
+
+
 void ObservableContainer::finalize()
 {
     for (auto &el : _cont) {
@@ -101,8 +241,98 @@ void ObservableContainer::finalize()
 }
 
 
-void ObservableContainer::estimate(double average[], double error[]) const
+void ObservableContainer::merge(const ObservableContainer &other)
+{
+    if (other.size() != this->size()) {
+        throw std::invalid_argument("[ObservableContainer::merge] Containers to merge must contain the same number of observables.");
+    }
+    for (int i = 0; i < this->size(); ++i) {
+        _cont[i].accu->merge(*other._cont[i].accu);
+    }
+}
+
+void ObservableContainer::merge(const int i, const int64_t nsteps, const int64_t naccu, const int64_t nstore, const double data[])
 {
+    _cont[i].accu->merge(nsteps, naccu, nstore, data);
+}
+
+void ObservableContainer::reserveMerge(const int i, const int64_t nstore)
+{
+    _cont[i].accu->reserveMerge(nstore);
+}
+
+void ObservableContainer::saveState(std::ostream &out) const
+{
+    writeCheckpointValue(out, this->size());
+    for (auto &el : _cont) {
+        el.accu->saveState(out);
+    }
+}
+
+void ObservableContainer::loadState(std::istream &in)
+{
+    expectCheckpointValue(in, this->size(), "[ObservableContainer::loadState] Checkpoint contains a different number of observables.");
+    for (auto &el : _cont) {
+        el.accu->loadState(in);
+    }
+}
+
+
+void ObservableContainer::_estimateParallel(double average[], double error[], const int nthreads, const bool inPlace) const
+{
+    struct EstimTask
+    {
+        int iel; // index of container element
+        int j0; // first column
+        int ncols; // number of columns (all if the observable is not tiled)
+        int offset; // offset of the element in average/error
+    };
+
+    // small observables are one task, larger ones are split into column tiles
+    // (except row-major data that may be estimated in place, because the tiles would need a copy of the data)
+    std::vector<EstimTask> tasks;
+    int64_t maxbuf = 0; // max buffer size needed by the tiles
+    int offset = 0;
+    for (int i = 0; i < this->size(); ++i) {
+        const int nobs = _cont[i].accu->getNObs();
+        const bool noGather = inPlace && _cont[i].estimInPlace && !_cont[i].storage.flag_colmajor;
+        if (nobs <= ESTIMATOR_TILE_WIDTH || !_cont[i].flag_tiles || noGather) { tasks.push_back({i, 0, nobs, offset}); }
+        else {
+            for (int j0 = 0; j0 < nobs; j0 += ESTIMATOR_TILE_WIDTH) {
+                tasks.push_back({i, j0, std::min(ESTIMATOR_TILE_WIDTH, nobs - j0), offset});
+            }
+            if (!_cont[i].storage.flag_colmajor) { maxbuf = std::max(maxbuf, _cont[i].accu->getNStore()*ESTIMATOR_TILE_WIDTH); } // else no gather
+        }
+        offset += nobs;
+    }
+
+    const int nworkers = selectNThreads(static_cast<int64_t>(tasks.size()), nthreads);
+    std::vector<std::vector<double>> buffers(static_cast<size_t>(nworkers)); // per-thread gather buffers (allocated on demand)
+    parallelFor(static_cast<int64_t>(tasks.size()), nworkers, [this, &tasks, &buffers, maxbuf, inPlace, average, error](const int64_t itask, const int ithread)
+    {
+        const EstimTask &task = tasks[itask];
+        const ObservableContainerElement &el = _cont[task.iel];
+        double * const avg = average + task.offset + task.j0;
+        double * const err = error + task.offset + task.j0;
+        if (task.ncols == el.accu->getNObs()) { // whole observable
+            if (inPlace && el.estimInPlace) { el.estimInPlace(avg, err); }
+            else { el.estim(avg, err); }
+        }
+        else {
+            std::vector<double> &buffer = buffers[ithread];
+            buffer.resize(static_cast<size_t>(maxbuf));
+            el.estimCols(task.j0, task.ncols, buffer.data(), avg, err);
+        }
+    });
+}
+
+
+void ObservableContainer::estimate(double average[], double error[], const int nthreads) const
+{
+    if (nthreads != 1) {
+        this->_estimateParallel(average, error, nthreads, false);
+        return;
+    }
     int offset = 0;
     for (auto &el : _cont) { // go through estimators and write to avg/error blocks
         el.estim(average + offset, error + offset);
@@ -111,6 +341,58 @@ void ObservableContainer::estimate(double average[], double error[]) const
 }
 
 
+void ObservableContainer::estimateInPlace(double average[], double error[], const int nthreads)
+{
+    if (nthreads != 1) {
+        this->_estimateParallel(average, error, nthreads, true);
+        return;
+    }
+    int offset = 0;
+    for (auto &el : _cont) { // like above, but prefer the in-place estimators
+        if (el.estimInPlace) { el.estimInPlace(average + offset, error + offset); }
+        else { el.estim(average + offset, error + offset); }
+        offset += el.accu->getNObs();
+    }
+}
+
+
+void ObservableContainer::getAutocorrelation(double tau[], double ess[]) const
+{
+    int offset = 0;
+    for (auto &el : _cont) {
+        const int nobs = el.accu->getNObs();
+        if (el.tau) {
+            std::copy(el.tau.get(), el.tau.get() + nobs, tau + offset);
+            std::copy(el.ess.get(), el.ess.get() + nobs, ess + offset);
+        }
+        else {
+            std::fill(tau + offset, tau + offset + nobs, std::numeric_limits<double>::quiet_NaN());
+            std::fill(ess + offset, ess + offset + nobs, std::numeric_limits<double>::quiet_NaN());
+        }
+        offset += nobs;
+    }
+}
+
+
+void ObservableContainer::getCovariance(const int i, double cov[]) const
+{
+    const int nobs = _cont[i].accu->getNObs();
+    if (_cont[i].cov) { std::copy(_cont[i].cov.get(), _cont[i].cov.get() + static_cast<size_t>(nobs)*nobs, cov); }
+    else { std::fill(cov, cov + static_cast<size_t>(nobs)*nobs, std::numeric_limits<double>::quiet_NaN()); }
+}
+
+
+void ObservableContainer::scaleCovariance(const double factor)
+{
+    for (auto &el : _cont) {
+        if (el.cov) {
+            const int nobs = el.accu->getNObs();
+            for (int64_t k = 0; k < static_cast<int64_t>(nobs)*nobs; ++k) { el.cov[k] *= factor; }
+        }
+    }
+}
+
+
 void ObservableContainer::reset()
 {
     for (auto &el : _cont) {
@@ -0,0 +1,50 @@
+#include "mci/ParallelFor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace mci
+{
+
+int selectNThreads(const int64_t ntasks, int nthreads)
+{
+    if (nthreads < 1) { // use all available hardware threads
+        nthreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    return static_cast<int>(std::max(int64_t(1), std::min(int64_t(nthreads), ntasks))); // no idle threads
+}
+
+
+void parallelFor(const int64_t ntasks, int nthreads, const std::function<void(int64_t, int)> &task)
+{
+    nthreads = selectNThreads(ntasks, nthreads);
+    if (nthreads == 1) { // no threads needed
+        for (int64_t i = 0; i < ntasks; ++i) { task(i, 0); }
+        return;
+    }
+
+    std::atomic<int64_t> next{0}; // next task to hand out
+    std::vector<std::exception_ptr> errors(static_cast<size_t>(nthreads));
+    const auto work = [&task, &next, &errors, ntasks](const int ithread)
+    {
+        try {
+            for (int64_t i = next++; i < ntasks; i = next++) { task(i, ithread); }
+        }
+        catch (...) {
+            errors[ithread] = std::current_exception();
+            next = ntasks; // let the other threads stop early
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < nthreads; ++i) { threads.emplace_back(work, i); }
+    work(0); // the calling thread works as well
+    for (auto &thread : threads) { thread.join(); }
+    for (auto &err : errors) {
+        if (err) { std::rethrow_exception(err); }
+    }
+}
+}  // namespace mci
@@ -0,0 +1,116 @@
+#include "mci/PhiloxEngine.hpp"
+
+#include "mci/Checkpoint.hpp"
+
+namespace mci
+{
+
+inline void mulhilo64(const uint64_t a, const uint64_t b, uint64_t &hi, uint64_t &lo)
+{
+#ifdef __SIZEOF_INT128__
+    const unsigned __int128 prod = static_cast<unsigned __int128>(a)*b;
+    hi = static_cast<uint64_t>(prod >> 64);
+    lo = static_cast<uint64_t>(prod);
+#else
+    // portable version via 32-bit halves
+    const uint64_t a0 = a & 0xffffffff, a1 = a >> 32, b0 = b & 0xffffffff, b1 = b >> 32;
+    const uint64_t p00 = a0*b0, p01 = a0*b1, p10 = a1*b0, p11 = a1*b1;
+    const uint64_t mid = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+    hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    lo = a*b;
+#endif
+}
+
+void PhiloxEngine::seed(const uint64_t seed)
+{
+    std::fill(_ctr, _ctr + 4, 0);
+    _key[0] = seed;
+    _key[1] = 0;
+    _bidx = 4; // empty
+}
+
+void PhiloxEngine::_addToCounter(uint64_t n, const int word)
+{
+    for (int i = word; i < 4 && n > 0; ++i) {
+        const uint64_t old = _ctr[i];
+        _ctr[i] += n;
+        n = (_ctr[i] < old) ? 1 : 0; // carry
+    }
+}
+
+void PhiloxEngine::_nextBlock()
+{
+    const uint64_t M0 = 0xD2E7470EE14C6C93, M1 = 0xCA5A826395121157; // multipliers
+    const uint64_t W0 = 0x9E3779B97F4A7C15, W1 = 0xBB67AE8584CAA73B; // Weyl key increments
+
+    uint64_t c[4] = {_ctr[0], _ctr[1], _ctr[2], _ctr[3]};
+    uint64_t k0 = _key[0], k1 = _key[1];
+    for (int r = 0; r < 10; ++r) {
+        uint64_t hi0, lo0, hi1, lo1;
+        mulhilo64(M0, c[0], hi0, lo0);
+        mulhilo64(M1, c[2], hi1, lo1);
+        c[0] = hi1 ^ c[1] ^ k0;
+        c[1] = lo1;
+        c[2] = hi0 ^ c[3] ^ k1;
+        c[3] = lo0;
+        k0 += W0;
+        k1 += W1;
+    }
+    std::copy(c, c + 4, _block);
+    _bidx = 0;
+    this->_addToCounter(1, 0);
+}
+
+void PhiloxEngine::generate(uint64_t out[], const int n)
+{
+    for (int i = 0; i < n; ++i) {
+        if (_bidx == 4) { this->_nextBlock(); }
+        out[i] = _block[_bidx++];
+    }
+}
+
+void PhiloxEngine::discard(uint64_t n)
+{
+    const auto nleft = static_cast<uint64_t>(4 - _bidx);
+    if (n <= nleft) {
+        _bidx += static_cast<int>(n);
+        return;
+    }
+    n -= nleft;
+    this->_addToCounter(n/4, 0); // skip full blocks
+    _bidx = 4;
+    if (n%4 != 0) {
+        this->_nextBlock();
+        _bidx = static_cast<int>(n%4);
+    }
+}
+
+void PhiloxEngine::jump(const uint64_t n)
+{
+    this->_addToCounter(n, 2);
+    _bidx = 4; // rest of the current block belongs to the old stream
+}
+
+void PhiloxEngine::longJump(const uint64_t n)
+{
+    this->_addToCounter(n, 3);
+    _bidx = 4;
+}
+
+void PhiloxEngine::saveState(std::ostream &out) const
+{
+    writeCheckpointArray(out, _ctr, 4);
+    writeCheckpointArray(out, _key, 2);
+    writeCheckpointArray(out, _block, 4);
+    writeCheckpointValue(out, _bidx);
+}
+
+void PhiloxEngine::loadState(std::istream &in)
+{
+    readCheckpointArray(in, _ctr, 4);
+    readCheckpointArray(in, _key, 2);
+    readCheckpointArray(in, _block, 4);
+    _bidx = readCheckpointValue<int>(in);
+    if (_bidx < 0 || _bidx > 4) { throw std::runtime_error("[PhiloxEngine::loadState] Checkpoint contains an invalid engine state."); }
+}
+}  // namespace mci
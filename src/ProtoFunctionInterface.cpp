@@ -1,13 +1,16 @@
 #include "mci/ProtoFunctionInterface.hpp"
 
+#include "mci/Checkpoint.hpp"
+
 #include <algorithm>
 #include <stdexcept>
+#include <typeinfo>
 
 namespace mci
 {
 
 ProtoFunctionInterface::ProtoFunctionInterface(const int ndim, const int nproto):
-        _ndim(ndim), _nproto(0), _protoold(nullptr), _protonew(nullptr)
+        _ndim(ndim), _nproto(0), _protoold(nullptr), _protonew(nullptr), _flag_dirtyAll(true), _dirtyBegin(0), _dirtyEnd(0)
 {
     if (ndim < 1) { throw std::invalid_argument("[ProtoFunctionInterface] Number of dimensions must be at least 1."); }
     this->setNProto(nproto);
@@ -35,23 +38,55 @@ void ProtoFunctionInterface::setNProto(const int nproto)
         _protonew = nullptr;
         _nproto = 0;
     }
+    this->_resetDirty();
 }
 
 void ProtoFunctionInterface::initializeProtoValues(const double xold[])
 {
     this->protoFunction(xold, _protonew);
+    this->_resetDirty(); // all values are new
     this->newToOld();
 }
 
 void ProtoFunctionInterface::newToOld()
 {   // copy new values to old
     this->_newToOld();
-    std::copy(_protonew, _protonew + _nproto, _protoold);
+    if (_flag_dirtyAll) {
+        std::copy(_protonew, _protonew + _nproto, _protoold);
+    }
+    else {
+        std::copy(_protonew + _dirtyBegin, _protonew + _dirtyEnd, _protoold + _dirtyBegin);
+    }
+    this->_resetDirty();
 }
 
 void ProtoFunctionInterface::oldToNew()
 {   // copy old values to new
     this->_oldToNew();
+    if (_flag_dirtyAll) {
+        std::copy(_protoold, _protoold + _nproto, _protonew);
+    }
+    else {
+        std::copy(_protoold + _dirtyBegin, _protoold + _dirtyEnd, _protonew + _dirtyBegin);
+    }
+    this->_resetDirty();
+}
+
+void ProtoFunctionInterface::saveState(std::ostream &out) const
+{
+    writeCheckpointString(out, typeid(*this).name());
+    writeCheckpointValue(out, _nproto);
+    writeCheckpointArray(out, _protoold, _nproto);
+    this->_saveState(out);
+}
+
+void ProtoFunctionInterface::loadState(std::istream &in)
+{
+    expectCheckpointString(in, typeid(*this).name(), "[ProtoFunctionInterface::loadState] Checkpoint was written for a different type.");
+    expectCheckpointValue(in, _nproto, "[ProtoFunctionInterface::loadState] Checkpoint contains a different number of proto values.");
+    readCheckpointArray(in, _protoold, _nproto);
     std::copy(_protoold, _protoold + _nproto, _protonew);
+    this->_resetDirty();
+    this->_loadState(in);
 }
 }  // namespace mci
@@ -0,0 +1,169 @@
+#include "mci/RandomGenerator.hpp"
+
+#include "mci/Checkpoint.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <typeinfo>
+
+namespace mci
+{
+constexpr int RandomGenerator::BUFFER_SIZE;
+
+// Tables for the ziggurat method with 128 layers, in the version of J. A. Doornik (2005),
+// "An Improved Ziggurat Method to Generate Normal Random Samples".
+struct ZigguratTables
+{
+    static constexpr int NLAYERS = 128;
+    static constexpr double R = 3.442619855899; // start of the tail
+    static constexpr double V = 9.91256303526217e-3; // area of every layer
+
+    double x[NLAYERS + 1]; // layer boundaries
+    double ratio[NLAYERS]; // x[i+1]/x[i]
+
+    ZigguratTables()
+    {
+        double f = exp(-0.5*R*R);
+        x[0] = V/f; // the base layer, including tail
+        x[1] = R;
+        x[NLAYERS] = 0.;
+        for (int i = 2; i < NLAYERS; ++i) {
+            x[i] = sqrt(-2.*log(V/x[i - 1] + f));
+            f = exp(-0.5*x[i]*x[i]);
+        }
+        for (int i = 0; i < NLAYERS; ++i) { ratio[i] = x[i + 1]/x[i]; }
+    }
+};
+constexpr int ZigguratTables::NLAYERS;
+constexpr double ZigguratTables::R;
+constexpr double ZigguratTables::V;
+
+inline double bitsToUniform(const uint64_t bits) { return static_cast<double>(bits >> 11)*(1./9007199254740992.); } // [0,1), i.e. 53 bits times 2^-53
+
+
+RandomGenerator::RandomGenerator(std::unique_ptr<RandomEngineInterface> engine):
+        _engine(nullptr), _buffer(new uint64_t[BUFFER_SIZE]), _ubuffer(new double[BUFFER_SIZE]), _nbuffer(new double[BUFFER_SIZE]),
+        _bufidx(BUFFER_SIZE), _uidx(BUFFER_SIZE), _nidx(BUFFER_SIZE)
+{
+    this->setEngine(std::move(engine));
+}
+
+RandomGenerator::~RandomGenerator()
+{
+    delete[] _nbuffer;
+    delete[] _ubuffer;
+    delete[] _buffer;
+}
+
+void RandomGenerator::_refillUniform()
+{
+    uint64_t bits[BUFFER_SIZE];
+    _engine->generate(bits, BUFFER_SIZE);
+    for (int i = 0; i < BUFFER_SIZE; ++i) { _ubuffer[i] = bitsToUniform(bits[i]); } // vectorizable
+    _uidx = 0;
+}
+
+void RandomGenerator::_refillNormal()
+{
+    static const ZigguratTables zig; // thread-safe init on first use
+    using ZT = ZigguratTables;
+
+    uint64_t bits[BUFFER_SIZE]; // one draw per first attempt, rare rejections draw more below
+    _engine->generate(bits, BUFFER_SIZE);
+    for (int i = 0; i < BUFFER_SIZE; ++i) {
+        uint64_t b = bits[i];
+        for (;;) {
+            const int layer = static_cast<int>(b & (ZT::NLAYERS - 1)); // lowest 7 bits
+            const double u = 2.*bitsToUniform(b) - 1.; // highest 53 bits, in [-1,1)
+            if (fabs(u) < zig.ratio[layer]) { // inside the layer's core rectangle (~99% of cases)
+                _nbuffer[i] = u*zig.x[layer];
+                break;
+            }
+            if (layer == 0) { // sample from tail
+                double x, y;
+                do {
+                    x = -log(1. - this->uniform())/ZT::R;
+                    y = -log(1. - this->uniform());
+                } while (y + y < x*x);
+                _nbuffer[i] = (u < 0.) ? -(ZT::R + x) : ZT::R + x;
+                break;
+            }
+            // wedge between this and the next layer
+            const double x = u*zig.x[layer];
+            const double f0 = exp(-0.5*(zig.x[layer]*zig.x[layer] - x*x));
+            const double f1 = exp(-0.5*(zig.x[layer + 1]*zig.x[layer + 1] - x*x));
+            if (f1 + this->uniform()*(f0 - f1) < 1.) {
+                _nbuffer[i] = x;
+                break;
+            }
+            b = (*this)(); // rejected, try again
+        }
+    }
+    _nidx = 0;
+}
+
+void RandomGenerator::setEngine(std::unique_ptr<RandomEngineInterface> engine)
+{
+    if (!engine) { throw std::invalid_argument("[RandomGenerator::setEngine] Passed engine is nullptr."); }
+    _engine = std::move(engine);
+    this->_clearBuffers();
+}
+
+void RandomGenerator::seed(const uint64_t seed)
+{
+    _engine->seed(seed);
+    this->_clearBuffers();
+}
+
+void RandomGenerator::discard(uint64_t n)
+{
+    const auto nbuf = static_cast<uint64_t>(BUFFER_SIZE - _bufidx);
+    if (n <= nbuf) { // skip within buffer
+        _bufidx += static_cast<int>(n);
+        _uidx = _nidx = BUFFER_SIZE; // buffered doubles are drawn anew
+        return;
+    }
+    _engine->discard(n - nbuf);
+    this->_clearBuffers();
+}
+
+void RandomGenerator::jump(const uint64_t n)
+{
+    _engine->jump(n);
+    this->_clearBuffers();
+}
+
+void RandomGenerator::longJump(const uint64_t n)
+{
+    _engine->longJump(n);
+    this->_clearBuffers();
+}
+
+void RandomGenerator::saveState(std::ostream &out) const
+{
+    writeCheckpointString(out, typeid(*_engine).name());
+    _engine->saveState(out);
+    writeCheckpointArray(out, _buffer, BUFFER_SIZE);
+    writeCheckpointArray(out, _ubuffer, BUFFER_SIZE);
+    writeCheckpointArray(out, _nbuffer, BUFFER_SIZE);
+    const int idx[3] = {_bufidx, _uidx, _nidx};
+    writeCheckpointArray(out, idx, 3);
+}
+
+void RandomGenerator::loadState(std::istream &in)
+{
+    expectCheckpointString(in, typeid(*_engine).name(), "[RandomGenerator::loadState] Checkpoint was written with a different random engine.");
+    _engine->loadState(in);
+    readCheckpointArray(in, _buffer, BUFFER_SIZE);
+    readCheckpointArray(in, _ubuffer, BUFFER_SIZE);
+    readCheckpointArray(in, _nbuffer, BUFFER_SIZE);
+    int idx[3];
+    readCheckpointArray(in, idx, 3);
+    for (const int i : idx) {
+        if (i < 0 || i > BUFFER_SIZE) { throw std::runtime_error("[RandomGenerator::loadState] Checkpoint contains invalid buffer indices."); }
+    }
+    _bufidx = idx[0];
+    _uidx = idx[1];
+    _nidx = idx[2];
+}
+}  // namespace mci
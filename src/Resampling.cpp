@@ -0,0 +1,93 @@
+#include "mci/Resampling.hpp"
+#include "mci/ParallelFor.hpp"
+#include "mci/PhiloxEngine.hpp"
+#include "mci/SIMDKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace mci
+{
+
+void calcGroupAverages(const int64_t nblocks, const int nobs, const double data[], const int ngroups, const int stride, double groupavg[])
+{
+    if (ngroups < 2 || nblocks < ngroups) {
+        throw std::invalid_argument("[calcGroupAverages] At least 2 groups and at least one block per group are required.");
+    }
+    const int64_t npergroup = nblocks/ngroups; // if there is a rest, it is ignored
+    const double norm = 1./npergroup;
+    for (int g = 0; g < ngroups; ++g) {
+        double * const avg = groupavg + g*stride;
+        sumColumns(npergroup, nobs, data + g*npergroup*nobs, avg, nullptr); // vectorized (see SIMDKernels.hpp)
+        for (int j = 0; j < nobs; ++j) { avg[j] *= norm; }
+    }
+}
+
+
+void resampleDerived(const ResamplingType type, const int ngroups, const int nobs, const double groupavg[], const DerivedFunction &f, const int nout,
+                     double value[], double error[], int nresamples, const uint64_t seed, const int nthreads)
+{
+    if (ngroups < 2) {
+        throw std::invalid_argument("[resampleDerived] At least 2 groups are required.");
+    }
+    if (type == ResamplingType::Jackknife) { nresamples = ngroups; }
+    else if (nresamples < 2) {
+        throw std::invalid_argument("[resampleDerived] At least 2 bootstrap resamples are required.");
+    }
+
+    // f of the full average
+    std::vector<double> sum(static_cast<size_t>(nobs));
+    sumColumns(ngroups, nobs, groupavg, sum.data(), nullptr);
+    std::vector<double> avg(sum);
+    for (auto &a : avg) { a /= ngroups; }
+    std::vector<double> fullval(static_cast<size_t>(nout));
+    f(avg.data(), fullval.data());
+
+    // f of the resampled averages
+    const int nworkers = selectNThreads(nresamples, nthreads);
+    std::vector<std::vector<double>> buffers(static_cast<size_t>(nworkers), std::vector<double>(static_cast<size_t>(nobs)));
+    std::vector<std::vector<uint64_t>> draws(static_cast<size_t>(nworkers)); // bootstrap only
+    std::vector<double> resval(static_cast<size_t>(nresamples)*nout);
+    parallelFor(nresamples, nworkers, [&](const int64_t r, const int ithread)
+    {
+        double * const ravg = buffers[ithread].data();
+        if (type == ResamplingType::Jackknife) { // leave out group r
+            for (int j = 0; j < nobs; ++j) { ravg[j] = (sum[j] - groupavg[r*nobs + j])/(ngroups - 1); }
+        }
+        else { // draw ngroups groups with replacement
+            std::vector<uint64_t> &idx = draws[ithread];
+            idx.resize(static_cast<size_t>(ngroups));
+            PhiloxEngine rng(seed);
+            rng.jump(static_cast<uint64_t>(r)); // every resample has its own stream
+            rng.generate(idx.data(), ngroups);
+            std::fill(ravg, ravg + nobs, 0.);
+            for (int g = 0; g < ngroups; ++g) {
+                const double * const grp = groupavg + (idx[g]%ngroups)*nobs;
+                for (int j = 0; j < nobs; ++j) { ravg[j] += grp[j]; }
+            }
+            for (int j = 0; j < nobs; ++j) { ravg[j] /= ngroups; }
+        }
+        f(ravg, resval.data() + r*nout);
+    });
+
+    // mean and spread of the resampled values
+    for (int k = 0; k < nout; ++k) {
+        double mean = 0.;
+        for (int r = 0; r < nresamples; ++r) { mean += resval[r*nout + k]; }
+        mean /= nresamples;
+        double var = 0.;
+        for (int r = 0; r < nresamples; ++r) { var += (resval[r*nout + k] - mean)*(resval[r*nout + k] - mean); }
+
+        if (type == ResamplingType::Jackknife) {
+            value[k] = ngroups*fullval[k] - (ngroups - 1)*mean; // bias corrected
+            error[k] = sqrt(var*(ngroups - 1.)/ngroups);
+        }
+        else {
+            value[k] = fullval[k];
+            error[k] = sqrt(var/(nresamples - 1.));
+        }
+    }
+}
+}  // namespace mci
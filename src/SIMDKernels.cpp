@@ -0,0 +1,339 @@
+#include "mci/SIMDKernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define MCI_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define MCI_SIMD_X86 0
+#endif
+
+namespace mci
+{
+
+// The vector kernels go through the data in chunks of rows, which stay in cache while the column blocks are processed.
+// The chunk size does not depend on ndim, so the results for a column don't depend on the other columns.
+const int64_t CHUNK_ROWS = 64;
+
+
+// --- Scalar kernels (fallback, and for the remaining columns [j0, ndim) of the vector kernels)
+
+void addColumnsScalar(const int64_t n, const int ndim, const int j0, const double x[], double sum[], double sumsq[])
+{   // add to sum/sumsq
+    if (sumsq != nullptr) {
+        for (int64_t i = 0; i < n; ++i) {
+            for (int j = j0; j < ndim; ++j) {
+                sum[j] += x[i*ndim + j];
+                sumsq[j] += x[i*ndim + j]*x[i*ndim + j];
+            }
+        }
+    }
+    else {
+        for (int64_t i = 0; i < n; ++i) {
+            for (int j = j0; j < ndim; ++j) { sum[j] += x[i*ndim + j]; }
+        }
+    }
+}
+
+void blockPairsScalar(const int64_t npairs, const int ndim, const int j0, const double x[], const double mean[], double xred[],
+                      double var[], double gamma[], double prev[], double sumred[])
+{
+    for (int64_t i = 0; i < npairs; ++i) { // xred[i] is written after x[2i] and x[2i+1] were read, so xred may be x
+        for (int j = j0; j < ndim; ++j) {
+            const double xa = x[2*i*ndim + j];
+            const double xb = x[(2*i + 1)*ndim + j];
+            const double Xa = xa - mean[j];
+            const double Xb = xb - mean[j];
+            var[j] += Xa*Xa;
+            var[j] += Xb*Xb;
+            gamma[j] += prev[j]*Xa;
+            gamma[j] += Xa*Xb;
+            prev[j] = Xb;
+            xred[i*ndim + j] = 0.5*(xa + xb);
+            sumred[j] += xred[i*ndim + j];
+        }
+    }
+}
+
+
+void sumColumnsScalar(const int64_t n, const int ndim, const double x[], double sum[], double sumsq[])
+{
+    std::fill(sum, sum + ndim, 0.);
+    if (sumsq != nullptr) { std::fill(sumsq, sumsq + ndim, 0.); }
+    addColumnsScalar(n, ndim, 0, x, sum, sumsq);
+}
+
+
+#if MCI_SIMD_X86 == 1
+// --- AVX2 kernels (4 doubles per vector)
+
+__attribute__((target("avx2,fma")))
+void addColumnsAVX2(const int64_t n, const int ndim, const double x[], double sum[], double sumsq[])
+{
+    const bool flag_sq = (sumsq != nullptr);
+    int j = 0;
+    for (; j + 16 <= ndim; j += 16) { // 4 vectors of columns at once
+        __m256d s0 = _mm256_loadu_pd(sum + j), s1 = _mm256_loadu_pd(sum + j + 4);
+        __m256d s2 = _mm256_loadu_pd(sum + j + 8), s3 = _mm256_loadu_pd(sum + j + 12);
+        __m256d q0 = _mm256_setzero_pd(), q1 = q0, q2 = q0, q3 = q0;
+        if (flag_sq) {
+            q0 = _mm256_loadu_pd(sumsq + j);
+            q1 = _mm256_loadu_pd(sumsq + j + 4);
+            q2 = _mm256_loadu_pd(sumsq + j + 8);
+            q3 = _mm256_loadu_pd(sumsq + j + 12);
+        }
+        const double * xi = x + j;
+        for (int64_t i = 0; i < n; ++i, xi += ndim) {
+            const __m256d x0 = _mm256_loadu_pd(xi), x1 = _mm256_loadu_pd(xi + 4);
+            const __m256d x2 = _mm256_loadu_pd(xi + 8), x3 = _mm256_loadu_pd(xi + 12);
+            s0 = _mm256_add_pd(s0, x0);
+            s1 = _mm256_add_pd(s1, x1);
+            s2 = _mm256_add_pd(s2, x2);
+            s3 = _mm256_add_pd(s3, x3);
+            if (flag_sq) {
+                q0 = _mm256_fmadd_pd(x0, x0, q0);
+                q1 = _mm256_fmadd_pd(x1, x1, q1);
+                q2 = _mm256_fmadd_pd(x2, x2, q2);
+                q3 = _mm256_fmadd_pd(x3, x3, q3);
+            }
+        }
+        _mm256_storeu_pd(sum + j, s0);
+        _mm256_storeu_pd(sum + j + 4, s1);
+        _mm256_storeu_pd(sum + j + 8, s2);
+        _mm256_storeu_pd(sum + j + 12, s3);
+        if (flag_sq) {
+            _mm256_storeu_pd(sumsq + j, q0);
+            _mm256_storeu_pd(sumsq + j + 4, q1);
+            _mm256_storeu_pd(sumsq + j + 8, q2);
+            _mm256_storeu_pd(sumsq + j + 12, q3);
+        }
+    }
+    for (; j + 4 <= ndim; j += 4) { // single vectors
+        __m256d s0 = _mm256_loadu_pd(sum + j);
+        __m256d q0 = flag_sq ? _mm256_loadu_pd(sumsq + j) : _mm256_setzero_pd();
+        const double * xi = x + j;
+        for (int64_t i = 0; i < n; ++i, xi += ndim) {
+            const __m256d x0 = _mm256_loadu_pd(xi);
+            s0 = _mm256_add_pd(s0, x0);
+            if (flag_sq) { q0 = _mm256_fmadd_pd(x0, x0, q0); }
+        }
+        _mm256_storeu_pd(sum + j, s0);
+        if (flag_sq) { _mm256_storeu_pd(sumsq + j, q0); }
+    }
+    addColumnsScalar(n, ndim, j, x, sum, sumsq);
+}
+
+__attribute__((target("avx2,fma")))
+void blockPairsAVX2(const int64_t npairs, const int ndim, const double x[], const double mean[], double xred[],
+                    double var[], double gamma[], double prev[], double sumred[])
+{
+    const __m256d half = _mm256_set1_pd(0.5);
+    int j = 0;
+    for (; j + 4 <= ndim; j += 4) { // separate accumulators for the two elements of a pair
+        const __m256d m = _mm256_loadu_pd(mean + j);
+        __m256d va = _mm256_loadu_pd(var + j), vb = _mm256_setzero_pd();
+        __m256d ga = _mm256_loadu_pd(gamma + j), gb = _mm256_setzero_pd();
+        __m256d p = _mm256_loadu_pd(prev + j), r = _mm256_loadu_pd(sumred + j);
+        for (int64_t i = 0; i < npairs; ++i) {
+            const __m256d a = _mm256_loadu_pd(x + 2*i*ndim + j);
+            const __m256d b = _mm256_loadu_pd(x + (2*i + 1)*ndim + j);
+            const __m256d A = _mm256_sub_pd(a, m);
+            const __m256d B = _mm256_sub_pd(b, m);
+            va = _mm256_fmadd_pd(A, A, va);
+            vb = _mm256_fmadd_pd(B, B, vb);
+            ga = _mm256_fmadd_pd(p, A, ga);
+            gb = _mm256_fmadd_pd(A, B, gb);
+            p = B;
+            const __m256d red = _mm256_mul_pd(half, _mm256_add_pd(a, b));
+            _mm256_storeu_pd(xred + i*ndim + j, red); // x[2i] and x[2i+1] were read already
+            r = _mm256_add_pd(r, red);
+        }
+        _mm256_storeu_pd(var + j, _mm256_add_pd(va, vb));
+        _mm256_storeu_pd(gamma + j, _mm256_add_pd(ga, gb));
+        _mm256_storeu_pd(prev + j, p);
+        _mm256_storeu_pd(sumred + j, r);
+    }
+    blockPairsScalar(npairs, ndim, j, x, mean, xred, var, gamma, prev, sumred);
+}
+
+
+// --- AVX-512 kernels (8 doubles per vector)
+
+__attribute__((target("avx512f")))
+void addColumnsAVX512(const int64_t n, const int ndim, const double x[], double sum[], double sumsq[])
+{
+    const bool flag_sq = (sumsq != nullptr);
+    int j = 0;
+    for (; j + 32 <= ndim; j += 32) { // 4 vectors of columns at once
+        __m512d s0 = _mm512_loadu_pd(sum + j), s1 = _mm512_loadu_pd(sum + j + 8);
+        __m512d s2 = _mm512_loadu_pd(sum + j + 16), s3 = _mm512_loadu_pd(sum + j + 24);
+        __m512d q0 = _mm512_setzero_pd(), q1 = q0, q2 = q0, q3 = q0;
+        if (flag_sq) {
+            q0 = _mm512_loadu_pd(sumsq + j);
+            q1 = _mm512_loadu_pd(sumsq + j + 8);
+            q2 = _mm512_loadu_pd(sumsq + j + 16);
+            q3 = _mm512_loadu_pd(sumsq + j + 24);
+        }
+        const double * xi = x + j;
+        for (int64_t i = 0; i < n; ++i, xi += ndim) {
+            const __m512d x0 = _mm512_loadu_pd(xi), x1 = _mm512_loadu_pd(xi + 8);
+            const __m512d x2 = _mm512_loadu_pd(xi + 16), x3 = _mm512_loadu_pd(xi + 24);
+            s0 = _mm512_add_pd(s0, x0);
+            s1 = _mm512_add_pd(s1, x1);
+            s2 = _mm512_add_pd(s2, x2);
+            s3 = _mm512_add_pd(s3, x3);
+            if (flag_sq) {
+                q0 = _mm512_fmadd_pd(x0, x0, q0);
+                q1 = _mm512_fmadd_pd(x1, x1, q1);
+                q2 = _mm512_fmadd_pd(x2, x2, q2);
+                q3 = _mm512_fmadd_pd(x3, x3, q3);
+            }
+        }
+        _mm512_storeu_pd(sum + j, s0);
+        _mm512_storeu_pd(sum + j + 8, s1);
+        _mm512_storeu_pd(sum + j + 16, s2);
+        _mm512_storeu_pd(sum + j + 24, s3);
+        if (flag_sq) {
+            _mm512_storeu_pd(sumsq + j, q0);
+            _mm512_storeu_pd(sumsq + j + 8, q1);
+            _mm512_storeu_pd(sumsq + j + 16, q2);
+            _mm512_storeu_pd(sumsq + j + 24, q3);
+        }
+    }
+    for (; j + 8 <= ndim; j += 8) { // single vectors
+        __m512d s0 = _mm512_loadu_pd(sum + j);
+        __m512d q0 = flag_sq ? _mm512_loadu_pd(sumsq + j) : _mm512_setzero_pd();
+        const double * xi = x + j;
+        for (int64_t i = 0; i < n; ++i, xi += ndim) {
+            const __m512d x0 = _mm512_loadu_pd(xi);
+            s0 = _mm512_add_pd(s0, x0);
+            if (flag_sq) { q0 = _mm512_fmadd_pd(x0, x0, q0); }
+        }
+        _mm512_storeu_pd(sum + j, s0);
+        if (flag_sq) { _mm512_storeu_pd(sumsq + j, q0); }
+    }
+    addColumnsScalar(n, ndim, j, x, sum, sumsq);
+}
+
+__attribute__((target("avx512f")))
+void blockPairsAVX512(const int64_t npairs, const int ndim, const double x[], const double mean[], double xred[],
+                      double var[], double gamma[], double prev[], double sumred[])
+{
+    const __m512d half = _mm512_set1_pd(0.5);
+    int j = 0;
+    for (; j + 8 <= ndim; j += 8) { // separate accumulators for the two elements of a pair
+        const __m512d m = _mm512_loadu_pd(mean + j);
+        __m512d va = _mm512_loadu_pd(var + j), vb = _mm512_setzero_pd();
+        __m512d ga = _mm512_loadu_pd(gamma + j), gb = _mm512_setzero_pd();
+        __m512d p = _mm512_loadu_pd(prev + j), r = _mm512_loadu_pd(sumred + j);
+        for (int64_t i = 0; i < npairs; ++i) {
+            const __m512d a = _mm512_loadu_pd(x + 2*i*ndim + j);
+            const __m512d b = _mm512_loadu_pd(x + (2*i + 1)*ndim + j);
+            const __m512d A = _mm512_sub_pd(a, m);
+            const __m512d B = _mm512_sub_pd(b, m);
+            va = _mm512_fmadd_pd(A, A, va);
+            vb = _mm512_fmadd_pd(B, B, vb);
+            ga = _mm512_fmadd_pd(p, A, ga);
+            gb = _mm512_fmadd_pd(A, B, gb);
+            p = B;
+            const __m512d red = _mm512_mul_pd(half, _mm512_add_pd(a, b));
+            _mm512_storeu_pd(xred + i*ndim + j, red); // x[2i] and x[2i+1] were read already
+            r = _mm512_add_pd(r, red);
+        }
+        _mm512_storeu_pd(var + j, _mm512_add_pd(va, vb));
+        _mm512_storeu_pd(gamma + j, _mm512_add_pd(ga, gb));
+        _mm512_storeu_pd(prev + j, p);
+        _mm512_storeu_pd(sumred + j, r);
+    }
+    blockPairsScalar(npairs, ndim, j, x, mean, xred, var, gamma, prev, sumred);
+}
+#endif
+
+
+// --- Dispatch
+
+SIMDLevel detectSIMDLevel()
+{
+#if MCI_SIMD_X86 == 1
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) { return SIMDLevel::AVX512; }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) { return SIMDLevel::AVX2; }
+#endif
+    return SIMDLevel::Scalar;
+}
+
+std::atomic<int> selectedSIMDLevel{-1}; // -1 means not selected, i.e. max
+
+SIMDLevel getMaxSIMDLevel()
+{
+    static const SIMDLevel maxLevel = detectSIMDLevel();
+    return maxLevel;
+}
+
+SIMDLevel getSIMDLevel()
+{
+    const int level = selectedSIMDLevel.load();
+    return (level < 0) ? getMaxSIMDLevel() : static_cast<SIMDLevel>(level);
+}
+
+void setSIMDLevel(const SIMDLevel level)
+{
+    const int maxLevel = static_cast<int>(getMaxSIMDLevel());
+    selectedSIMDLevel = (static_cast<int>(level) < maxLevel) ? static_cast<int>(level) : maxLevel;
+}
+
+
+void sumColumns(const int64_t n, const int ndim, const double x[], double sum[], double sumsq[])
+{
+    const SIMDLevel level = getSIMDLevel();
+    if (level == SIMDLevel::Scalar) {
+        sumColumnsScalar(n, ndim, x, sum, sumsq);
+        return;
+    }
+#if MCI_SIMD_X86 == 1
+    std::fill(sum, sum + ndim, 0.);
+    if (sumsq != nullptr) { std::fill(sumsq, sumsq + ndim, 0.); }
+    for (int64_t i0 = 0; i0 < n; i0 += CHUNK_ROWS) {
+        const int64_t nchunk = std::min(CHUNK_ROWS, n - i0);
+        if (level == SIMDLevel::AVX512) { addColumnsAVX512(nchunk, ndim, x + i0*ndim, sum, sumsq); }
+        else { addColumnsAVX2(nchunk, ndim, x + i0*ndim, sum, sumsq); }
+    }
+#endif
+}
+
+void sumContiguous(const int64_t n, const double x[], double &sum, double * const sumsq)
+{   // we treat x as rows of CONTIGUOUS_WIDTH columns, so the column kernels keep several vector accumulators busy
+    const int CONTIGUOUS_WIDTH = 32;
+    const int64_t nrows = n/CONTIGUOUS_WIDTH;
+    double psum[CONTIGUOUS_WIDTH], psumsq[CONTIGUOUS_WIDTH];
+    sumColumns(nrows, CONTIGUOUS_WIDTH, x, psum, (sumsq != nullptr) ? psumsq : nullptr);
+
+    sum = 0.;
+    for (const double s : psum) { sum += s; }
+    for (int64_t i = nrows*CONTIGUOUS_WIDTH; i < n; ++i) { sum += x[i]; }
+    if (sumsq != nullptr) {
+        *sumsq = 0.;
+        for (const double q : psumsq) { *sumsq += q; }
+        for (int64_t i = nrows*CONTIGUOUS_WIDTH; i < n; ++i) { *sumsq += x[i]*x[i]; }
+    }
+}
+
+void blockPairs(const int64_t npairs, const int ndim, const double x[], const double mean[], double xred[],
+                double var[], double gamma[], double prev[], double sumred[])
+{
+    const SIMDLevel level = getSIMDLevel();
+    if (level == SIMDLevel::Scalar) {
+        blockPairsScalar(npairs, ndim, 0, x, mean, xred, var, gamma, prev, sumred);
+        return;
+    }
+#if MCI_SIMD_X86 == 1
+    for (int64_t p0 = 0; p0 < npairs; p0 += CHUNK_ROWS/2) { // xred rows of earlier chunks are behind the rows to read
+        const int64_t nchunk = std::min(CHUNK_ROWS/2, npairs - p0);
+        if (level == SIMDLevel::AVX512) { blockPairsAVX512(nchunk, ndim, x + 2*p0*ndim, mean, xred + p0*ndim, var, gamma, prev, sumred); }
+        else { blockPairsAVX2(nchunk, ndim, x + 2*p0*ndim, mean, xred + p0*ndim, var, gamma, prev, sumred); }
+    }
+#endif
+}
+}  // namespace mci
@@ -1,5 +1,7 @@
 #include "mci/SamplingFunctionContainer.hpp"
 
+#include "mci/Checkpoint.hpp"
+
 namespace mci
 {
 
@@ -54,6 +56,22 @@ void SamplingFunctionContainer::prepareObservation(const double x[])
     }
 }
 
+void SamplingFunctionContainer::saveState(std::ostream &out) const
+{
+    writeCheckpointValue(out, this->size());
+    for (auto &sf : _pdfs) {
+        sf->saveState(out);
+    }
+}
+
+void SamplingFunctionContainer::loadState(std::istream &in)
+{
+    expectCheckpointValue(in, this->size(), "[SamplingFunctionContainer::loadState] Checkpoint contains a different number of sampling functions.");
+    for (auto &sf : _pdfs) {
+        sf->loadState(in);
+    }
+}
+
 std::unique_ptr<SamplingFunctionInterface> SamplingFunctionContainer::pop_back()
 {
     auto pdf = std::move(_pdfs.back()); // move last pdf out of vector
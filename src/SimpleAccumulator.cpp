@@ -1,5 +1,7 @@
 #include "mci/SimpleAccumulator.hpp"
 
+#include "mci/Checkpoint.hpp"
+
 namespace mci
 {
 
@@ -40,4 +42,28 @@ void SimpleAccumulator::_deallocate()
     _data = nullptr;
     _flag_alloc = false;
 }
+
+
+void SimpleAccumulator::_merge(const int64_t nstore, const int64_t naccu, const double data[])
+{   // both contain finalized averages, so we compute the weighted average
+    if (nstore != 1) { throw std::invalid_argument("[SimpleAccumulator::merge] Passed data must contain exactly one average."); }
+    const double norm = 1./(this->getNAccu() + naccu);
+    const double w1 = this->getNAccu()*norm;
+    const double w2 = naccu*norm;
+    for (int i = 0; i < _nobs; ++i) {
+        _data[i] = w1*_data[i] + w2*data[i];
+    }
+}
+
+
+void SimpleAccumulator::_saveState(std::ostream &out) const
+{
+    writeCheckpointArray(out, _data, _nobs);
+}
+
+
+void SimpleAccumulator::_loadState(std::istream &in)
+{
+    readCheckpointArray(in, _data, _nobs);
+}
 }  // namespace mci
@@ -0,0 +1,228 @@
+#include "mci/StreamBlockAccumulator.hpp"
+#include "mci/Checkpoint.hpp"
+#include "mci/CompressedFullAccumulator.hpp"
+#include "mci/MJBlocker.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace mci
+{
+
+int countBlockingLevels(int64_t naccu)
+{   // number of levels needed to hold naccu samples, i.e. floor(log2(naccu)) + 1
+    int nlevels = 0;
+    for (; naccu > 0; naccu /= 2) { ++nlevels; }
+    return nlevels;
+}
+
+
+void StreamBlockAccumulator::_allocate()
+{
+    _nlevels = countBlockingLevels(this->getNAccu());
+    _data = new double[this->getNData()]; // (1 + _nlevels*NFIELDS) * _nobs layout
+    std::fill(_data, _data + this->getNData(), 0.);
+}
+
+
+void StreamBlockAccumulator::_pushLevels(const int nlevels, const int nobs, double data[], double carry[])
+{
+    const auto field = [nobs, data](int k, Field f) { return data + (1 + k*NFIELDS + f)*nobs; };
+    for (int k = 0; k < nlevels; ++k) { // add the new element to level k and pass on a completed pair
+        double * const sum = field(k, SUM);
+        double * const sumsq = field(k, SUMSQ);
+        double * const sumlag1 = field(k, SUMLAG1);
+        double * const first = field(k, FIRST);
+        double * const last = field(k, LAST);
+        double * const count = field(k, COUNT);
+
+        const bool paired = (static_cast<int64_t>(count[0])%2 == 1); // the last element is waiting for a partner
+        for (int i = 0; i < nobs; ++i) {
+            const double y = carry[i];
+            sum[i] += y;
+            sumsq[i] += y*y;
+            if (count[i] > 0.) { sumlag1[i] += last[i]*y; }
+            else { first[i] = y; }
+            if (paired) { carry[i] = 0.5*(last[i] + y); }
+            last[i] = y;
+            count[i] += 1.;
+        }
+        if (!paired) { break; }
+    }
+}
+
+
+void StreamBlockAccumulator::_pushSamples(const int nlevels, const int nobs, const int64_t n, const double x[], double data[], double carry[])
+{
+    for (int64_t i = 0; i < n; ++i) {
+        for (int j = 0; j < nobs; ++j) { carry[j] = x[i*nobs + j] - data[j]; }
+        _pushLevels(nlevels, nobs, data, carry);
+    }
+}
+
+
+void StreamBlockAccumulator::_accumulate()
+{
+    if (_row(0, COUNT)[0] == 0.) { // the first sample is used as shift, to avoid cancellation in the sums
+        std::copy(_obs_values, _obs_values + _nobs, _data);
+    }
+    for (int i = 0; i < _nobs; ++i) { _carry[i] = _obs_values[i] - _data[i]; }
+    _pushLevels(_nlevels, _nobs, _data, _carry);
+}
+
+
+void StreamBlockAccumulator::_reset()
+{
+    std::fill(_data, _data + this->getNData(), 0.);
+}
+
+
+void StreamBlockAccumulator::_deallocate()
+{
+    delete[] _data;
+    _data = nullptr;
+    _nlevels = 0;
+}
+
+
+void StreamBlockAccumulator::_merge(const int64_t nstore, const int64_t naccu, const double data[])
+{
+    if (nstore < 1 + NFIELDS || (nstore - 1)%NFIELDS != 0) {
+        throw std::invalid_argument("[StreamBlockAccumulator::merge] Passed data has an invalid number of levels.");
+    }
+    const int nlevels_other = static_cast<int>((nstore - 1)/NFIELDS);
+    const int nlevels_new = countBlockingLevels(this->getNAccu() + naccu);
+    if (nlevels_other > nlevels_new) {
+        throw std::invalid_argument("[StreamBlockAccumulator::merge] Passed data has more levels than its number of accumulations allows.");
+    }
+    if (nlevels_new > _nlevels) { // add the new (empty) levels
+        const int64_t ndata = this->getNData();
+        auto * newdata = new double[(1 + nlevels_new*NFIELDS)*_nobs];
+        std::copy(_data, _data + ndata, newdata);
+        std::fill(newdata + ndata, newdata + (1 + nlevels_new*NFIELDS)*_nobs, 0.);
+        delete[] _data;
+        _data = newdata;
+        _nlevels = nlevels_new;
+    }
+
+    // append the other's level sequences to ours, after shifting them to our reference
+    for (int k = 0; k < nlevels_other; ++k) {
+        const double * const other = data + (1 + k*NFIELDS)*_nobs;
+        for (int i = 0; i < _nobs; ++i) {
+            const double n = other[COUNT*_nobs + i];
+            if (n == 0.) { continue; }
+            const double d = data[i] - _data[i]; // difference of the shifts
+            const double sum = other[SUM*_nobs + i];
+            const double first = other[FIRST*_nobs + i] + d;
+            const double last = other[LAST*_nobs + i] + d;
+
+            if (_row(k, COUNT)[i] > 0.) { _row(k, SUMLAG1)[i] += _row(k, LAST)[i]*first; } // the pair at the seam
+            else { _row(k, FIRST)[i] = first; }
+            _row(k, SUM)[i] += sum + n*d;
+            _row(k, SUMSQ)[i] += other[SUMSQ*_nobs + i] + 2.*d*sum + n*d*d;
+            _row(k, SUMLAG1)[i] += other[SUMLAG1*_nobs + i] + d*(2.*sum - other[FIRST*_nobs + i] - other[LAST*_nobs + i]) + (n - 1.)*d*d;
+            _row(k, LAST)[i] = last;
+            _row(k, COUNT)[i] += n;
+        }
+    }
+}
+
+
+void StreamBlockAccumulator::estimate(const int64_t nstore, const int nobs, const double data[], double average[], double error[])
+{
+    const int nlevels = static_cast<int>((nstore - 1)/NFIELDS);
+    const auto field = [nobs, data](int k, Field f) { return data + (1 + k*NFIELDS + f)*nobs; };
+    if (nlevels < 1 || field(0, COUNT)[0] < 2.) {
+        throw std::invalid_argument("[StreamBlockAccumulator::estimate] At least two accumulated samples are required.");
+    }
+
+    // the levels with at least two elements take part in the blocking analysis
+    auto * const nred = new int64_t[nlevels];
+    int npow = 0;
+    for (; npow < nlevels && field(npow, COUNT)[0] >= 2.; ++npow) {
+        nred[npow] = static_cast<int64_t>(field(npow, COUNT)[0]);
+    }
+
+    // variance and lag-1 covariance around the level mean, from the running sums
+    auto * const var = new double[npow*nobs];
+    auto * const gamma = new double[npow*nobs];
+    for (int k = 0; k < npow; ++k) {
+        const double n = nred[k];
+        const double * const sum = field(k, SUM);
+        const double * const sumsq = field(k, SUMSQ);
+        const double * const sumlag1 = field(k, SUMLAG1);
+        const double * const first = field(k, FIRST);
+        const double * const last = field(k, LAST);
+        for (int j = 0; j < nobs; ++j) {
+            const double mean = sum[j]/n;
+            var[k*nobs + j] = std::max(0., (sumsq[j] - sum[j]*mean)/n);
+            gamma[k*nobs + j] = (sumlag1[j] - mean*(2.*sum[j] - first[j] - last[j]) + (n - 1.)*mean*mean)/n;
+        }
+    }
+
+    for (int j = 0; j < nobs; ++j) {
+        average[j] = data[j] + field(0, SUM)[j]/nred[0];
+        const int k = MJBlocker::selectLevel(npow, nobs, var + j, gamma + j, nred);
+        error[j] = sqrt(var[k*nobs + j]/nred[k]);
+    }
+
+    delete[] gamma;
+    delete[] var;
+    delete[] nred;
+}
+
+
+void StreamBlockAccumulator::estimateFromSamples(const int64_t n, const int nobs, const double x[], double average[], double error[])
+{
+    if (n < 2) {
+        throw std::invalid_argument("[StreamBlockAccumulator::estimateFromSamples] At least two samples are required.");
+    }
+    const int nlevels = countBlockingLevels(n);
+    const int64_t nstore = 1 + nlevels*NFIELDS;
+    auto * const data = new double[nstore*nobs];
+    auto * const carry = new double[nobs];
+    std::fill(data, data + nstore*nobs, 0.);
+    std::copy(x, x + nobs, data); // shift by the first sample, like on accumulation
+    _pushSamples(nlevels, nobs, n, x, data, carry);
+    estimate(nstore, nobs, data, average, error);
+
+    delete[] carry;
+    delete[] data;
+}
+
+
+void StreamBlockAccumulator::estimateFromCompressed(const int64_t nstore, const int nobs, const double data[], double average[], double error[])
+{
+    CompressedSampleReader reader(nstore, nobs, data);
+    const int64_t n = reader.getNSamples();
+    if (n < 2) {
+        throw std::invalid_argument("[StreamBlockAccumulator::estimateFromCompressed] At least two samples are required.");
+    }
+    const int nlevels = countBlockingLevels(n);
+    const int64_t nlvlstore = 1 + nlevels*NFIELDS;
+    const int64_t nchunk = std::max<int64_t>(1, CompressedSampleReader::CHUNK_SIZE/nobs); // rows per chunk
+    std::vector<double> lvldata(static_cast<size_t>(nlvlstore*nobs), 0.);
+    std::vector<double> carry(static_cast<size_t>(nobs));
+    std::vector<double> chunk(static_cast<size_t>(std::min(nchunk, n)*nobs));
+    int64_t nrows = reader.read(nchunk, chunk.data());
+    std::copy(chunk.begin(), chunk.begin() + nobs, lvldata.begin()); // shift by the first sample, like on accumulation
+    while (nrows > 0) {
+        _pushSamples(nlevels, nobs, nrows, chunk.data(), lvldata.data(), carry.data());
+        nrows = reader.read(nchunk, chunk.data());
+    }
+    estimate(nlvlstore, nobs, lvldata.data(), average, error);
+}
+
+
+void StreamBlockAccumulator::_saveState(std::ostream &out) const
+{
+    writeCheckpointArray(out, _data, this->getNData());
+}
+
+
+void StreamBlockAccumulator::_loadState(std::istream &in)
+{
+    readCheckpointArray(in, _data, this->getNData());
+}
+}  // namespace mci
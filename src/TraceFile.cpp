@@ -0,0 +1,238 @@
+#include "mci/TraceFile.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mci
+{
+constexpr int32_t TraceHeader::VERSION; // definitions (C++14)
+constexpr int64_t TraceWriter::CHUNK_BYTES;
+constexpr size_t TraceWriter::MAX_QUEUED_CHUNKS;
+
+constexpr char TRACE_MAGIC[8] = {'M', 'C', 'I', 'T', 'R', 'A', 'C', 'E'};
+
+
+// --- TraceWriter
+
+TraceWriter::TraceWriter(std::string filepath, const TraceKind kind, const int ndim, const int nvalues, const int freq, const bool flag_blockavg):
+        _filepath(std::move(filepath)), _header{}, _recsize(static_cast<int64_t>(sizeof(int64_t) + nvalues*sizeof(double))),
+        _chunkrecords(std::max<int64_t>(1, CHUNK_BYTES/_recsize)), _nblock(0), _blockstart(0), _nchunk(0), _nrecords(0),
+        _flag_stop(false), _flag_failed(false)
+{
+    if (ndim < 1 || nvalues < 1) { throw std::invalid_argument("[TraceWriter] Requested number of dimensions/values was < 1 ."); }
+    if (freq < 1) { throw std::invalid_argument("[TraceWriter] Requested frequency was < 1 ."); }
+
+    std::copy(TRACE_MAGIC, TRACE_MAGIC + 8, _header.magic);
+    _header.version = TraceHeader::VERSION;
+    _header.kind = static_cast<int32_t>(kind);
+    _header.ndim = ndim;
+    _header.nvalues = nvalues;
+    _header.freq = freq;
+    _header.flag_blockavg = flag_blockavg ? 1 : 0;
+    if (flag_blockavg) { _blocksum.assign(static_cast<size_t>(nvalues), 0.); }
+
+    _file.open(_filepath, std::ios::binary | std::ios::trunc);
+    if (!_file.is_open()) { throw std::runtime_error("[TraceWriter] Failed to open file " + _filepath + "."); }
+    _file.write(reinterpret_cast<const char *>(&_header), sizeof(TraceHeader));
+    _chunk.resize(static_cast<size_t>(_chunkrecords*_recsize));
+
+    _thread = std::thread(&TraceWriter::_run, this);
+}
+
+
+TraceWriter::~TraceWriter()
+{
+    try { this->close(); }
+    catch (...) {} // destructors don't throw, call close() to get notified
+}
+
+
+void TraceWriter::_run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _cv.wait(lock, [this] { return !_queue.empty() || _flag_stop; });
+        if (_queue.empty()) { return; } // stopped and everything written
+        std::vector<unsigned char> chunk = std::move(_queue.front());
+        _queue.pop_front();
+        lock.unlock();
+        _file.write(reinterpret_cast<const char *>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+        const bool failed = !_file.good();
+        lock.lock();
+        if (failed) { _flag_failed = true; }
+        _spare.push_back(std::move(chunk));
+        _cv.notify_all(); // producer may wait for space
+    }
+}
+
+
+void TraceWriter::_handOff()
+{
+    if (_nchunk == 0) { return; }
+    _chunk.resize(static_cast<size_t>(_nchunk*_recsize)); // only the last chunk may be shorter
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait(lock, [this] { return _queue.size() < MAX_QUEUED_CHUNKS; });
+    _queue.push_back(std::move(_chunk));
+    if (!_spare.empty()) { // reuse a written chunk
+        _chunk = std::move(_spare.back());
+        _spare.pop_back();
+    }
+    else { _chunk = std::vector<unsigned char>(); }
+    lock.unlock();
+    _cv.notify_all();
+    _chunk.resize(static_cast<size_t>(_chunkrecords*_recsize));
+    _nchunk = 0;
+}
+
+
+void TraceWriter::_addRecord(const int64_t step, const double values[])
+{
+    unsigned char * const rec = _chunk.data() + _nchunk*_recsize;
+    std::memcpy(rec, &step, sizeof(int64_t));
+    std::memcpy(rec + sizeof(int64_t), values, _header.nvalues*sizeof(double));
+    ++_nrecords;
+    if (++_nchunk == _chunkrecords) { this->_handOff(); }
+}
+
+
+void TraceWriter::push(const int64_t step, const double values[])
+{
+    if (_header.flag_blockavg == 0) {
+        if (step%_header.freq == 0) { this->_addRecord(step, values); }
+        return;
+    }
+
+    if (_nblock == 0) { _blockstart = step; }
+    for (int j = 0; j < _header.nvalues; ++j) { _blocksum[j] += values[j]; }
+    if (++_nblock == _header.freq) { // block finished
+        const double normf = 1./_header.freq;
+        for (auto &v : _blocksum) { v *= normf; }
+        this->_addRecord(_blockstart, _blocksum.data());
+        std::fill(_blocksum.begin(), _blocksum.end(), 0.);
+        _nblock = 0;
+    }
+}
+
+
+void TraceWriter::close()
+{
+    if (!_thread.joinable()) { return; } // closed already
+    this->_handOff();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _flag_stop = true;
+    }
+    _cv.notify_all();
+    _thread.join();
+    _file.close();
+    if (_flag_failed || _file.fail()) { throw std::runtime_error("[TraceWriter::close] Failed to write file " + _filepath + "."); }
+}
+
+
+// --- TraceReader
+
+TraceReader::TraceReader(std::string filepath):
+        _filepath(std::move(filepath)), _recsize(0), _nrecords(-1), _nread(0), _flag_eof(false), _fd(-1), _map(nullptr), _maplen(0)
+{
+    _fd = open(_filepath.c_str(), O_RDONLY);
+    if (_fd < 0) { throw std::runtime_error("[TraceReader] Failed to open file " + _filepath + ": " + std::strerror(errno)); }
+    struct stat st{};
+    if (fstat(_fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) { // map regular files
+        void * const ptr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, _fd, 0);
+        if (ptr != MAP_FAILED) {
+            madvise(ptr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL); // only a hint
+            _map = static_cast<const unsigned char *>(ptr);
+            _maplen = static_cast<size_t>(st.st_size);
+        }
+    }
+
+    bool valid;
+    if (_map != nullptr) {
+        valid = (_maplen >= sizeof(TraceHeader));
+        if (valid) { std::memcpy(&_header, _map, sizeof(TraceHeader)); }
+    }
+    else { valid = (this->_readBytes(reinterpret_cast<unsigned char *>(&_header), sizeof(TraceHeader)) == sizeof(TraceHeader)); }
+    if (!valid || !std::equal(TRACE_MAGIC, TRACE_MAGIC + 8, _header.magic)) {
+        this->_release(); // the destructor won't be called
+        throw std::invalid_argument("[TraceReader] File " + _filepath + " is not a binary trace file.");
+    }
+    if (_header.version != TraceHeader::VERSION || _header.ndim < 1 || _header.nvalues < 1 || _header.freq < 1) {
+        this->_release();
+        throw std::invalid_argument("[TraceReader] File " + _filepath + " has an invalid or unsupported header.");
+    }
+    _recsize = static_cast<int64_t>(sizeof(int64_t) + _header.nvalues*sizeof(double));
+    if (_map != nullptr) { _nrecords = (static_cast<int64_t>(_maplen) - static_cast<int64_t>(sizeof(TraceHeader)))/_recsize; }
+}
+
+
+void TraceReader::_release()
+{
+    if (_map != nullptr) {
+        munmap(const_cast<unsigned char *>(_map), _maplen);
+        _map = nullptr;
+    }
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+}
+
+
+int64_t TraceReader::_readBytes(unsigned char out[], const int64_t nbytes)
+{
+    int64_t n = 0;
+    while (n < nbytes) {
+        const ssize_t ret = ::read(_fd, out + n, static_cast<size_t>(nbytes - n));
+        if (ret < 0) {
+            if (errno == EINTR) { continue; }
+            throw std::runtime_error("[TraceReader::read] Failed to read file " + _filepath + ": " + std::strerror(errno));
+        }
+        if (ret == 0) { // end of file
+            _flag_eof = true;
+            break;
+        }
+        n += ret;
+    }
+    return n;
+}
+
+
+void TraceReader::rewind()
+{
+    if (this->isStreamed()) { throw std::logic_error("[TraceReader::rewind] Streamed files can't be rewound."); }
+    _nread = 0;
+}
+
+
+int64_t TraceReader::read(const int64_t nrecords, int64_t steps[], double values[])
+{
+    const unsigned char * data;
+    int64_t n;
+    if (_map != nullptr) {
+        n = std::max<int64_t>(0, std::min(nrecords, _nrecords - _nread));
+        data = _map + sizeof(TraceHeader) + _nread*_recsize;
+    }
+    else {
+        if (_flag_eof || nrecords <= 0) { return 0; }
+        _buffer.resize(static_cast<size_t>(nrecords*_recsize));
+        n = this->_readBytes(_buffer.data(), nrecords*_recsize)/_recsize; // a truncated record at the end is dropped
+        data = _buffer.data();
+    }
+
+    for (int64_t i = 0; i < n; ++i) {
+        const unsigned char * const rec = data + i*_recsize;
+        if (steps != nullptr) { std::memcpy(steps + i, rec, sizeof(int64_t)); }
+        std::memcpy(values + i*_header.nvalues, rec + sizeof(int64_t), _header.nvalues*sizeof(double));
+    }
+    _nread += n;
+    return n;
+}
+}  // namespace mci
@@ -0,0 +1,125 @@
+#include "mci/XoshiroEngine.hpp"
+
+#include "mci/Checkpoint.hpp"
+
+#include <array>
+#include <vector>
+
+namespace mci
+{
+
+namespace
+{
+// The xoshiro transitions (steps and jumps) are linear in the state bits, i.e. 256x256 bit matrices, which
+// we store column-wise (images of the 256 unit states). Then n transitions are the matrix power, by repeated squaring.
+using State = std::array<uint64_t, 4>;
+
+void applyMatrix(const std::vector<State> &mat, const uint64_t in[], uint64_t out[]) // out = mat*in
+{
+    std::fill(out, out + 4, 0);
+    for (int k = 0; k < 256; ++k) {
+        if ((in[k/64] & (uint64_t(1) << (k%64))) != 0) {
+            for (int j = 0; j < 4; ++j) { out[j] ^= mat[k][j]; }
+        }
+    }
+}
+
+void applyMatrixPower(std::vector<State> &mat, uint64_t s[] /*len 4*/, uint64_t n) // s = mat^n*s, overwrites mat
+{
+    std::vector<State> tmp(mat.size());
+    while (true) {
+        if ((n & 1) != 0) {
+            uint64_t out[4];
+            applyMatrix(mat, s, out);
+            std::copy(out, out + 4, s);
+        }
+        n >>= 1;
+        if (n == 0) { break; }
+        for (int k = 0; k < 256; ++k) { applyMatrix(mat, mat[k].data(), tmp[k].data()); } // square
+        mat.swap(tmp);
+    }
+}
+}  // namespace
+
+void XoshiroEngine::seed(uint64_t seed)
+{
+    for (uint64_t &s : _s) { // splitmix64
+        uint64_t z = (seed += 0x9e3779b97f4a7c15);
+        z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27))*0x94d049bb133111eb;
+        s = z ^ (z >> 31);
+    }
+}
+
+void XoshiroEngine::_jump(const uint64_t jumpPoly[])
+{
+    uint64_t s[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; ++i) {
+        for (int b = 0; b < 64; ++b) {
+            if ((jumpPoly[i] & (uint64_t(1) << b)) != 0) {
+                for (int j = 0; j < 4; ++j) { s[j] ^= _s[j]; }
+            }
+            this->_next();
+        }
+    }
+    std::copy(s, s + 4, _s);
+}
+
+void XoshiroEngine::_jump(const uint64_t jumpPoly[], uint64_t n)
+{
+    if (n < 2) {
+        if (n == 1) { this->_jump(jumpPoly); }
+        return;
+    }
+
+    std::vector<State> mat(256);
+    XoshiroEngine unit;
+    for (int k = 0; k < 256; ++k) {
+        std::fill(unit._s, unit._s + 4, 0);
+        unit._s[k/64] = uint64_t(1) << (k%64);
+        unit._jump(jumpPoly);
+        std::copy(unit._s, unit._s + 4, mat[k].begin());
+    }
+    applyMatrixPower(mat, _s, n);
+}
+
+void XoshiroEngine::discard(uint64_t n)
+{
+    if (n <= DISCARD_LOOP_MAX) {
+        for (uint64_t i = 0; i < n; ++i) { this->_next(); }
+        return;
+    }
+
+    std::vector<State> mat(256); // one step as bit matrix
+    XoshiroEngine unit;
+    for (int k = 0; k < 256; ++k) {
+        std::fill(unit._s, unit._s + 4, 0);
+        unit._s[k/64] = uint64_t(1) << (k%64);
+        unit._next();
+        std::copy(unit._s, unit._s + 4, mat[k].begin());
+    }
+    applyMatrixPower(mat, _s, n);
+}
+
+void XoshiroEngine::jump(const uint64_t n)
+{
+    static const uint64_t JUMP[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+    this->_jump(JUMP, n);
+}
+
+void XoshiroEngine::longJump(const uint64_t n)
+{
+    static const uint64_t LONG_JUMP[] = {0x76e15d3efefdcbbf, 0xc5004e441c522fb3, 0x77710069854ee241, 0x39109bb02acbe635};
+    this->_jump(LONG_JUMP, n);
+}
+
+void XoshiroEngine::saveState(std::ostream &out) const
+{
+    writeCheckpointArray(out, _s, 4);
+}
+
+void XoshiroEngine::loadState(std::istream &in)
+{
+    readCheckpointArray(in, _s, 4);
+}
+}  // namespace mci
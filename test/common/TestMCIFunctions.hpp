@@ -185,6 +185,7 @@ public:
             pvnew[wlk.changedIdx[i]] = wlk.xnew[wlk.changedIdx[i]]*wlk.xnew[wlk.changedIdx[i]];
             expf += pvnew[wlk.changedIdx[i]] - pvold[wlk.changedIdx[i]];
         }
+        this->markDirty(wlk.changedIdx[0], wlk.changedIdx[wlk.nchanged - 1] + 1); // changedIdx is in ascending order
         return exp(-expf);
     }
 };
@@ -251,6 +252,7 @@ public:
             pvnew[wlk.changedIdx[i]] = fabs(wlk.xnew[wlk.changedIdx[i]]);
             expf += pvnew[wlk.changedIdx[i]] - pvold[wlk.changedIdx[i]];
         }
+        this->markDirty(wlk.changedIdx[0], wlk.changedIdx[wlk.nchanged - 1] + 1); // changedIdx is in ascending order
         return exp(-expf);
     }
 };
@@ -451,12 +453,10 @@ public:
         }
     }
 
-    void updatedObservable(const double in[], const int/*nchanged*/, const bool flags[], double out[]) final
+    void updatedObservable(const double in[], const int nchanged, const int changedIdx[], const bool/*flags*/[], double out[]) final
     {
-        for (int i = 0; i < _ndim; ++i) {
-            if (flags[i]) { // this may actually be faster for small nchanged and large _ndim
-                out[i] = in[i]*in[i];
-            }
+        for (int i = 0; i < nchanged; ++i) { // only the changed indices are updated
+            out[changedIdx[i]] = in[changedIdx[i]]*in[changedIdx[i]];
         }
     }
 };
@@ -1,12 +1,25 @@
 #include "mci/Estimators.hpp"
+#include "mci/SIMDKernels.hpp"
+#include "mci/BinningAccumulator.hpp"
 #include "mci/BlockAccumulator.hpp"
+#include "mci/CompressedFullAccumulator.hpp"
+#include "mci/CovarianceAccumulator.hpp"
+#include "mci/Factories.hpp"
 #include "mci/FullAccumulator.hpp"
+#include "mci/MappedFullAccumulator.hpp"
 #include "mci/SimpleAccumulator.hpp"
+#include "mci/StreamBlockAccumulator.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <random>
+#include <vector>
 
 #include "../common/TestMCIFunctions.hpp"
 
@@ -203,6 +216,59 @@ void checkAccumulator(AccumulatorInterface &accu, int Nmc, int ndim, const doubl
     }
 }
 
+void checkAccumulatorMerge(AccumulatorInterface &accu1, AccumulatorInterface &accu2, const AccumulatorInterface &refAccu,
+                           int Nmc, int ndim, const double datax[], const bool datacc[], const int nchanged[], const int changedIdx[])
+{   // accumulate the two halves of the data separately, merge them and compare to refAccu (which accumulated all data)
+    const int Nmc1 = Nmc/2;
+    accu1.allocate(Nmc1);
+    accumulateData(accu1, Nmc1, ndim, datax, datacc, nchanged, changedIdx);
+    accu2.allocate(Nmc - Nmc1);
+    accumulateData(accu2, Nmc - Nmc1, ndim, datax + Nmc1*ndim, datacc + Nmc1, nchanged + Nmc1, changedIdx + Nmc1*ndim);
+
+    accu1.merge(accu2);
+    assertAccuFinalized(accu1, Nmc);
+    assert(accu1.getNSteps() == refAccu.getNSteps());
+    assert(accu1.getNAccu() == refAccu.getNAccu());
+    assert(accu1.getNStore() == refAccu.getNStore());
+    assertArraysEqual(accu1.getNData(), accu1.getData(), refAccu.getData(), 0.00000001);
+
+    // merging again from raw data doubles the data
+    accu1.merge(accu2.getNSteps(), accu2.getNAccu(), accu2.getNStore(), accu2.getData());
+    assert(accu1.getNSteps() == Nmc + accu2.getNSteps());
+
+    accu1.deallocate();
+    accu2.deallocate();
+}
+
+void checkAccumulatorChunkMerge(AccumulatorInterface &accu1, AccumulatorInterface &accu2, const AccumulatorInterface &refAccu,
+                                int Nmc, int ndim, const double datax[], const bool datacc[], const int nchanged[], const int changedIdx[])
+{   // like above, but the raw data of the second half is merged in chunks of 100 elements (like MPI ranks are merged)
+    const int Nmc1 = Nmc/2;
+    accu1.allocate(Nmc1);
+    accumulateData(accu1, Nmc1, ndim, datax, datacc, nchanged, changedIdx);
+    accu2.allocate(Nmc - Nmc1);
+    accumulateData(accu2, Nmc - Nmc1, ndim, datax + Nmc1*ndim, datacc + Nmc1, nchanged + Nmc1, changedIdx + Nmc1*ndim);
+
+    assert(accu1.isChunkMergeable());
+    accu1.reserveMerge(accu2.getNStore());
+    const int64_t naccuPerStore = accu2.getNAccu()/accu2.getNStore();
+    int64_t nstepsleft = accu2.getNSteps();
+    for (int64_t j = 0; j < accu2.getNStore(); j += 100) {
+        const int64_t nstore = std::min<int64_t>(100, accu2.getNStore() - j);
+        const int64_t nsteps = (j + nstore < accu2.getNStore()) ? nstore*naccuPerStore*accu2.getNSkip() : nstepsleft;
+        accu1.merge(nsteps, nstore*naccuPerStore, nstore, accu2.getData() + j*accu2.getNObs());
+        nstepsleft -= nsteps;
+    }
+    assertAccuFinalized(accu1, Nmc);
+    assert(accu1.getNSteps() == refAccu.getNSteps());
+    assert(accu1.getNAccu() == refAccu.getNAccu());
+    assert(accu1.getNStore() == refAccu.getNStore());
+    assertArraysEqual(accu1.getNData(), accu1.getData(), refAccu.getData(), 0.00000001);
+
+    accu1.deallocate();
+    accu2.deallocate();
+}
+
 int main()
 {
     using namespace std;
@@ -214,7 +280,7 @@ int main()
     const double TINY = 0.0005;
     const double EXTRA_TINY = 0.00000001; // 1e-8
 
-    const int Nmc = 32768; // use a power of 2, so we can test MJBlocker
+    const int Nmc = 32768; // use a power of 2, so that the halves in the merge checks align with the blocks
     const int nd = 2;
     const int ndata = Nmc*nd;
 
@@ -313,6 +379,90 @@ int main()
         assert(fabs(avgND[i] - refAvg[i]) < 3*errND[i]); // like in the 1D case
     }
 
+    // the in-place version yields identical results, but overwrites the data
+    {
+        vector<double> xcopy(xND, xND + ndata);
+        double avgInPlace[nd], errInPlace[nd];
+        mci::MJBlockerEstimatorInPlace(Nmc, nd, xcopy.data(), avgInPlace, errInPlace);
+        assertArraysEqual(nd, avgInPlace, avgND);
+        assertArraysEqual(nd, errInPlace, errND);
+    }
+
+    // a reused workspace yields the same results as the allocating versions
+    {
+        mci::EstimatorWorkspace ws;
+        double avgRef[nd], errRef[nd], avgWS[nd], errWS[nd];
+        for (int irep = 0; irep < 2; ++irep) { // second time with the workspace already in use
+            mci::MultiDimFCBlockerEstimator(Nmc, nd, xND, avgRef, errRef);
+            mci::MultiDimFCBlockerEstimator(Nmc, nd, xND, avgWS, errWS, ws);
+            assertArraysEqual(nd, avgWS, avgRef);
+            assertArraysEqual(nd, errWS, errRef);
+            mci::MJBlockerEstimator(Nmc, nd, xND, avgWS, errWS, ws);
+            assertArraysEqual(nd, avgWS, avgND);
+            assertArraysEqual(nd, errWS, errND);
+            mci::MultiDimBlockEstimator(Nmc, nd, xND, nblocks, avgRef, errRef);
+            mci::MultiDimBlockEstimator(Nmc, nd, xND, nblocks, avgWS, errWS, ws);
+            assertArraysEqual(nd, avgWS, avgRef);
+            assertArraysEqual(nd, errWS, errRef);
+        }
+    }
+
+
+    // the vectorized kernels agree with the scalar ones (ndim with full, single and remaining vectors)
+    {
+        const int ndsimd = 45;
+        const int64_t nsimd = 1001;
+        mt19937_64 rgen(42);
+        uniform_real_distribution<double> udist;
+        vector<double> xsimd(nsimd*ndsimd);
+        for (auto &v : xsimd) { v = udist(rgen); }
+        double avgScalar[3][ndsimd], errScalar[3][ndsimd], avgSIMD[ndsimd], errSIMD[ndsimd];
+        const SIMDLevel maxLevel = getSIMDLevel();
+        setSIMDLevel(SIMDLevel::Scalar);
+        mci::MultiDimUncorrelatedEstimator(nsimd, ndsimd, xsimd.data(), avgScalar[0], errScalar[0]);
+        mci::MultiDimBlockEstimator(nsimd, ndsimd, xsimd.data(), 10, avgScalar[1], errScalar[1]);
+        mci::MJBlockerEstimator(nsimd, ndsimd, xsimd.data(), avgScalar[2], errScalar[2]);
+        for (const auto level : {SIMDLevel::AVX2, SIMDLevel::AVX512}) {
+            setSIMDLevel(level); // capped to what the CPU supports
+            mci::MultiDimUncorrelatedEstimator(nsimd, ndsimd, xsimd.data(), avgSIMD, errSIMD);
+            assertArraysEqual(ndsimd, avgSIMD, avgScalar[0], EXTRA_TINY);
+            assertArraysEqual(ndsimd, errSIMD, errScalar[0], EXTRA_TINY);
+            mci::MultiDimBlockEstimator(nsimd, ndsimd, xsimd.data(), 10, avgSIMD, errSIMD);
+            assertArraysEqual(ndsimd, avgSIMD, avgScalar[1], EXTRA_TINY);
+            assertArraysEqual(ndsimd, errSIMD, errScalar[1], EXTRA_TINY);
+            mci::MJBlockerEstimator(nsimd, ndsimd, xsimd.data(), avgSIMD, errSIMD);
+            assertArraysEqual(ndsimd, avgSIMD, avgScalar[2], EXTRA_TINY);
+            assertArraysEqual(ndsimd, errSIMD, errScalar[2], EXTRA_TINY);
+        }
+        setSIMDLevel(maxLevel);
+        assert(getSIMDLevel() == getMaxSIMDLevel());
+    }
+
+    // the autocorrelation analysis yields a similar error as the blockers
+    double tauND[nd], essND[nd], avgAC[nd], errAC[nd];
+    mci::AutocorrelationAnalysis(Nmc, nd, xND, avgAC, errAC, tauND, essND);
+    if (verbose) { reportAvgErrND("AutocorrelationAnalysis()", nd, avgAC, errAC); }
+    for (int i = 0; i < nd; ++i) {
+        assert(fabs(avgAC[i] - refAvg[i]) < EXTRA_TINY);
+        assert(errAC[i] > 0.5*errND[i] && errAC[i] < 2.*errND[i]); // compared to MJBlocker
+        assert(fabs(essND[i]*tauND[i] - Nmc) < EXTRA_TINY*Nmc);
+    }
+
+    // and the known tau = (1+phi)/(1-phi) of an AR(1) process
+    {
+        const double phi = 0.8;
+        mt19937_64 rgen(1337);
+        normal_distribution<double> ndist;
+        vector<double> ar1(4*Nmc);
+        double val = 0.;
+        for (auto &v : ar1) { v = val = phi*val + ndist(rgen); }
+        double avgAR, errAR, tauAR, essAR;
+        mci::AutocorrelationAnalysis(4*Nmc, 1, ar1.data(), &avgAR, &errAR, &tauAR, &essAR);
+        if (verbose) { cout << "AR(1) tau = " << tauAR << " (expected " << (1. + phi)/(1. - phi) << ")" << endl << endl; }
+        assert(fabs(tauAR - (1. + phi)/(1. - phi)) < 0.2*(1. + phi)/(1. - phi));
+        assert(fabs(avgAR) < 3*errAR);
+    }
+
 
     // --- check accumulators ---
     if (verbose) { cout << endl << "Now using accumulator classes to store data:" << endl << endl; }
@@ -323,6 +473,8 @@ int main()
     BlockAccumulator blockAccuSkip2(obsfun, 2, 8);
     FullAccumulator fullAccu(obsfun, 1);
     FullAccumulator fullAccuSkip2(obsfun, 2);
+    BinningAccumulator binningAccu(obsfun, 1, 64);
+    BinningAccumulator binningAccuSkip2(obsfun, 2, 64);
 
     vector<pair<AccumulatorInterface *, string> > accuList;
     accuList.emplace_back(&simpleAccu, "simpleAccu");
@@ -331,6 +483,8 @@ int main()
     accuList.emplace_back(&simpleAccuSkip2, "simpleAccuSkip2");
     accuList.emplace_back(&blockAccuSkip2, "blockAccuSkip2");
     accuList.emplace_back(&fullAccuSkip2, "fullAccuSkip2");
+    accuList.emplace_back(&binningAccu, "binningAccu");
+    accuList.emplace_back(&binningAccuSkip2, "binningAccuSkip2");
 
     for (auto &accuTup : accuList) {
         if (verbose) { cout << endl << "Checking accumulator " << accuTup.second << " ..." << endl; }
@@ -343,4 +497,286 @@ int main()
 
     assertAccuAveragesEqual(simpleAccuSkip2, blockAccuSkip2, EXTRA_TINY);
     assertAccuAveragesEqual(simpleAccuSkip2, fullAccuSkip2, EXTRA_TINY);
+
+    // the bins are filled and merged at the powers of 2, so with Nmc = 2^15 no partial bin is dropped
+    assertAccuAveragesEqual(simpleAccu, binningAccu, EXTRA_TINY);
+    assertAccuAveragesEqual(simpleAccuSkip2, binningAccuSkip2, EXTRA_TINY);
+    assert(binningAccu.getNStore() == 32 && binningAccu.getBlockSize() == Nmc/32);
+    assert(binningAccuSkip2.getNStore() == 32 && binningAccuSkip2.getBlockSize() == Nmc/64);
+
+    // with a remainder, the partial bin is dropped
+    BinningAccumulator binningAccuOdd(obsfun, 1, 64);
+    binningAccuOdd.allocate(Nmc - 100);
+    accumulateData(binningAccuOdd, Nmc - 100, nd, xND, accepted, nchanged, changedIdx);
+    assert(binningAccuOdd.getNStore() == 63 && binningAccuOdd.getBlockSize() == 512);
+    mci::UncorrelatedEstimator(binningAccuOdd.getNStore(), nd, binningAccuOdd.getData(), avgND, errND);
+    for (int i = 0; i < nd; ++i) { assert(fabs(avgND[i] - refAvg[i]) < 3*errND[i]); }
+
+    // check that merging two halves yields the same data
+    if (verbose) { cout << endl << "Checking merge of accumulators ..." << endl; }
+    SimpleAccumulator simpleAccu1(obsfun, 1), simpleAccu2(obsfun, 1);
+    BlockAccumulator blockAccu1(obsfun, 1, 16), blockAccu2(obsfun, 1, 16);
+    FullAccumulator fullAccu1(obsfun, 1), fullAccu2(obsfun, 1);
+    BinningAccumulator binningAccu1(obsfun, 1, 64), binningAccu2(obsfun, 1, 64);
+    checkAccumulatorMerge(simpleAccu1, simpleAccu2, simpleAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    checkAccumulatorMerge(blockAccu1, blockAccu2, blockAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    checkAccumulatorMerge(fullAccu1, fullAccu2, fullAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    checkAccumulatorMerge(binningAccu1, binningAccu2, binningAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    checkAccumulatorChunkMerge(blockAccu1, blockAccu2, blockAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    checkAccumulatorChunkMerge(fullAccu1, fullAccu2, fullAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    assert(!binningAccu1.isChunkMergeable());
+
+    // merging a run without a full bin only adds the steps
+    binningAccu1.allocate(Nmc);
+    accumulateData(binningAccu1, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    binningAccu1.merge(5, 5, 0, nullptr);
+    assert(binningAccu1.getNSteps() == Nmc + 5 && binningAccu1.getNAccu() == Nmc + 5);
+    assert(binningAccu1.getNStore() == binningAccu.getNStore());
+    assertArraysEqual(binningAccu1.getNData(), binningAccu1.getData(), binningAccu.getData(), EXTRA_TINY);
+    binningAccu1.deallocate();
+
+    // check that the streaming blocker reproduces MJBlocker without storing the samples
+    if (verbose) { cout << endl << "Checking streaming blocking accumulator ..." << endl; }
+    double refAvgSkip2[nd], refErrSkip2[nd];
+    fullAccuSkip2.allocate(Nmc);
+    accumulateData(fullAccuSkip2, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    mci::MJBlockerEstimator(fullAccuSkip2.getNStore(), nd, fullAccuSkip2.getData(), refAvgSkip2, refErrSkip2);
+    mci::MJBlockerEstimator(Nmc, nd, xND, avgND, errND);
+
+    StreamBlockAccumulator streamAccu(obsfun, 1), streamAccu2(obsfun, 1), streamAccuSkip2(obsfun, 2);
+    double streamAvg[nd], streamErr[nd];
+    streamAccu.allocate(Nmc);
+    assert(streamAccu.getNLevels() == 16); // log2(Nmc) + 1
+    accumulateData(streamAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    assertAccuFinalized(streamAccu, Nmc);
+    mci::StreamMJBlockerEstimator(streamAccu.getNStore(), nd, streamAccu.getData(), streamAvg, streamErr);
+    if (verbose) { reportAvgErrND("StreamMJBlockerEstimator()", nd, streamAvg, streamErr); }
+    assertArraysEqual(nd, streamAvg, avgND, EXTRA_TINY);
+    assertArraysEqual(nd, streamErr, errND, EXTRA_TINY);
+
+    streamAccuSkip2.allocate(Nmc);
+    accumulateData(streamAccuSkip2, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    mci::StreamMJBlockerEstimator(streamAccuSkip2.getNStore(), nd, streamAccuSkip2.getData(), streamAvg, streamErr);
+    assertArraysEqual(nd, streamAvg, refAvgSkip2, EXTRA_TINY);
+    assertArraysEqual(nd, streamErr, refErrSkip2, EXTRA_TINY);
+
+    // MJBlocker and the streaming version also agree for any other number of samples
+    const int NmcOdd = Nmc - 123;
+    mci::MJBlockerEstimator(NmcOdd, nd, xND, avgND, errND);
+    for (int i = 0; i < nd; ++i) { assert(fabs(avgND[i] - refAvg[i]) < 3*errND[i]); }
+    streamAccu.allocate(NmcOdd);
+    accumulateData(streamAccu, NmcOdd, nd, xND, accepted, nchanged, changedIdx);
+    mci::StreamMJBlockerEstimator(streamAccu.getNStore(), nd, streamAccu.getData(), streamAvg, streamErr);
+    assertArraysEqual(nd, streamAvg, avgND, EXTRA_TINY);
+    assertArraysEqual(nd, streamErr, errND, EXTRA_TINY);
+    mci::MJBlockerEstimator(Nmc, nd, xND, avgND, errND); // reset for below
+
+    // merging two halves yields the same blocking levels (the halves are powers of 2)
+    streamAccu.allocate(Nmc/2);
+    accumulateData(streamAccu, Nmc/2, nd, xND, accepted, nchanged, changedIdx);
+    streamAccu2.allocate(Nmc/2);
+    accumulateData(streamAccu2, Nmc/2, nd, xND + ndata/2, accepted + Nmc/2, nchanged + Nmc/2, changedIdx + ndata/2);
+    streamAccu.merge(streamAccu2);
+    assert(streamAccu.getNLevels() == 16);
+    mci::StreamMJBlockerEstimator(streamAccu.getNStore(), nd, streamAccu.getData(), streamAvg, streamErr);
+    assertArraysEqual(nd, streamAvg, avgND, EXTRA_TINY);
+    assertArraysEqual(nd, streamErr, errND, EXTRA_TINY);
+
+    // check that the covariance accumulator reproduces the moments of the block averages without storing them
+    if (verbose) { cout << endl << "Checking covariance accumulator ..." << endl; }
+    CovarianceAccumulator covAccu(obsfun, 1, 16), covAccu2(obsfun, 1, 16);
+    covAccu.allocate(Nmc);
+    accumulateData(covAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    assertAccuFinalized(covAccu, Nmc);
+    assert(covAccu.getNStore() == CovarianceAccumulator::COMOMENT + nd);
+
+    blockAccu.allocate(Nmc);
+    accumulateData(blockAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    const int64_t nb = blockAccu.getNStore();
+    const double * const blocks = blockAccu.getData();
+    double refCov[nd*nd], covND[nd*nd], covAvg[nd], covErr[nd];
+    mci::UncorrelatedEstimator(nb, nd, blocks, avgND, errND);
+    for (int i = 0; i < nd; ++i) {
+        for (int j = 0; j < nd; ++j) {
+            refCov[i*nd + j] = 0.;
+            for (int64_t k = 0; k < nb; ++k) { refCov[i*nd + j] += (blocks[k*nd + i] - avgND[i])*(blocks[k*nd + j] - avgND[j]); }
+            refCov[i*nd + j] /= nb*(nb - 1.);
+        }
+    }
+    CovarianceEstimator(covAccu.getNStore(), nd, covAccu.getData(), covAvg, covErr);
+    CovarianceAccumulator::covariance(covAccu.getNStore(), nd, covAccu.getData(), covND);
+    assertArraysEqual(nd, covAvg, avgND, EXTRA_TINY);
+    assertArraysEqual(nd, covErr, errND, EXTRA_TINY);
+    assertArraysEqual(nd*nd, covND, refCov, EXTRA_TINY);
+    assert(covND[1] == covND[2]); // symmetric
+    assert(fabs(covND[1]) > EXTRA_TINY); // the two particles of the test walk move together
+
+    // merging two halves yields the same moments
+    covAccu.allocate(Nmc/2);
+    accumulateData(covAccu, Nmc/2, nd, xND, accepted, nchanged, changedIdx);
+    covAccu2.allocate(Nmc/2);
+    accumulateData(covAccu2, Nmc/2, nd, xND + ndata/2, accepted + Nmc/2, nchanged + Nmc/2, changedIdx + ndata/2);
+    covAccu.merge(covAccu2);
+    CovarianceAccumulator::covariance(covAccu.getNStore(), nd, covAccu.getData(), covND);
+    assertArraysEqual(nd*nd, covND, refCov, EXTRA_TINY);
+
+    // a partial last block is dropped
+    covAccu.allocate(Nmc - 100);
+    accumulateData(covAccu, Nmc - 100, nd, xND, accepted, nchanged, changedIdx);
+    assert(covAccu.getData()[CovarianceAccumulator::COUNT*nd] == (Nmc - 100)/16);
+
+    // check that the compressed full accumulator stores the same samples as the full one (bitwise), in less memory
+    if (verbose) { cout << endl << "Checking compressed full accumulator ..." << endl; }
+    CompressedFullAccumulator compAccu(obsfun, 1), compAccu2(obsfun, 1);
+    vector<double> decoded(ndata);
+    fullAccu.allocate(Nmc);
+    accumulateData(fullAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    compAccu.allocate(Nmc);
+    assertAccuResetted(compAccu);
+    accumulateData(compAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    assertAccuFinalized(compAccu, Nmc);
+    assert(compAccu.getNSamples() == Nmc);
+    assert(compAccu.getNData() < fullAccu.getNData()); // the rejected steps are run-length encoded
+    if (verbose) { cout << "compression ratio " << fullAccu.getNData()/static_cast<double>(compAccu.getNData()) << endl; }
+    CompressedSampleReader reader(compAccu.getNStore(), nd, compAccu.getData());
+    assert(reader.getNSamples() == Nmc);
+    assert(reader.read(100, decoded.data()) == 100); // read in two chunks
+    assert(reader.read(Nmc, decoded.data() + 100*nd) == Nmc - 100);
+    assert(reader.done() && reader.read(1, decoded.data()) == 0);
+    assertArraysEqual(ndata, decoded.data(), fullAccu.getData());
+
+    // the same after reset
+    compAccu.reset();
+    assertAccuResetted(compAccu);
+    accumulateData(compAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    CompressedSampleReader reader2(compAccu.getNStore(), nd, compAccu.getData());
+    reader2.read(Nmc, decoded.data());
+    assertArraysEqual(ndata, decoded.data(), fullAccu.getData());
+
+    // merging two halves yields the same samples
+    compAccu.allocate(Nmc/2);
+    accumulateData(compAccu, Nmc/2, nd, xND, accepted, nchanged, changedIdx);
+    compAccu2.allocate(Nmc/2);
+    accumulateData(compAccu2, Nmc/2, nd, xND + ndata/2, accepted + Nmc/2, nchanged + Nmc/2, changedIdx + ndata/2);
+    compAccu.merge(compAccu2);
+    assertAccuFinalized(compAccu, Nmc);
+    CompressedSampleReader reader3(compAccu.getNStore(), nd, compAccu.getData());
+    assert(reader3.getNSamples() == Nmc);
+    reader3.read(Nmc, decoded.data());
+    assertArraysEqual(ndata, decoded.data(), fullAccu.getData());
+
+    // the estimators decode the samples in several chunks and reproduce the ones on the full data
+    assert(Nmc*nd > 2*CompressedSampleReader::CHUNK_SIZE);
+    mci::MJBlockerEstimator(Nmc, nd, fullAccu.getData(), avgND, errND);
+    mci::CompressedMJBlockerEstimator(compAccu.getNStore(), nd, compAccu.getData(), streamAvg, streamErr);
+    assertArraysEqual(nd, streamAvg, avgND, EXTRA_TINY);
+    assertArraysEqual(nd, streamErr, errND, EXTRA_TINY);
+    mci::UncorrelatedEstimator(Nmc, nd, fullAccu.getData(), avgND, errND);
+    mci::CompressedUncorrelatedEstimator(compAccu.getNStore(), nd, compAccu.getData(), streamAvg, streamErr);
+    assertArraysEqual(nd, streamAvg, avgND, EXTRA_TINY);
+    assertArraysEqual(nd, streamErr, errND, EXTRA_TINY);
+    compAccu.deallocate();
+    compAccu2.deallocate();
+    assertAccuDeallocated(compAccu);
+
+    // worst case: every sample differs from the last one in the sign and lowest byte of all values, i.e. no byte compresses
+    {
+        vector<double> xWorst(ndata);
+        vector<int> nchangedAll(Nmc, nd), changedIdxAll(ndata);
+        const unique_ptr<bool[]> acceptedAll(new bool[Nmc]);
+        std::fill(acceptedAll.get(), acceptedAll.get() + Nmc, true);
+        for (int i = 0; i < Nmc; ++i) {
+            for (int j = 0; j < nd; ++j) {
+                const uint64_t bits = ((i%2 == 0) ? 0x3ff0000000000000ull : 0xbff0000000000000ull) // +-1.
+                                      | (static_cast<uint64_t>(0x0102030405) << 8) | static_cast<uint64_t>(1 + (i + j)%255);
+                std::memcpy(&xWorst[i*nd + j], &bits, sizeof(double));
+                changedIdxAll[i*nd + j] = j;
+            }
+        }
+        compAccu.allocate(Nmc);
+        accumulateData(compAccu, Nmc, nd, xWorst.data(), acceptedAll.get(), nchangedAll.data(), changedIdxAll.data());
+        assert(compAccu.getNBytes() == static_cast<int64_t>(Nmc)*(9*nd + 1)); // the bound of NOTE 2
+        assert(compAccu.getNData() <= CompressedFullAccumulator::HEADER_SIZE + (compAccu.getNBytes() + 7)/8 + nd - 1);
+        CompressedSampleReader readerWorst(compAccu.getNStore(), nd, compAccu.getData());
+        readerWorst.read(Nmc, decoded.data());
+        assertArraysEqual(ndata, decoded.data(), xWorst.data());
+        compAccu.deallocate();
+    }
+
+    // check that the memory-mapped accumulator stores the same samples as the full one and keeps them in the file
+    if (verbose) { cout << endl << "Checking memory-mapped full accumulator ..." << endl; }
+    const string mapfile = "ut1_samples.bin";
+    {
+        MappedFullAccumulator mapAccu(obsfun, 1, mapfile), mapAccu2(obsfun, 1, mapfile + ".tmp", false /*keep*/);
+        mapAccu.allocate(Nmc);
+        accumulateData(mapAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+        assertAccuFinalized(mapAccu, Nmc);
+        assert(mapAccu.getNStore() == Nmc);
+        assertArraysEqual(ndata, mapAccu.getData(), fullAccu.getData());
+
+        // the single-pass auto-blocking reproduces MJBlocker
+        mci::MJBlockerEstimator(Nmc, nd, mapAccu.getData(), avgND, errND);
+        mci::MJBlockerSinglePassEstimator(Nmc, nd, mapAccu.getData(), streamAvg, streamErr);
+        assertArraysEqual(nd, streamAvg, avgND, EXTRA_TINY);
+        assertArraysEqual(nd, streamErr, errND, EXTRA_TINY);
+
+        // merging two halves yields the same samples
+        mapAccu.allocate(Nmc/2);
+        accumulateData(mapAccu, Nmc/2, nd, xND, accepted, nchanged, changedIdx);
+        mapAccu2.allocate(Nmc/2);
+        accumulateData(mapAccu2, Nmc/2, nd, xND + ndata/2, accepted + Nmc/2, nchanged + Nmc/2, changedIdx + ndata/2);
+        mapAccu.merge(mapAccu2);
+        assert(mapAccu.getNStore() == Nmc);
+        assertArraysEqual(ndata, mapAccu.getData(), fullAccu.getData());
+        mapAccu2.deallocate();
+        assert(!ifstream(mapfile + ".tmp").good()); // temporary file is removed
+        mapAccu.deallocate();
+        assertAccuDeallocated(mapAccu);
+
+        // and so does merging raw data in chunks (like MPI ranks are merged into the file)
+        checkAccumulatorChunkMerge(mapAccu, mapAccu2, fullAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    }
+    // the samples survive deallocation
+    vector<double> filedata(ndata);
+    ifstream mapstream(mapfile, ios::binary);
+    assert(mapstream.read(reinterpret_cast<char *>(filedata.data()), ndata*sizeof(double)));
+    assert(mapstream.peek() == EOF);
+    mapstream.close();
+    assertArraysEqual(ndata, filedata.data(), fullAccu.getData());
+    std::remove(mapfile.c_str());
+
+    // check that the column-major accumulators store the transposed data and the column-major estimators agree
+    if (verbose) { cout << endl << "Checking column-major accumulators and estimators ..." << endl; }
+    FullAccumulator colFullAccu(obsfun, 1, true), colFullAccu1(obsfun, 1, true), colFullAccu2(obsfun, 1, true);
+    BlockAccumulator colBlockAccu(obsfun, 1, 16, true), colBlockAccu1(obsfun, 1, 16, true), colBlockAccu2(obsfun, 1, 16, true);
+    checkAccumulator(colFullAccu, Nmc, nd, xND, accepted, nchanged, changedIdx, SMALL); // averages are layout independent
+    assert(colFullAccu.isColumnMajor() && !fullAccu.isColumnMajor());
+    for (int64_t i = 0; i < Nmc; ++i) {
+        for (int j = 0; j < nd; ++j) { assert(colFullAccu.getData()[j*Nmc + i] == fullAccu.getData()[i*nd + j]); }
+    }
+    blockAccu.allocate(Nmc);
+    accumulateData(blockAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    colBlockAccu.allocate(Nmc);
+    accumulateData(colBlockAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    const int64_t nblk = blockAccu.getNStore();
+    for (int64_t i = 0; i < nblk; ++i) {
+        for (int j = 0; j < nd; ++j) { assert(fabs(colBlockAccu.getData()[j*nblk + i] - blockAccu.getData()[i*nd + j]) < EXTRA_TINY); }
+    }
+    checkAccumulatorMerge(colFullAccu1, colFullAccu2, colFullAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+    checkAccumulatorMerge(colBlockAccu1, colBlockAccu2, colBlockAccu, Nmc, nd, xND, accepted, nchanged, changedIdx);
+
+    double colAvg[nd], colErr[nd];
+    mci::UncorrelatedEstimator(Nmc, nd, xND, avgND, errND);
+    mci::ColumnMajorUncorrelatedEstimator(Nmc, nd, colFullAccu.getData(), colAvg, colErr);
+    assertArraysEqual(nd, colAvg, avgND, EXTRA_TINY);
+    assertArraysEqual(nd, colErr, errND, EXTRA_TINY);
+    mci::MJBlockerEstimator(Nmc, nd, xND, avgND, errND);
+    createColumnMajorEstimator(EstimatorType::MJBlocker)(Nmc, nd, colFullAccu.getData(), colAvg, colErr);
+    assertArraysEqual(nd, colAvg, avgND, EXTRA_TINY);
+    assertArraysEqual(nd, colErr, errND, EXTRA_TINY);
+    createColumnMajorInPlaceEstimator(EstimatorType::MJBlocker, createEstimatorWorkspace(EstimatorType::MJBlocker, nd))(Nmc, nd, colFullAccu.consumeData(), colAvg, colErr);
+    assertArraysEqual(nd, colAvg, avgND, EXTRA_TINY);
+    assertArraysEqual(nd, colErr, errND, EXTRA_TINY);
+    colFullAccu.deallocate();
+    colBlockAccu.deallocate();
 }
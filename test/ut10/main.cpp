@@ -0,0 +1,123 @@
+#include "mci/MCIntegrator.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../common/TestMCIFunctions.hpp"
+
+using namespace std;
+using namespace mci;
+
+// read the whole content of a file
+vector<char> readFile(const string &path)
+{
+    ifstream file(path, ios::binary);
+    return vector<char>(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+}
+
+// integrate with automatic warm-up and return the number of callback calls, i.e. of all MC steps (+1 per sampling run),
+// optionally with the walker position of the first call
+int64_t integrateCounted(MCI &mci, const int64_t nmc, double &average, double &error, double xfirst[] = nullptr)
+{
+    int64_t ncalls = 0;
+    mci.setCallback([&ncalls, xfirst](const MCI &m) {
+        if (ncalls++ == 0 && xfirst != nullptr) { std::copy(m.getX(), m.getX() + m.getNDim(), xfirst); }
+    });
+    mci.integrate(nmc, &average, &error);
+    mci.clearCallback();
+    return ncalls;
+}
+
+int main()
+{
+    const int64_t NMC = 2000;
+    remove("./ut10_gauss.warm");
+
+    // first run: full warm-up, afterwards the entry is stored
+    MCI mci(3);
+    mci.setSeed(1111);
+    mci.addSamplingFunction(ThreeDimGaussianPDF());
+    mci.addObservable(XSquared());
+    mci.setWarmStart(".", "ut10_gauss");
+    double avg1, err1;
+    assert(integrateCounted(mci, NMC, avg1, err1) > NMC + 1);
+    const double step = mci.getMRT2Step(0);
+    const double xlast[3] = {mci.getX(0), mci.getX(1), mci.getX(2)};
+    FILE * entry = fopen("./ut10_gauss.warm", "rb");
+    assert(entry != nullptr);
+    fclose(entry);
+
+    // a new MCI with the same tag starts right away, with the stored step size and walker position
+    {
+        MCI mci2(3);
+        mci2.setSeed(2222);
+        mci2.addSamplingFunction(ThreeDimGaussianPDF());
+        mci2.addObservable(XSquared());
+        mci2.setWarmStart(".", "ut10_gauss");
+        double avg2, err2, xfirst[3];
+        assert(integrateCounted(mci2, NMC, avg2, err2, xfirst) == NMC + 1);
+        for (int i = 0; i < 3; ++i) { assert(xfirst[i] == xlast[i]); }
+        assert(mci2.getMRT2Step(0) == step);
+        assert(fabs(avg2 - avg1) < 4.*sqrt(err1*err1 + err2*err2));
+
+        // the entry was refreshed with the new final position, which the next run uses
+        const double xlast2[3] = {mci2.getX(0), mci2.getX(1), mci2.getX(2)};
+        mci2.newRandomX();
+        assert(integrateCounted(mci2, NMC, avg2, err2, xfirst) == NMC + 1);
+        for (int i = 0; i < 3; ++i) { assert(xfirst[i] == xlast2[i]); }
+    }
+
+    // without a requested warm-up, the entry isn't used (nor overwritten by the not equilibrated state)
+    {
+        const vector<char> entryBefore = readFile("./ut10_gauss.warm");
+        MCI mci3(3);
+        mci3.addSamplingFunction(ThreeDimGaussianPDF());
+        mci3.addObservable(XSquared());
+        mci3.setWarmStart(".", "ut10_gauss");
+        mci3.setMRT2Step(0.1);
+        double avg3, err3;
+        mci3.integrate(NMC, &avg3, &err3, false, false);
+        assert(mci3.getMRT2Step(0) == 0.1);
+        assert(readFile("./ut10_gauss.warm") == entryBefore);
+    }
+
+    // an entry of a different trial move (or dimension, target acceptance rate) is a miss, which gets replaced
+    {
+        MCI mci4(3);
+        mci4.addSamplingFunction(ThreeDimGaussianPDF());
+        mci4.addObservable(XSquared());
+        mci4.setTrialMove(MoveType::Vec);
+        mci4.setWarmStart(".", "ut10_gauss");
+        double avg4, err4;
+        assert(integrateCounted(mci4, NMC, avg4, err4) > NMC + 1);
+        assert(integrateCounted(mci4, NMC, avg4, err4) == NMC + 1);
+    }
+    {
+        MCI mci5(3);
+        mci5.addSamplingFunction(ThreeDimGaussianPDF());
+        mci5.addObservable(XSquared());
+        mci5.setTrialMove(MoveType::Vec);
+        mci5.setTargetAcceptanceRate(0.3);
+        mci5.setWarmStart(".", "ut10_gauss");
+        double avg5, err5;
+        assert(integrateCounted(mci5, NMC, avg5, err5) > NMC + 1);
+    }
+
+    // invalid tags
+    for (const string tag : {"", "..", "a/b", "a b"}) {
+        bool thrown = false;
+        try { mci.setWarmStart(".", tag); }
+        catch (const invalid_argument &) { thrown = true; }
+        assert(thrown);
+    }
+
+    remove("./ut10_gauss.warm");
+    return 0;
+}
@@ -19,8 +19,11 @@ int main()
     MCI mci(3);
     mci.setSeed(5649871);
     mci.addSamplingFunction(pdf);
-    mci.addObservable(obs1d);
+    mci.addObservable(obs1d, 1, 1, true, EstimatorType::FCBlocker);
+    mci.addObservable(obs3d, 1, 1, true, EstimatorType::FCBlocker);
+    mci.addObservable(obs1d); // default (MJBlocker) estimation of the same data
     mci.addObservable(obs3d);
+    const int ndimFC = 4; // the first 4 obs dims use FCBlocker
 
     // the integral should provide 0.5 as answer!
 
@@ -29,16 +32,23 @@ int main()
     x[1] = -5.;
     x[2] = 10.;
 
-    double average[4];
-    double error[4];
+    double average[8];
+    double error[8];
 
     // this integral will give a wrong answer! This is because the starting point is very bad and initialDecorrelation is skipped (as well as the MRT2step automatic setting)
     mci.setX(x);
     mci.integrate(NMC, average, error, false, false);
-    for (int i = 0; i < mci.getNObsDim(); ++i) {
+    for (int i = 0; i < ndimFC; ++i) {
         //std::cout << "i " << i << ", average[i] " << average[i] << ", error[i] " << error[i] << ", CORRECT_RESULT" << CORRECT_RESULT << std::endl;
         assert(fabs(average[i] - CORRECT_RESULT) > 2.*error[i]);
     }
+    // MJBlocker (used by default for any NMC) picks a larger blocking level on the drifting chain, i.e. it assigns
+    // a larger error to the non-equilibrated data than FCBlocker, but the result is still clearly off
+    for (int i = ndimFC; i < mci.getNObsDim(); ++i) {
+        //std::cout << "i " << i << ", average[i] " << average[i] << ", error[i] " << error[i] << ", CORRECT_RESULT" << CORRECT_RESULT << std::endl;
+        assert(error[i] > error[i - ndimFC]);
+        assert(fabs(average[i] - CORRECT_RESULT) > error[i]);
+    }
     //std::cout << std::endl;
 
     // this integral, instead, will provide the right answer
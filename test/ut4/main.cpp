@@ -1,6 +1,9 @@
 #include "mci/MCIntegrator.hpp"
 
 #include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
 
 #include "../common/TestMCIFunctions.hpp"
 
@@ -9,7 +12,7 @@ using namespace mci;
 
 int main()
 {
-    const int NMC = 16384; // use a power of 2 this time, to let MCI use MJBlocker
+    const int NMC = 16384;
     const double CORRECT_RESULT = 0.5;
 
     ThreeDimGaussianPDF pdf;
@@ -56,7 +59,7 @@ int main()
     assert(fabs(average - CORRECT_RESULT) < 2.*error);
 
     // The previous two integrations implicitly used UncorrelatedEstimator (because blocksize>1).
-    // CorrelatedEstimator (is MJBlocker, because NMC is power of 2) should yield similar result.
+    // CorrelatedEstimator (is MJBlocker) should yield similar result.
 
     // first set it by boolean arguments
     mci.clearObservables();
@@ -72,6 +75,94 @@ int main()
     //std::cout << "average " << average << ", error " << error << ", CORRECT_RESULT" << CORRECT_RESULT << std::endl;
     assert(fabs(average - CORRECT_RESULT) < 2.*error);
 
+    // the autocorrelation estimator provides also tau_int and ESS of the accumulated samples
+    mci.clearObservables();
+    mci.addObservable(obs, 1, 1, false /*flag_equil*/, EstimatorType::Autocorrelation);
+    double tau, ess;
+    mci.getAutocorrelation(&tau, &ess);
+    assert(std::isnan(tau) && std::isnan(ess)); // not yet computed
+    mci.integrate(NMC, &average, &error, false, false);
+    mci.getAutocorrelation(&tau, &ess);
+    assert(fabs(average - CORRECT_RESULT) < 3.*error); // 3 sigma, because this is yet another check on the same chain
+    assert(tau > 1.); // Metropolis samples are correlated
+    assert(fabs(ess*tau - NMC) < 1e-6*NMC);
+
+    // derived quantities: the ratio of <x^2> and <(x^2+y^2+z^2)/3> is 1 (by symmetry)
+    XYZSquared obsxyz;
+    mci.clearObservables();
+    mci.addObservable(obs, 16);
+    mci.addObservable(obsxyz, 16);
+    mci.addDerivedQuantity([](const double avg[], double out[]) { out[0] = avg[1]/avg[0]; });
+    mci.addDerivedQuantity([](const double avg[], double out[]) { out[0] = avg[0]; }); // linear
+    assert(mci.getNDerived() == 2);
+    double avgs[4], errs[4], dval[2], derr[2], dval_boot[2], derr_boot[2];
+    mci.setResampling(ResamplingType::Jackknife, 64);
+    mci.integrate(NMC, avgs, errs, false, false);
+    mci.getDerivedResults(dval, derr);
+    assert(fabs(dval[0] - 1.) < 3.*derr[0]);
+    assert(fabs(dval[1] - avgs[0]) < 1e-12); // jackknife reproduces linear functions (1024 blocks in 64 groups)
+
+    mci.setResampling(ResamplingType::Bootstrap, 64, 2000);
+    mci.setEstimatorThreads(2);
+    mci.integrate(NMC, avgs, errs, false, false);
+    mci.getDerivedResults(dval_boot, derr_boot);
+    mci.setEstimatorThreads(1);
+    assert(fabs(dval_boot[0] - 1.) < 3.*derr_boot[0]);
+    assert(fabs(dval_boot[1] - avgs[0]) < 1e-12);
+    assert(derr_boot[0] > 0.5*derr[0] && derr_boot[0] < 2.*derr[0]); // similar errors as by jackknife (same chain length)
+
+    // the bootstrap doesn't draw from the sampling generator, i.e. the following walk is the same without derived quantities
+    double avgs_der[4], avgs_noder[4];
+    mci.setSeed(4321);
+    mci.centerX();
+    mci.integrate(NMC, avgs, errs, false, false);
+    mci.integrate(NMC, avgs_der, errs, false, false);
+    mci.clearDerivedQuantities();
+    mci.setSeed(4321);
+    mci.centerX();
+    mci.integrate(NMC, avgs, errs, false, false);
+    mci.integrate(NMC, avgs_noder, errs, false, false);
+    for (int i = 0; i < 4; ++i) { assert(avgs_der[i] == avgs_noder[i]); }
+    mci.addDerivedQuantity([](const double avg[], double out[]) { out[0] = avg[1]/avg[0]; });
+
+    // the bootstrap is independent of the number of threads
+    const int NGROUPS = 32;
+    vector<double> groups(NGROUPS*2);
+    for (int i = 0; i < NGROUPS; ++i) {
+        groups[2*i] = 1. + 0.1*sin(i);
+        groups[2*i + 1] = 2. + 0.1*cos(i);
+    }
+    const auto ratio = [](const double avg[], double out[]) { out[0] = avg[0]/avg[1]; };
+    double rval1, rerr1, rval4, rerr4;
+    resampleDerived(ResamplingType::Bootstrap, NGROUPS, 2, groups.data(), ratio, 1, &rval1, &rerr1, 500, 42, 1);
+    resampleDerived(ResamplingType::Bootstrap, NGROUPS, 2, groups.data(), ratio, 1, &rval4, &rerr4, 500, 42, 4);
+    assert(rval1 == rval4 && rerr1 == rerr4);
+
+    // derived quantities require the same block layout for all observables
+    mci.clearObservables();
+    mci.addObservable(obs, 16);
+    mci.addObservable(obsxyz, 8);
+    bool thrown = false;
+    try { mci.integrate(NMC, avgs, errs, false, false); }
+    catch (const std::invalid_argument &) { thrown = true; }
+    assert(thrown);
+    mci.clearDerivedQuantities();
+    mci.integrate(NMC, avgs, errs, false, false);
+
+    // the covariance estimator also provides the covariance matrix of the averages
+    mci.clearObservables();
+    mci.addObservable(obsxyz, 16, 1, false, EstimatorType::Covariance);
+    double cov[9];
+    mci.getCovariance(0, cov);
+    assert(std::isnan(cov[0])); // not yet computed
+    mci.integrate(NMC, avgs, errs, false, false);
+    mci.getCovariance(0, cov);
+    for (int i = 0; i < 3; ++i) {
+        assert(fabs(avgs[i] - CORRECT_RESULT) < 3.*errs[i]);
+        assert(fabs(cov[i*3 + i] - errs[i]*errs[i]) < 1e-12);
+        for (int j = 0; j < 3; ++j) { assert(cov[i*3 + j] == cov[j*3 + i]); }
+    }
+
 
     return 0;
 }
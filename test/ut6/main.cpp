@@ -0,0 +1,131 @@
+#include "mci/MCIntegrator.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "../common/TestMCIFunctions.hpp"
+
+using namespace std;
+using namespace mci;
+
+int main()
+{
+    const int NMC = 40000;
+    const int NTHREADS = 4;
+    const double CORRECT_RESULT = 0.5;
+
+    MCI mci(3);
+    mci.setSeed(5649871);
+
+    // the integral of this pdf/obs combination should provide 0.5 as answer!
+    ThreeDimGaussianPDF pdf;
+    XSquared obs;
+    mci.addSamplingFunction(pdf);
+    mci.addObservable(obs, 1, 1, true, EstimatorType::Correlated); // full accumulator
+    mci.addObservable(obs, 10, 2, false, EstimatorType::Uncorrelated); // block accumulator (NMC/NTHREADS is a multiple of 10*2)
+    mci.addObservable(obs, 0, 1, false, EstimatorType::Noop); // simple accumulator
+    mci.addObservable(obs, 1, 1, false, EstimatorType::StreamMJBlocker); // streaming blocking accumulator
+    mci.addBinnedObservable(obs, 128, 1, false, EstimatorType::FCBlocker); // binning accumulator
+    mci.addCompressedObservable(obs, 1, false, EstimatorType::Correlated); // compressed full accumulator
+    mci.addMappedObservable(obs, "ut6_samples.bin", 1, false, EstimatorType::Correlated); // memory-mapped full accumulator
+    mci.addColumnMajorObservable(obs, 10, 2, false, EstimatorType::Uncorrelated); // column-major block accumulator
+    bool thrown = false;
+    try { mci.addCompressedObservable(obs, 1, false, EstimatorType::Autocorrelation); } // needs random access to the samples
+    catch (const std::invalid_argument &) { thrown = true; }
+    assert(thrown && mci.getNObs() == 8);
+
+    // choose very bad initial position, decorrelation has to work on every walker
+    double x[3];
+    x[0] = 5.;
+    x[1] = -5.;
+    x[2] = 10.;
+    mci.setX(x);
+
+    double average[8];
+    double error[8];
+    mci.integrateParallel(NMC, NTHREADS, average, error);
+    assert(mci.getNObs() == 8); // workers don't touch our observables
+    assert(fabs(average[0] - CORRECT_RESULT) < 2.*error[0]);
+    assert(fabs(average[1] - CORRECT_RESULT) < 2.*error[1]);
+    assert(fabs(average[2] - CORRECT_RESULT) < 4.*error[0]); // no error for Noop, use the one of full accumulation
+    assert(error[2] == 0.);
+    assert(fabs(average[3] - CORRECT_RESULT) < 2.*error[3]);
+    assert(fabs(average[4] - CORRECT_RESULT) < 2.*error[4]);
+    assert(fabs(average[5] - average[0]) < 1e-12 && fabs(error[5] - error[0]) < 1e-12); // same samples, decoded into single-pass blocking
+    assert(fabs(average[6] - average[0]) < 1e-12 && fabs(error[6] - error[0]) < 1e-12); // same samples, single-pass blocking
+    assert(!std::ifstream("ut6_samples.bin.worker1").good()); // the workers' files are removed
+    assert(fabs(average[7] - average[1]) < 1e-12 && fabs(error[7] - error[1]) < 1e-12); // same blocks, other layout
+
+    // now the same, but we skip step finding and decorrelation and use the remaining threads
+    mci.integrateParallel(NMC, 0, average, error, false, false);
+    assert(fabs(average[0] - CORRECT_RESULT) < 2.*error[0]);
+
+    // a single thread is the same as calling integrate, with the same seed we get identical results
+    double average2[8];
+    double error2[8];
+    mci.setSeed(1234);
+    mci.setX(x);
+    mci.integrateParallel(NMC, 1, average, error, false, false);
+    mci.setSeed(1234);
+    mci.setX(x);
+    mci.integrate(NMC, average2, error2, false, false);
+    for (int i = 0; i < 8; ++i) {
+        assert(average[i] == average2[i]);
+        assert(error[i] == error2[i]);
+    }
+
+    std::remove("ut6_samples.bin");
+
+    // without sampling function within a finite domain
+    mci.clearSamplingFunctions();
+    mci.clearObservables();
+    mci.setIRange(-5., 5.);
+    GaussXSquared obs_nopdf; // is XSquared multiplied by Gaussian
+    mci.addObservable(obs_nopdf, 1, 1, false, false);
+    mci.integrateParallel(NMC, NTHREADS, average, error, false, false);
+    assert(fabs(average[0] - CORRECT_RESULT) < 2.*error[0]);
+
+    // parallel estimation (over observables and column tiles of large ones) gives the same results as serial estimation
+    const int NDIM = 150; // more than ObservableContainer::ESTIMATOR_TILE_WIDTH
+    MCI mci_hd(NDIM);
+    mci_hd.setIRange(-1., 1.);
+    XND obs_hd(NDIM);
+    mci_hd.addObservable(obs_hd, 1, 1, false, EstimatorType::Uncorrelated);
+    mci_hd.addObservable(obs_hd, 1, 1, false, EstimatorType::MJBlocker); // in-place estimator (estimated whole, without gather buffer)
+    mci_hd.addObservable(obs_hd, 1, 1, false, EstimatorType::Autocorrelation);
+    X2Sum obs_small(NDIM);
+    mci_hd.addObservable(obs_small, 10, 1, false, EstimatorType::Uncorrelated); // small one
+    mci_hd.addColumnMajorObservable(obs_hd, 1, 1, false, EstimatorType::MJBlocker); // column tiles without copy
+    mci_hd.addColumnMajorObservable(obs_hd, 1, 1, false, EstimatorType::Autocorrelation);
+    const int NOBSDIM = mci_hd.getNObsDim();
+    vector<double> avg_ser(NOBSDIM), err_ser(NOBSDIM), tau_ser(NOBSDIM), ess_ser(NOBSDIM);
+    vector<double> avg_par(NOBSDIM), err_par(NOBSDIM), tau_par(NOBSDIM), ess_par(NOBSDIM);
+    mci_hd.setSeed(1337);
+    mci_hd.centerX();
+    mci_hd.integrate(1000, avg_ser.data(), err_ser.data());
+    mci_hd.getAutocorrelation(tau_ser.data(), ess_ser.data());
+    mci_hd.setEstimatorThreads(NTHREADS);
+    assert(mci_hd.getEstimatorThreads() == NTHREADS);
+    mci_hd.setSeed(1337);
+    mci_hd.centerX();
+    mci_hd.integrate(1000, avg_par.data(), err_par.data());
+    mci_hd.getAutocorrelation(tau_par.data(), ess_par.data());
+    for (int i = 0; i < NOBSDIM; ++i) {
+        assert(avg_par[i] == avg_ser[i]);
+        assert(err_par[i] == err_ser[i]);
+        if (i >= 2*NDIM && i < 3*NDIM) { assert(tau_par[i] == tau_ser[i] && ess_par[i] == ess_ser[i]); }
+    }
+    const auto relEqual = [](const double a, const double b) { return fabs(a - b) <= 1e-12*fabs(b); }; // the values scale with the volume 2^NDIM
+    for (int j = 0; j < NDIM; ++j) { // the column-major observables agree with the row-major ones
+        const int imj = 3*NDIM + 1 + j, iac = 4*NDIM + 1 + j;
+        assert(relEqual(avg_par[imj], avg_par[NDIM + j]) && relEqual(err_par[imj], err_par[NDIM + j]));
+        assert(relEqual(avg_par[iac], avg_par[2*NDIM + j]) && relEqual(err_par[iac], err_par[2*NDIM + j]));
+        assert(tau_par[iac] == tau_ser[iac] && relEqual(tau_par[iac], tau_par[2*NDIM + j]));
+    }
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include "mci/Factories.hpp"
+#include "mci/MCIntegrator.hpp"
+#include "mci/RandomGenerator.hpp"
+#include "mci/XoshiroEngine.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "../common/TestMCIFunctions.hpp"
+
+using namespace std;
+using namespace mci;
+
+void checkEngine(const RNGType rngtype)
+{
+    const int N = 1000;
+    auto engine = createRandomEngine(rngtype, 1337);
+
+    // cloned engines continue identically
+    vector<uint64_t> data1(N), data2(N);
+    engine->generate(data1.data(), 3); // advance a bit
+    auto clone = engine->clone();
+    engine->generate(data1.data(), N);
+    clone->generate(data2.data(), N);
+    assert(data1 == data2);
+
+    // seeding resets the engine
+    engine->seed(1337);
+    clone->seed(1337);
+    engine->generate(data1.data(), N);
+    clone->generate(data2.data(), N);
+    assert(data1 == data2);
+
+    // discard skips exactly n numbers
+    engine->seed(42);
+    engine->generate(data1.data(), N);
+    for (const int n : {1, 3, 4, 5, 333}) {
+        engine->seed(42);
+        engine->discard(n);
+        engine->generate(data2.data(), N - n);
+        for (int i = 0; i < N - n; ++i) { assert(data2[i] == data1[n + i]); }
+    }
+
+    // the generator facade returns the engine's sequence, despite buffering
+    RandomGenerator rgen(createRandomEngine(rngtype, 42));
+    for (int i = 0; i < N; ++i) { assert(rgen() == data1[i]); }
+    rgen.seed(42);
+    rgen.discard(7);
+    assert(rgen() == data1[7]);
+    rgen.discard(RandomGenerator::BUFFER_SIZE + 11); // beyond the buffer
+    assert(rgen() == data1[RandomGenerator::BUFFER_SIZE + 19]);
+
+    // large discards (skip-ahead for xoshiro) match the same number of calls
+    const uint64_t NLARGE = 3*XoshiroEngine::DISCARD_LOOP_MAX + 12345;
+    rgen.seed(42);
+    for (uint64_t i = 0; i < NLARGE; ++i) { rgen(); }
+    const uint64_t next = rgen();
+    rgen.seed(42);
+    rgen.discard(NLARGE);
+    assert(rgen() == next);
+
+    // discard drops buffered doubles, i.e. they are drawn from the engine output after the skipped numbers
+    rgen.seed(42);
+    assert(rgen() == data1[0]); // integer buffer from the first block
+    rgen.uniform(); // uniform buffer from the second block
+    rgen.discard(3); // within the integer buffer
+    assert(rgen() == data1[4]);
+    assert(rgen.uniform() == static_cast<double>(data1[2*RandomGenerator::BUFFER_SIZE] >> 11)*(1./9007199254740992.));
+
+    // buffered uniform and normal doubles have the right moments
+    const int NSTAT = 100000;
+    double umean = 0., nmean = 0., nvar = 0.;
+    for (int i = 0; i < NSTAT; ++i) {
+        const double u = rgen.uniform();
+        assert(u >= 0. && u < 1.);
+        umean += u;
+        const double n = rgen.normal();
+        nmean += n;
+        nvar += n*n;
+    }
+    assert(fabs(umean/NSTAT - 0.5) < 0.005);
+    assert(fabs(nmean/NSTAT) < 0.02);
+    assert(fabs(nvar/NSTAT - 1.) < 0.02);
+
+    // streams
+    if (engine->hasIndependentStreams()) {
+        engine->seed(42);
+        engine->jump(1);
+        engine->generate(data2.data(), N);
+        assert(data1 != data2); // jumped stream is a different one
+
+        clone->seed(42);
+        clone->jump(1);
+        clone->jump(1);
+        engine->jump(1);
+        clone->generate(data1.data(), N);
+        engine->generate(data2.data(), N);
+        assert(data1 != data2); // jump from different positions (not a stream start)
+        engine->seed(42);
+        engine->jump(2);
+        engine->generate(data2.data(), N);
+        assert(data1 == data2); // jump(2) == jump(1) twice
+
+        // also for larger n (which some engines compose by repeated squaring)
+        for (const bool flag_long : {false, true}) {
+            clone->seed(42);
+            engine->seed(42);
+            for (int i = 0; i < 13; ++i) { flag_long ? clone->longJump(1) : clone->jump(1); }
+            flag_long ? engine->longJump(13) : engine->jump(13);
+            clone->generate(data1.data(), N);
+            engine->generate(data2.data(), N);
+            assert(data1 == data2);
+        }
+
+        engine->seed(42);
+        engine->longJump(1);
+        engine->generate(data2.data(), N);
+        assert(data1 != data2);
+    }
+    else {
+        bool thrown = false;
+        try { engine->jump(1); }
+        catch (const std::runtime_error &) { thrown = true; }
+        assert(thrown);
+    }
+}
+
+int main()
+{
+    // known-answer test from Random123 (counter 0, key 0)
+    PhiloxEngine philox(0);
+    uint64_t kat[4];
+    philox.generate(kat, 4);
+    assert(kat[0] == 0x16554d9eca36314cULL);
+    assert(kat[1] == 0xdb20fe9d672d0fdcULL);
+    assert(kat[2] == 0xd7e772cee186176bULL);
+    assert(kat[3] == 0x7e68b68aec7ba23bULL);
+
+    // default MCI engine is the standard Mersenne Twister
+    MT19937Engine mt;
+    std::mt19937_64 stdmt;
+    uint64_t val;
+    for (int i = 0; i < 100; ++i) {
+        mt.generate(&val, 1);
+        assert(val == stdmt());
+    }
+
+    for (const auto rngtype : list_all_RNGType) {
+        checkEngine(rngtype);
+    }
+
+    // integrate with all engines (serial and parallel, i.e. with streams)
+    const int NMC = 20000;
+    const double CORRECT_RESULT = 0.5;
+    MCI mci(3);
+    ThreeDimGaussianPDF pdf;
+    XSquared obs;
+    mci.addSamplingFunction(pdf);
+    mci.addObservable(obs);
+
+    // selecting streams requires an engine which supports them
+    mci.setRandomEngine(RNGType::MT19937_64);
+    bool thrown = false;
+    try { mci.setSeed(1337, 1); }
+    catch (const std::invalid_argument &) { thrown = true; }
+    assert(thrown);
+    mci.setRandomEngine(RNGType::Philox4x64);
+    mci.setSeed(1337, 1);
+
+    double average, error;
+    for (const auto rngtype : list_all_RNGType) {
+        mci.setRandomEngine(rngtype);
+        mci.setSeed(5649871);
+        mci.integrate(NMC, &average, &error);
+        assert(fabs(average - CORRECT_RESULT) < 3.*error); // 3 sigma, because we do many checks
+        mci.integrateParallel(NMC, 2, &average, &error);
+        assert(fabs(average - CORRECT_RESULT) < 3.*error);
+    }
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include "mci/MCIntegrator.hpp"
+#include "mci/TraceFile.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "../common/TestMCIFunctions.hpp"
+
+using namespace std;
+using namespace mci;
+
+int main()
+{
+    const int NMC = 10000;
+    const int FREQ = 10;
+    const double TINY = 1e-12;
+
+    MCI mci(3);
+    ThreeDimGaussianPDF pdf;
+    XSquared obs;
+    mci.addSamplingFunction(pdf);
+    mci.addObservable(obs);
+
+    // full traces of walker positions and observables
+    mci.storeWalkerPositionsOnFile("ut8_walker.bin", 1, TraceFormat::Binary);
+    mci.storeObservablesOnFile("ut8_obs.bin", FREQ, TraceFormat::Binary);
+    mci.setSeed(1234);
+    mci.centerX();
+    double average, error;
+    mci.integrate(NMC, &average, &error, false, false);
+
+    TraceReader wlkReader("ut8_walker.bin");
+    assert(wlkReader.getKind() == TraceKind::Walker);
+    assert(wlkReader.getNDim() == 3 && wlkReader.getNValues() == 3);
+    assert(wlkReader.getFreq() == 1 && !wlkReader.isBlockAverage());
+    assert(wlkReader.getNRecords() == NMC);
+    vector<int64_t> steps(NMC);
+    vector<double> walker(3*NMC);
+    assert(wlkReader.read(100, steps.data(), walker.data()) == 100); // read in two chunks
+    assert(wlkReader.read(NMC, steps.data() + 100, walker.data() + 300) == NMC - 100);
+    assert(wlkReader.done() && wlkReader.read(1, steps.data(), walker.data()) == 0);
+    for (int i = 0; i < NMC; ++i) { assert(steps[i] == i); }
+    for (int i = 0; i < 3; ++i) { assert(walker[3*(NMC - 1) + i] == mci.getX(i)); } // last position
+
+    // every FREQ-th observable value, computed from the positions
+    TraceReader obsReader("ut8_obs.bin");
+    assert(obsReader.getKind() == TraceKind::Observables);
+    assert(obsReader.getNValues() == 1 && obsReader.getFreq() == FREQ);
+    assert(obsReader.getNRecords() == NMC/FREQ);
+    vector<int64_t> obsSteps(NMC/FREQ);
+    vector<double> obsValues(NMC/FREQ);
+    obsReader.read(NMC, obsSteps.data(), obsValues.data());
+    double obsAvg = 0.;
+    for (int i = 0; i < NMC/FREQ; ++i) {
+        assert(obsSteps[i] == i*FREQ);
+        double ref;
+        obs.observableFunction(walker.data() + 3*i*FREQ, &ref);
+        assert(obsValues[i] == ref);
+        obsAvg += obsValues[i];
+    }
+    obsAvg /= NMC/FREQ;
+    assert(fabs(obsAvg - average) < 10*error); // a subset of the samples
+
+    // replaying the walker trace reproduces the integration and evaluates new observables
+    const double refAverage = average, refError = error;
+    {
+        MCI mci_replay(3);
+        mci_replay.addSamplingFunction(pdf);
+        mci_replay.addObservable(obs);
+        mci_replay.addObservable(UpdateableXND(3), 1, 1, false, EstimatorType::Uncorrelated); // uses the changed indices
+        double avgReplay[4], errReplay[4];
+        mci_replay.replay("ut8_walker.bin", avgReplay, errReplay);
+        assert(avgReplay[0] == refAverage && errReplay[0] == refError);
+        for (int j = 0; j < 3; ++j) {
+            double ref = 0.;
+            for (int i = 0; i < NMC; ++i) { ref += walker[3*i + j]; }
+            assert(fabs(avgReplay[1 + j] - ref/NMC) < TINY);
+            assert(mci_replay.getX(j) == walker[3*(NMC - 1) + j]); // at the last position
+        }
+
+        // the same, streamed through a named pipe by another "process"
+        assert(mkfifo("ut8_fifo", 0600) == 0);
+        std::thread producer([] {
+            ifstream in("ut8_walker.bin", ios::binary);
+            ofstream out("ut8_fifo", ios::binary);
+            out << in.rdbuf();
+        });
+        double avgStream[4], errStream[4];
+        mci_replay.replay("ut8_fifo", avgStream, errStream, NMC);
+        producer.join();
+        std::remove("ut8_fifo");
+        for (int j = 0; j < 4; ++j) { assert(avgStream[j] == avgReplay[j] && errStream[j] == errReplay[j]); }
+
+        // only the first steps, but not more than available
+        mci_replay.replay("ut8_walker.bin", avgStream, errStream, NMC/2);
+        assert(avgStream[0] != avgReplay[0]);
+        bool thrown = false;
+        try { mci_replay.replay("ut8_walker.bin", avgStream, errStream, NMC + 1); }
+        catch (const invalid_argument &) { thrown = true; }
+        assert(thrown);
+
+        MCI mci_wrongdim(2);
+        thrown = false;
+        try { mci_wrongdim.replay("ut8_walker.bin", avgStream, errStream); }
+        catch (const invalid_argument &) { thrown = true; }
+        assert(thrown);
+    }
+
+    // the same run with block averages of the observable
+    mci.storeObservablesOnFile("ut8_obs.bin", FREQ, TraceFormat::BinaryBlockAverage);
+    mci.setSeed(1234);
+    mci.centerX(); // same start as above
+    mci.integrate(NMC, &average, &error, false, false);
+    TraceReader avgReader("ut8_obs.bin");
+    assert(avgReader.isBlockAverage() && avgReader.getNRecords() == NMC/FREQ);
+    avgReader.read(NMC, obsSteps.data(), obsValues.data());
+    obsAvg = 0.;
+    for (int i = 0; i < NMC/FREQ; ++i) {
+        assert(obsSteps[i] == i*FREQ); // first step of the block
+        double ref = 0., val;
+        for (int j = 0; j < FREQ; ++j) {
+            obs.observableFunction(walker.data() + 3*(i*FREQ + j), &val);
+            ref += val;
+        }
+        assert(fabs(obsValues[i] - ref/FREQ) < TINY);
+        obsAvg += obsValues[i];
+    }
+    assert(fabs(obsAvg/(NMC/FREQ) - average) < TINY); // all samples
+
+    // a trace with a truncated last record (e.g. from an aborted run) is still readable
+    {
+        ifstream in("ut8_walker.bin", ios::binary);
+        vector<char> bytes((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        ofstream out("ut8_walker.bin", ios::binary | ios::trunc);
+        out.write(bytes.data(), static_cast<streamsize>(bytes.size() - 5));
+    }
+    TraceReader truncReader("ut8_walker.bin");
+    assert(truncReader.getNRecords() == NMC - 1);
+
+    // the text format is still available
+    mci.storeWalkerPositionsOnFile("ut8_walker.txt", 100);
+    mci.clearObservableFile();
+    mci.integrate(NMC, &average, &error, false, false);
+    ifstream txt("ut8_walker.txt");
+    int64_t nlines = 0;
+    for (string line; getline(txt, line);) { ++nlines; }
+    assert(nlines == NMC/100);
+    bool thrown = false;
+    try { TraceReader badReader("ut8_walker.txt"); }
+    catch (const invalid_argument &) { thrown = true; }
+    assert(thrown);
+
+    std::remove("ut8_walker.bin");
+    std::remove("ut8_obs.bin");
+    std::remove("ut8_walker.txt");
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include "mci/MCIntegrator.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+
+#include "../common/TestMCIFunctions.hpp"
+
+using namespace std;
+using namespace mci;
+
+const int NOBSDIM = 15;
+const int64_t NMC = 8192;
+const int64_t FREQ = 1000;
+const uint64_t SEED = 5678;
+
+// the interrupted and the resuming MCI need the same setup
+void setupMCI(MCI &mci, const RNGType rng, const function<void(MCI &)> &setMove, const bool flag_allObs = true)
+{
+    mci.setRandomEngine(rng);
+    setMove(mci);
+    mci.addSamplingFunction(ThreeDimGaussianPDF());
+    mci.addObservable(XSquared(), 1, 1, false, EstimatorType::Correlated); // every accumulator type
+    mci.addObservable(UpdateableXND(3), 8, 2, false, EstimatorType::Uncorrelated);
+    mci.addObservable(XSquared(), 0, 1);
+    mci.addBinnedObservable(XSquared(), 16);
+    mci.addCompressedObservable(XSquared());
+    mci.addColumnMajorObservable(XND(3), 4);
+    mci.addObservable(XSquared(), 1, 1, false, EstimatorType::StreamMJBlocker);
+    mci.addObservable(XND(3), 4, 1, false, EstimatorType::Covariance);
+    if (flag_allObs) { mci.addMappedObservable(XSquared(), "ut9_mapped.bin"); }
+}
+
+void setupMCI(MCI &mci, const RNGType rng, const MoveType move, const bool flag_allObs = true)
+{
+    setupMCI(mci, rng, [move](MCI &m) { m.setTrialMove(move); }, flag_allObs);
+}
+
+// integrate, but throw after nsteps MC steps (i.e. like a killed run, which leaves its last checkpoint)
+void integrateInterrupted(MCI &mci, const int64_t nmc, const int64_t nsteps)
+{
+    int64_t ncalls = 0;
+    mci.setCallback([&ncalls, nsteps](const MCI &) { if (ncalls++ == nsteps) { throw runtime_error("interrupted"); }});
+    double average[NOBSDIM], error[NOBSDIM];
+    bool interrupted = false;
+    try { mci.integrate(nmc, average, error, false, false); }
+    catch (const runtime_error &) { interrupted = true; }
+    assert(interrupted);
+    mci.clearCallback();
+}
+
+// check that checkpointed and (repeatedly) resumed runs yield the reference result, bit by bit
+void checkResume(const RNGType rng, const function<void(MCI &)> &setMove)
+{
+    // reference run without checkpoints
+    double refAvg[NOBSDIM], refErr[NOBSDIM];
+    {
+        MCI mci(3);
+        setupMCI(mci, rng, setMove);
+        mci.setSeed(SEED);
+        mci.integrate(NMC, refAvg, refErr, false, false);
+    }
+
+    // writing checkpoints doesn't change the run
+    double average[NOBSDIM], error[NOBSDIM];
+    {
+        MCI mci(3);
+        setupMCI(mci, rng, setMove);
+        mci.setSeed(SEED);
+        mci.setCheckpoint("ut9.chk", FREQ);
+        mci.integrate(NMC, average, error, false, false);
+        for (int i = 0; i < NOBSDIM; ++i) { assert(average[i] == refAvg[i] && error[i] == refErr[i]); }
+    }
+
+    // interrupted run, resumed from step 3000 (with the next interruption at 6000) and again from step 6000
+    {
+        MCI mci(3);
+        setupMCI(mci, rng, setMove);
+        mci.setSeed(SEED);
+        mci.setCheckpoint("ut9.chk", FREQ);
+        integrateInterrupted(mci, NMC, 3500);
+    }
+    {
+        MCI mci(3);
+        setupMCI(mci, rng, setMove);
+        mci.setSeed(SEED + 1); // the random state is taken from the checkpoint
+        mci.setMRT2Step(0.123); // as are the step sizes
+        mci.setCheckpoint("ut9.chk", FREQ);
+        int64_t ncalls = 0;
+        mci.setCallback([&ncalls](const MCI &) { if (++ncalls == 3000) { throw runtime_error("interrupted"); }});
+        bool interrupted = false;
+        try { mci.resume("ut9.chk", average, error); }
+        catch (const runtime_error &) { interrupted = true; }
+        assert(interrupted);
+    }
+    {
+        MCI mci(3);
+        setupMCI(mci, rng, setMove);
+        mci.resume("ut9.chk", average, error);
+        for (int i = 0; i < NOBSDIM; ++i) { assert(average[i] == refAvg[i] && error[i] == refErr[i]); }
+        assert(mci.getAcceptanceRate() > 0.);
+    }
+}
+
+int main()
+{
+    for (const auto rng : list_all_RNGType) {
+        for (const auto move : list_all_MoveType) {
+            checkResume(rng, [move](MCI &mci) { mci.setTrialMove(move); });
+        }
+    }
+
+    // SRRD moves with distributions that cache values between draws (e.g. Student-t) resume exactly as well
+    for (const auto srrd : list_all_SRRDType) {
+        checkResume(RNGType::MT19937_64, [srrd](MCI &mci) { mci.setTrialMove(srrd); });
+        checkResume(RNGType::MT19937_64, [srrd](MCI &mci) { mci.setTrialMove(srrd, 1); });
+    }
+
+    // a differently configured MCI can't resume
+    {
+        MCI mci(3);
+        setupMCI(mci, RNGType::MT19937_64, MoveType::All);
+        mci.setSeed(SEED);
+        mci.setCheckpoint("ut9.chk", FREQ);
+        integrateInterrupted(mci, NMC, 1500);
+    }
+    {
+        MCI mci(3);
+        setupMCI(mci, RNGType::MT19937_64, MoveType::All, false); // one observable less
+        double average[NOBSDIM], error[NOBSDIM];
+        bool thrown = false;
+        try { mci.resume("ut9.chk", average, error); }
+        catch (const invalid_argument &) { thrown = true; }
+        assert(thrown);
+    }
+    {
+        MCI mci(3);
+        setupMCI(mci, RNGType::Philox4x64, MoveType::All); // other engine
+        double average[NOBSDIM], error[NOBSDIM];
+        bool thrown = false;
+        try { mci.resume("ut9.chk", average, error); }
+        catch (const invalid_argument &) { thrown = true; }
+        assert(thrown);
+    }
+
+    // the checkpoint doesn't hold the samples of the mapped observable, so resume requires its file
+    remove("ut9_mapped.bin");
+    {
+        MCI mci(3);
+        setupMCI(mci, RNGType::MT19937_64, MoveType::All);
+        double average[NOBSDIM], error[NOBSDIM];
+        bool thrown = false;
+        try { mci.resume("ut9.chk", average, error); }
+        catch (const runtime_error &) { thrown = true; }
+        assert(thrown);
+    }
+
+    remove("ut9.chk");
+    remove("ut9_mapped.bin");
+    return 0;
+}